@@ -0,0 +1,183 @@
+"""
+Decoder for the binary trace dumps written by jpy's event tracing, see `jpy.diag.tracing`,
+`jpy.diag.trace_dump()` and `org.jpy.PyLib.Diag.dumpTrace()`. The module can also be used as tool.
+For usage, type:
+
+    python jpytrace.py --help
+
+For example, to print all events of a dump and to convert it into a Chrome trace-event JSON file,
+which can be opened in Perfetto (https://ui.perfetto.dev) or chrome://tracing:
+
+    python jpytrace.py jpy-trace.bin --chrome jpy-trace.json
+
+The function `read_trace()` may also be directly used from your Python code.
+"""
+
+import sys
+import json
+import struct
+import argparse
+import collections
+
+__author__ = "Norman Fomferra (Brockmann Consult GmbH) and contributors"
+__copyright__ = "Copyright 2015-2018 Brockmann Consult GmbH and contributors"
+__license__ = "Apache 2.0"
+
+# Make sure the following constants are same as the JPy_TRACE_* constants in jpy_trace.h
+EVENT_JAVA_CALL = 1
+EVENT_JAVA_NEW = 2
+EVENT_OVERLOAD_RESOLUTION = 3
+EVENT_PYTHON_CALL = 4
+EVENT_JAVA_EXCEPTION = 5
+EVENT_PYTHON_EXCEPTION = 6
+EVENT_TYPE_RESOLUTION = 7
+
+EVENT_NAMES = {
+    EVENT_JAVA_CALL: 'java_call',
+    EVENT_JAVA_NEW: 'java_new',
+    EVENT_OVERLOAD_RESOLUTION: 'overload_resolution',
+    EVENT_PYTHON_CALL: 'python_call',
+    EVENT_JAVA_EXCEPTION: 'java_exception',
+    EVENT_PYTHON_EXCEPTION: 'python_exception',
+    EVENT_TYPE_RESOLUTION: 'type_resolution',
+}
+
+_MAGIC = b'JPYTRACE'
+_VERSION = 1
+_BYTE_ORDER_MARK = 0x01020304
+_TAG_END = 0
+_TAG_SYMBOL = 1
+_TAG_THREAD = 2
+
+TraceEvent = collections.namedtuple('TraceEvent',
+                                    ['thread_id', 'timestamp', 'duration', 'subject', 'event_id', 'arg_count'])
+TraceEvent.__doc__ = """A single trace event. Times are given in nanoseconds, subject is an address
+that can be resolved using the symbols returned by read_trace()."""
+
+Trace = collections.namedtuple('Trace', ['symbols', 'events'])
+Trace.__doc__ = """The contents of a trace dump: a dictionary mapping subject addresses to names and
+a list of TraceEvent sorted by timestamp."""
+
+
+def read_trace(path):
+    """
+    Reads a binary trace dump.
+
+    :param path: the dump file path
+    :return: a Trace
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:8] != _MAGIC:
+        raise ValueError('%s: not a jpy trace dump' % path)
+
+    byte_order = None
+    for prefix in ('<', '>'):
+        version, bom, event_size, _ = struct.unpack_from(prefix + 'IIII', data, 8)
+        if bom == _BYTE_ORDER_MARK:
+            byte_order = prefix
+            break
+    if byte_order is None:
+        raise ValueError('%s: unknown byte order' % path)
+    if version != _VERSION:
+        raise ValueError('%s: unsupported trace dump version %d' % (path, version))
+
+    event_format = byte_order + 'qqQii'
+    if struct.calcsize(event_format) != event_size:
+        raise ValueError('%s: unexpected event size %d' % (path, event_size))
+
+    symbols = {}
+    events = []
+    offset = 24
+    while offset < len(data):
+        tag, = struct.unpack_from(byte_order + 'I', data, offset)
+        offset += 4
+        if tag == _TAG_END:
+            break
+        elif tag == _TAG_SYMBOL:
+            address, length = struct.unpack_from(byte_order + 'QI', data, offset)
+            offset += 12
+            symbols[address] = data[offset:offset + length].decode('utf-8', 'replace')
+            offset += length
+        elif tag == _TAG_THREAD:
+            thread_id, count = struct.unpack_from(byte_order + 'qq', data, offset)
+            offset += 16
+            for i in range(count):
+                event = struct.unpack_from(event_format, data, offset)
+                offset += event_size
+                events.append(TraceEvent(thread_id, *event))
+        else:
+            raise ValueError('%s: invalid tag %d at offset %d' % (path, tag, offset - 4))
+
+    events.sort(key=lambda e: e.timestamp)
+    return Trace(symbols, events)
+
+
+def get_subject_name(trace, event):
+    """
+    :return: the name of the event's subject, or its hexadecimal address if it is unknown
+    """
+    if event.subject == 0:
+        return ''
+    return trace.symbols.get(event.subject, '0x%x' % event.subject)
+
+
+def to_chrome_trace(trace):
+    """
+    Converts a trace into the Chrome trace-event format.
+
+    :param trace: a Trace as returned by read_trace()
+    :return: a dictionary that can be serialized using json.dump()
+    """
+    t0 = trace.events[0].timestamp if trace.events else 0
+    trace_events = []
+    for event in trace.events:
+        category = EVENT_NAMES.get(event.event_id, str(event.event_id))
+        name = get_subject_name(trace, event) or category
+        item = dict(name=name,
+                    cat=category,
+                    ts=(event.timestamp - t0) / 1000.0,
+                    pid=1,
+                    tid=event.thread_id,
+                    args=dict(arg_count=event.arg_count))
+        if event.duration > 0:
+            item['ph'] = 'X'
+            item['dur'] = event.duration / 1000.0
+        else:
+            item['ph'] = 'i'
+            item['s'] = 't'
+        trace_events.append(item)
+    return dict(traceEvents=trace_events, displayTimeUnit='ns')
+
+
+def _main():
+    parser = argparse.ArgumentParser(description='Decodes binary jpy trace dumps.')
+    parser.add_argument('dump_file', help='trace dump file written by jpy.diag.trace_dump() or PyLib.Diag.dumpTrace()')
+    parser.add_argument('--chrome', metavar='JSON_FILE',
+                        help='also write the events as Chrome trace-event JSON, e.g. for viewing them in Perfetto')
+    parser.add_argument('--quiet', action='store_true', help='do not print the events')
+    args = parser.parse_args()
+
+    trace = read_trace(args.dump_file)
+
+    if not args.quiet:
+        t0 = trace.events[0].timestamp if trace.events else 0
+        for event in trace.events:
+            print('%14.3f us  thread %-4d %-20s %12.3f us  argc=%-3d %s' % (
+                (event.timestamp - t0) / 1000.0,
+                event.thread_id,
+                EVENT_NAMES.get(event.event_id, str(event.event_id)),
+                event.duration / 1000.0,
+                event.arg_count,
+                get_subject_name(trace, event)))
+
+    if args.chrome:
+        with open(args.chrome, 'w') as f:
+            json.dump(to_chrome_trace(trace), f)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(_main())
@@ -46,8 +46,11 @@ src_test_py_dir = os.path.join(base_dir, 'src', 'test', 'python')
 sources = [
     os.path.join(src_main_c_dir, 'jpy_module.c'),
     os.path.join(src_main_c_dir, 'jpy_diag.c'),
+    os.path.join(src_main_c_dir, 'jpy_prof.c'),
+    os.path.join(src_main_c_dir, 'jpy_trace.c'),
     os.path.join(src_main_c_dir, 'jpy_verboseexcept.c'),
     os.path.join(src_main_c_dir, 'jpy_conv.c'),
+    os.path.join(src_main_c_dir, 'jpy_columns.c'),
     os.path.join(src_main_c_dir, 'jpy_compat.c'),
     os.path.join(src_main_c_dir, 'jpy_jtype.c'),
     os.path.join(src_main_c_dir, 'jpy_jarray.c'),
@@ -60,7 +63,10 @@ sources = [
 headers = [
     os.path.join(src_main_c_dir, 'jpy_module.h'),
     os.path.join(src_main_c_dir, 'jpy_diag.h'),
+    os.path.join(src_main_c_dir, 'jpy_prof.h'),
+    os.path.join(src_main_c_dir, 'jpy_trace.h'),
     os.path.join(src_main_c_dir, 'jpy_conv.h'),
+    os.path.join(src_main_c_dir, 'jpy_columns.h'),
     os.path.join(src_main_c_dir, 'jpy_compat.h'),
     os.path.join(src_main_c_dir, 'jpy_jtype.h'),
     os.path.join(src_main_c_dir, 'jpy_jarray.h'),
@@ -76,6 +82,7 @@ python_java_rt_tests = [
     os.path.join(src_test_py_dir, 'jpy_mt_test.py'),
     os.path.join(src_test_py_dir, 'jpy_diag_test.py'),
     # os.path.join(src_test_py_dir, 'jpy_perf_test.py'),
+    # os.path.join(src_test_py_dir, 'jpy_stress_test.py'),
 ]
 
 # Python unit tests that require jpy test fixture classes to be accessible
@@ -319,7 +326,7 @@ setup(name='jpy',
       license=__license__,
       url='https://github.com/bcdev/jpy',
       download_url='https://pypi.python.org/pypi/jpy/' + __version__,
-      py_modules=['jpyutil'],
+      py_modules=['jpyutil', 'jpytrace'],
       ext_modules=[Extension('jpy',
                              sources=sources,
                              depends=headers,
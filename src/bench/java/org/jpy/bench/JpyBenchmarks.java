@@ -0,0 +1,57 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy.bench;
+
+import org.openjdk.jmh.results.format.ResultFormatType;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.options.ChainedOptionsBuilder;
+import org.openjdk.jmh.runner.options.CommandLineOptions;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+/**
+ * Runs jpy's Java to Python JMH benchmarks. Usually invoked through the Maven {@code benchmarks} profile:
+ * <pre>
+ *     mvn -Pbenchmarks test-compile exec:exec -Djpy.config=build/lib.linux-x86_64-3.8/jpyconfig.properties
+ * </pre>
+ * Any JMH command-line options may be passed in the {@code jmh.args} property, e.g. {@code -Djmh.args="-f 3 PyObject"}.
+ * Unless overridden, results are written in JMH's JSON format to {@code target/jmh-result.json}, so that they
+ * can be compared across releases using {@code src/bench/python/jmh_compare.py}.
+ */
+public class JpyBenchmarks {
+
+    public static final String DEFAULT_RESULT_FILE = "target/jmh-result.json";
+
+    public static void main(String[] args) throws Exception {
+        CommandLineOptions commandLineOptions = new CommandLineOptions(args);
+        ChainedOptionsBuilder builder = new OptionsBuilder().parent(commandLineOptions);
+        if (commandLineOptions.getIncludes().isEmpty()) {
+            builder.include(JpyBenchmarks.class.getPackage().getName() + "\\..*Benchmark");
+        }
+        if (!commandLineOptions.getResultFormat().hasValue()) {
+            builder.resultFormat(ResultFormatType.JSON);
+        }
+        if (!commandLineOptions.getResult().hasValue()) {
+            builder.result(DEFAULT_RESULT_FILE);
+        }
+        // Forked benchmark JVMs must find the jpy native library as well
+        String jpyConfig = System.getProperty("jpy.config");
+        if (jpyConfig != null) {
+            builder.jvmArgsAppend("-Djpy.config=" + jpyConfig);
+        }
+        new Runner(builder.build()).run();
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy.bench;
+
+import org.jpy.PyObject;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures the overhead of calling Python functions and methods and of accessing Python attributes from Java.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class PyObjectBenchmark {
+
+    @Benchmark
+    public PyObject callNoArgs(PythonState state) {
+        return state.main.call("noop");
+    }
+
+    @Benchmark
+    public PyObject callTwoArgs(PythonState state) {
+        return state.main.call("add", 1, 2);
+    }
+
+    @Benchmark
+    public PyObject callMethod(PythonState state) {
+        return state.counter.callMethod("increment", 1);
+    }
+
+    @Benchmark
+    public PyObject getAttribute(PythonState state) {
+        return state.counter.getAttribute("value");
+    }
+
+    @Benchmark
+    public Integer getAttributeWithType(PythonState state) {
+        return state.counter.getAttribute("value", Integer.class);
+    }
+
+    @Benchmark
+    public void setAttribute(PythonState state) {
+        state.counter.setAttribute("value", 0);
+    }
+
+    @Benchmark
+    public int getIntValue(PythonState state) {
+        return state.counter.getAttribute("value").getIntValue();
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy.bench;
+
+import org.jpy.PyLib;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures calls of Python methods and module functions through Java interface proxies.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class PyProxyBenchmark {
+
+    public interface Adder {
+        int add(int a, int b);
+    }
+
+    @State(Scope.Benchmark)
+    public static class ProxyState {
+        Adder methodProxy;
+        Adder functionProxy;
+
+        @Setup
+        public void setUp(PythonState state) {
+            methodProxy = state.adder.createProxy(Adder.class);
+            functionProxy = (Adder) state.main.createProxy(PyLib.CallableKind.FUNCTION, Adder.class);
+        }
+    }
+
+    @Benchmark
+    public int methodProxy(ProxyState state) {
+        return state.methodProxy.add(1, 2);
+    }
+
+    @Benchmark
+    public int functionProxy(ProxyState state) {
+        return state.functionProxy.add(1, 2);
+    }
+}
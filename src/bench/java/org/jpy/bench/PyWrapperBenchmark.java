@@ -0,0 +1,94 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy.bench;
+
+import org.jpy.PyDictWrapper;
+import org.jpy.PyObject;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures access to Python dicts and lists through {@link PyDictWrapper} and {@code PyListWrapper},
+ * compared to converting them at once using {@link PyObject#toJava(Class)}.
+ * The Python dict and list have 1000 items each.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class PyWrapperBenchmark {
+
+    @Benchmark
+    public PyObject dictGet(PythonState state) {
+        return state.dict.asDict().get("500");
+    }
+
+    @Benchmark
+    public boolean dictContainsKey(PythonState state) {
+        return state.dict.asDict().containsKey("500");
+    }
+
+    @Benchmark
+    public PyObject dictPutObject(PythonState state) {
+        return state.dict.asDict().putObject("500", 500);
+    }
+
+    @Benchmark
+    public int dictSize(PythonState state) {
+        return state.dict.asDict().size();
+    }
+
+    @Benchmark
+    public PyObject listGet(PythonState state) {
+        return state.list.asList().get(500);
+    }
+
+    @Benchmark
+    public long listIterate(PythonState state) {
+        List<PyObject> list = state.list.asList();
+        long sum = 0;
+        for (PyObject item : list) {
+            sum += item.getIntValue();
+        }
+        return sum;
+    }
+
+    @Benchmark
+    public long listToJavaIterate(PythonState state) {
+        List<?> list = state.list.toJava(List.class);
+        long sum = 0;
+        for (Object item : list) {
+            sum += (Integer) item;
+        }
+        return sum;
+    }
+
+    @Benchmark
+    public Map<?, ?> dictToJava(PythonState state) {
+        return state.dict.toJava(Map.class);
+    }
+}
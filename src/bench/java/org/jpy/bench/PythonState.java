@@ -0,0 +1,74 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy.bench;
+
+import org.jpy.PyInputMode;
+import org.jpy.PyLib;
+import org.jpy.PyModule;
+import org.jpy.PyObject;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+
+/**
+ * Starts the Python interpreter once per benchmark fork and provides the Python objects used by the benchmarks.
+ */
+@State(Scope.Benchmark)
+public class PythonState {
+
+    static final String CODE = ""
+            + "def noop():\n"
+            + "    pass\n"
+            + "\n"
+            + "def add(a, b):\n"
+            + "    return a + b\n"
+            + "\n"
+            + "class Counter:\n"
+            + "    def __init__(self):\n"
+            + "        self.value = 0\n"
+            + "    def increment(self, n):\n"
+            + "        self.value += n\n"
+            + "        return self.value\n"
+            + "\n"
+            + "class Adder:\n"
+            + "    def add(self, a, b):\n"
+            + "        return a + b\n"
+            + "\n"
+            + "bench_counter = Counter()\n"
+            + "bench_adder = Adder()\n"
+            + "bench_dict = {str(i): i for i in range(1000)}\n"
+            + "bench_list = list(range(1000))\n";
+
+    PyModule main;
+    PyObject counter;
+    PyObject adder;
+    PyObject dict;
+    PyObject list;
+
+    @Setup
+    public void setUp() {
+        if (!PyLib.isPythonRunning()) {
+            PyLib.startPython();
+        }
+        PyObject.executeCode(CODE, PyInputMode.SCRIPT);
+        main = PyModule.getMain();
+        counter = main.getAttribute("bench_counter");
+        adder = main.getAttribute("bench_adder");
+        dict = main.getAttribute("bench_dict");
+        list = main.getAttribute("bench_list");
+    }
+}
@@ -0,0 +1,84 @@
+"""
+Compares two JMH result files in JSON format, e.g. the 'target/jmh-result.json' files written by
+jpy's Java benchmarks (see org.jpy.bench.JpyBenchmarks) for two releases:
+
+    python src/bench/python/jmh_compare.py jmh-result-0.9.json jmh-result-0.10.json
+
+For every benchmark found in both files, the scores, their errors and the relative change are printed.
+Use '--threshold PERCENT' to make the script exit with status 1 if any benchmark got slower by more than
+PERCENT, which is useful in CI. The Python benchmark results are compared using
+'python -m pyperf compare_to' instead.
+"""
+
+import sys
+import json
+import argparse
+
+
+def read_results(path):
+    """
+    Reads a JMH JSON result file.
+
+    :param path: the result file path
+    :return: a dictionary mapping benchmark names (including parameters) to (score, error, unit, mode) tuples
+    """
+    with open(path) as f:
+        items = json.load(f)
+    results = {}
+    for item in items:
+        name = item['benchmark']
+        params = item.get('params')
+        if params:
+            name += '(' + ','.join('%s=%s' % (k, params[k]) for k in sorted(params)) + ')'
+        metric = item['primaryMetric']
+        results[name] = (metric['score'], metric.get('scoreError', 0.0), metric['scoreUnit'], item['mode'])
+    return results
+
+
+def compare(old_results, new_results):
+    """
+    :return: a list of (name, old_score, new_score, unit, change) tuples, where change is the relative slowdown
+             in percent; positive values always mean "got worse", also for throughput benchmarks
+    """
+    rows = []
+    for name in sorted(set(old_results) & set(new_results)):
+        old_score, _, unit, mode = old_results[name]
+        new_score = new_results[name][0]
+        if old_score == 0:
+            change = 0.0
+        elif mode == 'thrpt':
+            change = 100.0 * (old_score - new_score) / old_score
+        else:
+            change = 100.0 * (new_score - old_score) / old_score
+        rows.append((name, old_score, new_score, unit, change))
+    return rows
+
+
+def _main():
+    parser = argparse.ArgumentParser(description='Compares two JMH JSON result files.')
+    parser.add_argument('old_file', help='the baseline results')
+    parser.add_argument('new_file', help='the results to compare with the baseline')
+    parser.add_argument('--threshold', type=float, metavar='PERCENT',
+                        help='exit with status 1 if any benchmark got slower by more than PERCENT')
+    args = parser.parse_args()
+
+    old_results = read_results(args.old_file)
+    new_results = read_results(args.new_file)
+
+    rows = compare(old_results, new_results)
+    regressions = 0
+    for name, old_score, new_score, unit, change in rows:
+        marker = ''
+        if args.threshold is not None and change > args.threshold:
+            marker = '  <-- slower'
+            regressions += 1
+        print('%-70s %14.3f %14.3f %-10s %+8.1f%%%s' % (name, old_score, new_score, unit, change, marker))
+
+    for name in sorted(set(old_results) ^ set(new_results)):
+        print('%-70s only in %s' % (name, args.old_file if name in old_results else args.new_file))
+
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(_main())
@@ -0,0 +1,241 @@
+"""
+Python -> Java microbenchmarks for jpy, based on pyperf (https://pyperf.readthedocs.io).
+
+The suite measures call overhead by arity and parameter type, overload resolution for different
+overload-set sizes, string and array conversions by size, field access, type lookup and
+buffer export. Run it from the jpy build directory (or with jpy installed), e.g.:
+
+    python src/bench/python/jpy_bench.py -o jpy-bench.json
+
+Results are written in pyperf's JSON format and can be compared across releases:
+
+    python -m pyperf compare_to jpy-bench-0.9.json jpy-bench-0.10.json --table
+
+Use '--select PREFIX' (may be repeated) to run only the benchmarks whose name starts with PREFIX,
+e.g. '--select call. --select overloads.', and '--fast' for a quick, less accurate run.
+"""
+
+import array
+import time
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+import pyperf
+import jpyutil
+
+SIZES = (10, 1000, 100000)
+
+
+def _time_calls(loops, func, *args):
+    t0 = time.perf_counter()
+    for _ in range(loops):
+        func(*args)
+    return time.perf_counter() - t0
+
+
+def _time_get_attr(loops, obj, name):
+    t0 = time.perf_counter()
+    for _ in range(loops):
+        getattr(obj, name)
+    return time.perf_counter() - t0
+
+
+def _time_set_attr(loops, obj, name, value):
+    t0 = time.perf_counter()
+    for _ in range(loops):
+        setattr(obj, name, value)
+    return time.perf_counter() - t0
+
+
+def _create_call_benchmarks(jpy):
+    String = jpy.get_type('java.lang.String')
+    System = jpy.get_type('java.lang.System')
+    Integer = jpy.get_type('java.lang.Integer')
+    Long = jpy.get_type('java.lang.Long')
+    Math = jpy.get_type('java.lang.Math')
+    Boolean = jpy.get_type('java.lang.Boolean')
+    HashMap = jpy.get_type('java.util.HashMap')
+    ArrayList = jpy.get_type('java.util.ArrayList')
+
+    s = String('Hello jpy')
+    key = Integer(42)
+    hash_map = HashMap()
+    hash_map.put(key, s)
+    array_list = ArrayList()
+
+    return [
+        # Call overhead by arity
+        ('call.arity0', _time_calls, (s.length,)),
+        ('call.arity1', _time_calls, (s.charAt, 1)),
+        ('call.arity2', _time_calls, (s.substring, 1, 3)),
+        ('call.arity4', _time_calls, (s.regionMatches, 1, 'ello', 0, 4)),
+        ('call.arity5', _time_calls, (s.regionMatches, True, 1, 'ELLO', 0, 4)),
+        ('call.static.arity0', _time_calls, (System.nanoTime,)),
+        # Call overhead by parameter and return type
+        ('call.type.int', _time_calls, (Integer.bitCount, 255)),
+        ('call.type.long', _time_calls, (Long.bitCount, 255)),
+        ('call.type.double', _time_calls, (Math.sqrt, 2.0)),
+        ('call.type.boolean', _time_calls, (Boolean.logicalXor, True, False)),
+        ('call.type.string', _time_calls, (s.concat, '!')),
+        ('call.type.object', _time_calls, (hash_map.get, key)),
+        ('call.type.void', _time_calls, (array_list.clear,)),
+    ]
+
+
+def _create_overload_benchmarks(jpy):
+    Integer = jpy.get_type('java.lang.Integer')
+    Math = jpy.get_type('java.lang.Math')
+    String = jpy.get_type('java.lang.String')
+    StringBuilder = jpy.get_type('java.lang.StringBuilder')
+
+    string_builder = StringBuilder()
+
+    def append(value):
+        string_builder.append(value)
+        if string_builder.length() > 100000:
+            string_builder.setLength(0)
+
+    return [
+        ('overloads.n1', _time_calls, (Integer.toHexString, 255)),
+        ('overloads.n4', _time_calls, (Math.abs, -5)),
+        ('overloads.n9', _time_calls, (String.valueOf, 5)),
+        ('overloads.n13', _time_calls, (append, 5)),
+    ]
+
+
+def _list_from_java_list(java_list):
+    return [java_list.get(i) for i in range(java_list.size())]
+
+
+def _create_conversion_benchmarks(jpy):
+    String = jpy.get_type('java.lang.String')
+    StringBuilder = jpy.get_type('java.lang.StringBuilder')
+    Arrays = jpy.get_type('java.util.Arrays')
+    ArrayList = jpy.get_type('java.util.ArrayList')
+
+    s = String('')
+    benchmarks = []
+    for n in SIZES:
+        py_str = 'x' * n
+        py_ints = list(range(n))
+        py_floats = [float(i) for i in range(n)]
+        java_ints = jpy.array('int', py_ints)
+        java_doubles = jpy.array('double', py_floats)
+        string_builder = StringBuilder(py_str)
+        java_list = ArrayList(n)
+        for i in py_ints:
+            java_list.add(i)
+        benchmarks += [
+            ('string.to_java.%d' % n, _time_calls, (s.equals, py_str)),
+            ('string.from_java.%d' % n, _time_calls, (string_builder.toString,)),
+            ('array.from_list.int.%d' % n, _time_calls, (jpy.array, 'int', py_ints)),
+            ('array.from_list.double.%d' % n, _time_calls, (jpy.array, 'double', py_floats)),
+            ('array.to_list.int.%d' % n, _time_calls, (list, java_ints)),
+            ('array.to_list.double.%d' % n, _time_calls, (list, java_doubles)),
+            ('array.param.list.%d' % n, _time_calls, (Arrays.hashCode, py_ints)),
+            ('array.param.java.%d' % n, _time_calls, (Arrays.hashCode, java_ints)),
+            ('collection.to_list.get.%d' % n, _time_calls, (_list_from_java_list, java_list)),
+            ('collection.to_list.convert.%d' % n, _time_calls, (jpy.convert, java_list)),
+        ]
+    return benchmarks
+
+
+def _create_boxing_benchmarks(jpy):
+    HashMap = jpy.get_type('java.util.HashMap')
+
+    small_map = HashMap()
+    large_map = HashMap()
+    bool_map = HashMap()
+
+    return [
+        ('boxing.map_put.small_int', _time_calls, (small_map.put, 5, 7)),
+        ('boxing.map_put.large_int', _time_calls, (large_map.put, 100000, 700000)),
+        ('boxing.map_put.bool', _time_calls, (bool_map.put, True, False)),
+    ]
+
+
+def _create_field_benchmarks(jpy):
+    Integer = jpy.get_type('java.lang.Integer')
+    Point = jpy.get_type('java.awt.Point')
+
+    point = Point(1, 2)
+
+    return [
+        ('field.static.get', _time_get_attr, (Integer, 'MAX_VALUE')),
+        ('field.instance.get', _time_get_attr, (point, 'x')),
+        ('field.instance.set', _time_set_attr, (point, 'x', 5)),
+    ]
+
+
+def _create_type_benchmarks(jpy):
+    # Types can't be unloaded, so only the lookup of already resolved types can be measured repeatedly
+    jpy.get_type('java.util.HashMap')
+    jpy.get_type('[Ljava.lang.String;')
+
+    return [
+        ('type.get_type', _time_calls, (jpy.get_type, 'java.util.HashMap')),
+        ('type.get_type.array', _time_calls, (jpy.get_type, '[Ljava.lang.String;')),
+    ]
+
+
+def _create_buffer_benchmarks(jpy):
+    Arrays = jpy.get_type('java.util.Arrays')
+
+    benchmarks = []
+    for n in SIZES:
+        java_ints = jpy.array('int', n)
+        py_buffer = array.array('i', range(n))
+        benchmarks += [
+            ('buffer.export.%d' % n, _time_calls, (memoryview, java_ints)),
+            ('buffer.param.%d' % n, _time_calls, (Arrays.hashCode, py_buffer)),
+            ('buffer.to_array.int.%d' % n, _time_calls, (jpy.array, 'int', py_buffer)),
+            ('buffer.to_array.long.%d' % n, _time_calls, (jpy.array, 'long', py_buffer)),
+        ]
+    if np is not None:
+        n = 10000000
+        benchmarks += [
+            ('buffer.to_array.numpy.double.%d' % n, _time_calls, (jpy.array, 'double', np.arange(n, dtype='float64'))),
+            ('buffer.to_array.numpy.int64_to_double.%d' % n, _time_calls, (jpy.array, 'double', np.arange(n))),
+        ]
+    return benchmarks
+
+
+def create_benchmarks(jpy):
+    """
+    :return: a list of (name, time_func, args) tuples suitable for pyperf.Runner.bench_time_func()
+    """
+    return (_create_call_benchmarks(jpy)
+            + _create_overload_benchmarks(jpy)
+            + _create_conversion_benchmarks(jpy)
+            + _create_boxing_benchmarks(jpy)
+            + _create_field_benchmarks(jpy)
+            + _create_type_benchmarks(jpy)
+            + _create_buffer_benchmarks(jpy))
+
+
+def _add_cmdline_args(cmd, args):
+    for prefix in args.select or ():
+        cmd.extend(('--select', prefix))
+
+
+def main():
+    runner = pyperf.Runner(add_cmdline_args=_add_cmdline_args)
+    runner.argparser.add_argument('--select', action='append', metavar='PREFIX',
+                                  help='only run benchmarks whose name starts with PREFIX')
+    args = runner.parse_args()
+
+    runner.metadata['jpy_version'] = jpyutil.__version__
+
+    jpyutil.init_jvm(jvm_maxmem='512M', jvm_options=['-Djava.awt.headless=true'])
+    import jpy
+
+    for name, time_func, func_args in create_benchmarks(jpy):
+        if not args.select or any(name.startswith(prefix) for prefix in args.select):
+            runner.bench_time_func(name, time_func, *func_args)
+
+
+if __name__ == '__main__':
+    main()
@@ -25,6 +25,8 @@
 #include "jpy_jtype.h"
 #include "jpy_jobj.h"
 #include "jpy_conv.h"
+#include "jpy_prof.h"
+#include "jpy_trace.h"
 
 #include "org_jpy_PyLib.h"
 #include "org_jpy_PyLib_Diag.h"
@@ -33,7 +35,56 @@
 // generated by javah. This makes it easier to follow up changes in the header.
 
 PyObject* PyLib_GetAttributeObject(JNIEnv* jenv, PyObject* pyValue, jstring jName);
-PyObject* PyLib_CallAndReturnObject(JNIEnv *jenv, PyObject* pyValue, jboolean isMethodCall, jstring jName, jint argCount, jobjectArray jArgs, jobjectArray jParamClasses);
+
+/**
+ * Timestamps of a profiled Java->Python call, see jpy_prof.h. profile is NULL if the call is not profiled.
+ */
+typedef struct PyLib_CallSample
+{
+    JPy_CallProfile* profile;
+    long long t0;
+    long long t1;
+    long long t2;
+}
+PyLib_CallSample;
+
+/**
+ * A handle for repeated calls of the same Python callable from Java, as used by the generated proxy classes
+ * (see org.jpy.PyProxyGenerator). Everything that doesn't change between calls is resolved once.
+ */
+typedef struct PyLib_CallHandle
+{
+    // The Python object providing the callable (new reference).
+    PyObject* pyObject;
+    // The interned attribute name of the callable (new reference).
+    PyObject* pyName;
+    // The attribute name, used for diagnostics, profiling and tracing.
+    char* nameChars;
+    // The number of parameters.
+    int paramCount;
+    // The parameter types used to convert the Java arguments (new references).
+    JPy_JType** paramTypes;
+    // The cached callable (new reference), NULL if not resolved or not cacheable, see PyLib_GetHandleCallable().
+    PyObject* pyCallable;
+    // The type of pyObject when pyCallable was resolved (new reference), NULL for modules.
+    PyTypeObject* pyType;
+    // The version tag of pyType when pyCallable was resolved.
+    unsigned int typeVersion;
+    // Non-zero, if pyCallable was found in the instance's dictionary.
+    int fromInstanceDict;
+    // The latency profile, created on the first call while profiling is enabled.
+    JPy_CallProfile* profile;
+    // The trace event subject, created on the first call while tracing is enabled.
+    const void* traceName;
+}
+PyLib_CallHandle;
+
+PyObject* PyLib_CallAndReturnObject(JNIEnv *jenv, PyObject* pyValue, jboolean isMethodCall, jstring jName, jint argCount, jobjectArray jArgs, jobjectArray jParamClasses, PyLib_CallSample* sample);
+PyLib_CallHandle* PyLib_NewCallHandle(JNIEnv* jenv, PyObject* pyObject, jstring jName, jobjectArray jParamClasses);
+void PyLib_FreeCallHandle(PyLib_CallHandle* handle);
+PyObject* PyLib_CallHandleAndReturnObject(JNIEnv* jenv, PyLib_CallHandle* handle, jobjectArray jArgs, PyLib_CallSample* sample);
+int PyLib_EndHandleCall(JNIEnv* jenv, PyObject* pyReturnValue, PyLib_CallSample* sample);
+int PyLib_CheckPrimitiveReturnValue(PyObject* pyReturnValue, const char* typeName);
 void PyLib_HandlePythonException(JNIEnv* jenv);
 void PyLib_ThrowOOM(JNIEnv* jenv);
 void PyLib_ThrowFNFE(JNIEnv* jenv, const char *file);
@@ -42,7 +93,8 @@ void PyLib_ThrowRTE(JNIEnv* jenv, const char *message);
 void PyLib_RedirectStdOut(void);
 int copyPythonDictToJavaMap(JNIEnv *jenv, PyObject *pyDict, jobject jMap);
 
-static int JPy_InitThreads = 0;
+// Set once the GIL acquired by Py_Initialize() has been released. A 64-bit integer for use with JPy_ATOMIC_CAS.
+static long long JPy_InitThreads = 0;
 
 //#define JPy_JNI_DEBUG 1
 #define JPy_JNI_DEBUG 0
@@ -54,8 +106,11 @@ static int JPy_InitThreads = 0;
 
 #define JPy_GIL_AWARE
 
+// Only one of several threads entering concurrently for the first time may release the initial GIL
+#define JPy_INIT_THREADS     if (!JPy_ATOMIC_GET(&JPy_InitThreads) && JPy_ATOMIC_CAS(&JPy_InitThreads, 0, 1)) { PyEval_InitThreads(); PyEval_SaveThread(); }
+
 #ifdef JPy_GIL_AWARE
-    #define JPy_BEGIN_GIL_STATE  { PyGILState_STATE gilState; if (!JPy_InitThreads) {JPy_InitThreads = 1; PyEval_InitThreads(); PyEval_SaveThread(); } gilState = PyGILState_Ensure();
+    #define JPy_BEGIN_GIL_STATE  { PyGILState_STATE gilState; JPy_INIT_THREADS gilState = PyGILState_Ensure(); JPy_STAT_INC(JPy_STAT_GIL_ACQUISITIONS);
     #define JPy_END_GIL_STATE    PyGILState_Release(gilState); }
 #else
     #define JPy_BEGIN_GIL_STATE
@@ -500,11 +555,16 @@ JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_newDict
 
 /**
  * Copies a Java Map<String, Object> into a new Python dictionary.
+ *
+ * The local references created per map entry are released every JPy_LOCAL_FRAME_CHUNK_SIZE entries,
+ * so that large maps don't overflow the JNI local reference table.
  */
 PyObject *copyJavaStringObjectMapToPyDict(JNIEnv *jenv, jobject jMap) {
     PyObject *result;
-    jobject entrySet, iterator, mapEntry;
+    jobject entrySet = NULL, iterator = NULL, mapEntry;
     jboolean hasNext;
+    jboolean framePushed = JNI_FALSE;
+    jint index;
 
     result = PyDict_New();
     if (result == NULL) {
@@ -521,14 +581,25 @@ PyObject *copyJavaStringObjectMapToPyDict(JNIEnv *jenv, jobject jMap) {
         goto error;
     }
 
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        goto error;
+    }
+    framePushed = JNI_TRUE;
+
     hasNext = (*jenv)->CallBooleanMethod(jenv, iterator, JPy_Iterator_hasNext_MID);
 
-    while (hasNext) {
+    for (index = 0; hasNext; index++) {
         jobject key, value;
         char const *keyChars;
         PyObject *pyKey;
         PyObject *pyValue;
         JPy_JType* type;
+        int setResult;
+
+        if (JPy_RenewLocalFrame(jenv, index) < 0) {
+            framePushed = JNI_FALSE;
+            goto error;
+        }
 
         mapEntry = (*jenv)->CallObjectMethod(jenv, iterator, JPy_Iterator_next_MID);
         if (mapEntry == NULL) {
@@ -551,35 +622,76 @@ PyObject *copyJavaStringObjectMapToPyDict(JNIEnv *jenv, jobject jMap) {
 
         pyKey = JPy_FROM_CSTR(keyChars);
         (*jenv)->ReleaseStringUTFChars(jenv, (jstring)key, keyChars);
+        if (pyKey == NULL) {
+            goto error;
+        }
 
         value = (*jenv)->CallObjectMethod(jenv, mapEntry, JPy_Map_Entry_getValue_MID);
 
         type = JType_GetTypeForObject(jenv, value);
         pyValue = JType_ConvertJavaToPythonObject(jenv, type, value);
+        if (pyValue == NULL) {
+            Py_DECREF(pyKey);
+            goto error;
+        }
+
+        setResult = PyDict_SetItem(result, pyKey, pyValue);
+        Py_DECREF(pyKey);
+        Py_DECREF(pyValue);
+        if (setResult < 0) {
+            goto error;
+        }
 
-        PyDict_SetItem(result, pyKey, pyValue);
+        (*jenv)->DeleteLocalRef(jenv, value);
+        (*jenv)->DeleteLocalRef(jenv, key);
+        (*jenv)->DeleteLocalRef(jenv, mapEntry);
 
         hasNext = (*jenv)->CallBooleanMethod(jenv, iterator, JPy_Iterator_hasNext_MID);
     }
 
+    (*jenv)->PopLocalFrame(jenv, NULL);
+    (*jenv)->DeleteLocalRef(jenv, iterator);
+    (*jenv)->DeleteLocalRef(jenv, entrySet);
+
     return result;
 
 error:
+    if (framePushed) {
+        (*jenv)->PopLocalFrame(jenv, NULL);
+    }
+    if (iterator != NULL) {
+        (*jenv)->DeleteLocalRef(jenv, iterator);
+    }
+    if (entrySet != NULL) {
+        (*jenv)->DeleteLocalRef(jenv, entrySet);
+    }
     if (result != NULL) {
         Py_XDECREF(result);
     }
     return NULL;
 }
 
+/**
+ * Copies the entries of a Python dictionary back into a Java Map, replacing its previous content.
+ *
+ * All keys and values are converted before the map is cleared, so a conversion error leaves the map untouched.
+ * The converted entries are kept in a single Object[] of alternating keys and values, and the local references
+ * created per entry are released every JPy_LOCAL_FRAME_CHUNK_SIZE entries, so that large dictionaries don't
+ * overflow the JNI local reference table.
+ *
+ * A Java exception pending on entry is preserved. On failure, -1 is returned with either a Java exception or a
+ * Python error set.
+ */
 int copyPythonDictToJavaMap(JNIEnv *jenv, PyObject *pyDict, jobject jMap) {
     PyObject *pyKey, *pyValue;
     Py_ssize_t pos = 0;
     Py_ssize_t dictSize;
-    jobject *jValues = NULL;
-    jobject *jKeys = NULL;
-    int ii;
+    jobjectArray jEntries = NULL;
+    jobject jKey, jValue;
+    jint ii;
     jboolean exceptionAlready = JNI_FALSE;
     jthrowable savedException = NULL;
+    jboolean framePushed = JNI_FALSE;
     int retcode = -1;
 
     if (!PyDict_Check(pyDict)) {
@@ -587,15 +699,6 @@ int copyPythonDictToJavaMap(JNIEnv *jenv, PyObject *pyDict, jobject jMap) {
         return -1;
     }
 
-    dictSize = PyDict_Size(pyDict);
-
-    jKeys = malloc(dictSize * sizeof(jobject));
-    jValues = malloc(dictSize * sizeof(jobject));
-    if (jKeys == NULL || jValues == NULL) {
-        PyLib_ThrowOOM(jenv);
-        goto error;
-    }
-
     exceptionAlready = (*jenv)->ExceptionCheck(jenv);
     if (exceptionAlready) {
         // save the exception away, because otherwise the conversion methods might spuriously fail
@@ -603,40 +706,98 @@ int copyPythonDictToJavaMap(JNIEnv *jenv, PyObject *pyDict, jobject jMap) {
         (*jenv)->ExceptionClear(jenv);
     }
 
+    dictSize = PyDict_Size(pyDict);
+    if (dictSize > 0x7fffffff / 2) {
+        PyErr_SetString(PyExc_OverflowError, "dictionary is too large to be copied into a Java Map");
+        goto error;
+    }
+
+    jEntries = (*jenv)->NewObjectArray(jenv, (jsize) (2 * dictSize), JPy_Object_JClass, NULL);
+    if (jEntries == NULL) {
+        goto error;
+    }
+
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        goto error;
+    }
+    framePushed = JNI_TRUE;
+
     // first convert everything
     ii = 0;
-    while (PyDict_Next(pyDict, &pos, &pyKey, &pyValue)) {
-        if (JPy_AsJObjectWithClass(jenv, pyKey, &(jKeys[ii]), JPy_String_JClass) < 0) {
+    while (ii < dictSize && PyDict_Next(pyDict, &pos, &pyKey, &pyValue)) {
+        if (JPy_RenewLocalFrame(jenv, ii) < 0) {
+            framePushed = JNI_FALSE;
+            goto error;
+        }
+        if (JPy_AsJObjectWithClass(jenv, pyKey, &jKey, JPy_String_JClass) < 0) {
             // an error occurred
             goto error;
         }
-        if (JPy_AsJObject(jenv, pyValue, &(jValues[ii]), JNI_TRUE) < 0) {
+        if (JPy_AsJObject(jenv, pyValue, &jValue, JNI_TRUE) < 0) {
             // an error occurred
             goto error;
         }
+        (*jenv)->SetObjectArrayElement(jenv, jEntries, 2 * ii, jKey);
+        (*jenv)->SetObjectArrayElement(jenv, jEntries, 2 * ii + 1, jValue);
+        (*jenv)->DeleteLocalRef(jenv, jKey);
+        (*jenv)->DeleteLocalRef(jenv, jValue);
         ii++;
     }
+    dictSize = ii;
 
     // now that we've converted, clear out the map and repopulate it
     (*jenv)->CallVoidMethod(jenv, jMap, JPy_Map_clear_MID);
+    if ((*jenv)->ExceptionCheck(jenv)) {
+        goto error;
+    }
     for (ii = 0; ii < dictSize; ++ii) {
-        // since the map is cleared, we want to plow through all of the put operations
-        (*jenv)->CallObjectMethod(jenv, jMap, JPy_Map_put_MID, jKeys[ii], jValues[ii]);
+        jobject jPrevious;
+        if (JPy_RenewLocalFrame(jenv, ii) < 0) {
+            framePushed = JNI_FALSE;
+            goto error;
+        }
+        jKey = (*jenv)->GetObjectArrayElement(jenv, jEntries, 2 * ii);
+        jValue = (*jenv)->GetObjectArrayElement(jenv, jEntries, 2 * ii + 1);
+        jPrevious = (*jenv)->CallObjectMethod(jenv, jMap, JPy_Map_put_MID, jKey, jValue);
+        if ((*jenv)->ExceptionCheck(jenv)) {
+            goto error;
+        }
+        (*jenv)->DeleteLocalRef(jenv, jPrevious);
+        (*jenv)->DeleteLocalRef(jenv, jKey);
+        (*jenv)->DeleteLocalRef(jenv, jValue);
     }
     // and we are successful!
     retcode = 0;
 
 error:
+    if (framePushed) {
+        (*jenv)->PopLocalFrame(jenv, NULL);
+    }
+    if (jEntries != NULL) {
+        (*jenv)->DeleteLocalRef(jenv, jEntries);
+    }
     if (exceptionAlready) {
-        // restore our original exception
+        // restore our original exception, which takes precedence over any raised while copying
+        (*jenv)->ExceptionClear(jenv);
         (*jenv)->Throw(jenv, savedException);
+        (*jenv)->DeleteLocalRef(jenv, savedException);
     }
-
-    free(jKeys);
-    free(jValues);
     return retcode;
 }
 
+/**
+ * Turns a failure of copyPythonDictToJavaMap into a Java exception, unless one is already pending.
+ */
+static void PyLib_HandleCopyBackError(JNIEnv *jenv, const char *message) {
+    if ((*jenv)->ExceptionCheck(jenv)) {
+        PyErr_Clear();
+    } else if (PyErr_Occurred()) {
+        PyLib_HandlePythonException(jenv);
+    } else {
+        PyLib_ThrowRTE(jenv, message);
+    }
+}
+
 typedef PyObject * (*DoRun)(const void *,int,PyObject*,PyObject*);
 
 /**
@@ -678,7 +839,7 @@ jlong executeInternal(JNIEnv* jenv, jclass jLibClass, jint jStart, jobject jGlob
         }
     } else if ((*jenv)->IsInstanceOf(jenv, jGlobals, JPy_PyObject_JClass)) {
         // if we are an instance of PyObject, just use the object
-        pyGlobals = (PyObject *)((*jenv)->CallLongMethod(jenv, jGlobals, JPy_PyObject_GetPointer_MID));
+        pyGlobals = JPy_GetPyObjectPointer(jenv, jGlobals);
         JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_executeInternal: using PyObject globals\n");
     } else if ((*jenv)->IsInstanceOf(jenv, jGlobals, JPy_PyDictWrapper_JClass)) {
         // if we are an instance of a wrapped dictionary, just use the underlying dictionary
@@ -709,7 +870,7 @@ jlong executeInternal(JNIEnv* jenv, jclass jLibClass, jint jStart, jobject jGlob
     } else if ((*jenv)->IsInstanceOf(jenv, jLocals, JPy_PyObject_JClass)) {
         // if we are an instance of PyObject, just use the object
         JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_executeInternal: using PyObject locals\n");
-        pyLocals = (PyObject *)((*jenv)->CallLongMethod(jenv, jLocals, JPy_PyObject_GetPointer_MID));
+        pyLocals = JPy_GetPyObjectPointer(jenv, jLocals);
     } else if ((*jenv)->IsInstanceOf(jenv, jLocals, JPy_PyDictWrapper_JClass)) {
         // if we are an instance of a wrapped dictionary, just use the underlying dictionary
         pyLocals = (PyObject *)((*jenv)->CallLongMethod(jenv, jLocals, JPy_PyDictWrapper_GetPointer_MID));
@@ -741,11 +902,17 @@ jlong executeInternal(JNIEnv* jenv, jclass jLibClass, jint jStart, jobject jGlob
 
 error:
     if (copyGlobals) {
-        copyPythonDictToJavaMap(jenv, pyGlobals, jGlobals);
+        if (copyPythonDictToJavaMap(jenv, pyGlobals, jGlobals) < 0) {
+            PyLib_HandleCopyBackError(jenv, "Could not copy globals from Python dictionary back to Java Map");
+            Py_CLEAR(pyReturnValue);
+        }
         JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_executeInternal: copied back Java global\n");
     }
     if (copyLocals) {
-        copyPythonDictToJavaMap(jenv, pyLocals, jLocals);
+        if (copyPythonDictToJavaMap(jenv, pyLocals, jLocals) < 0) {
+            PyLib_HandleCopyBackError(jenv, "Could not copy locals from Python dictionary back to Java Map");
+            Py_CLEAR(pyReturnValue);
+        }
         JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_executeInternal: copied back Java locals\n");
     }
     if (decGlobals) {
@@ -873,7 +1040,7 @@ JNIEXPORT void JNICALL Java_org_jpy_PyLib_incRef
     if (Py_IsInitialized()) {
         JPy_BEGIN_GIL_STATE
 
-        refCount = pyObject->ob_refcnt;
+        refCount = Py_REFCNT(pyObject);
         JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "Java_org_jpy_PyLib_incRef: pyObject=%p, refCount=%d, type='%s'\n", pyObject, refCount, Py_TYPE(pyObject)->tp_name);
         Py_INCREF(pyObject);
 
@@ -899,7 +1066,7 @@ JNIEXPORT void JNICALL Java_org_jpy_PyLib_decRef
     if (Py_IsInitialized()) {
         JPy_BEGIN_GIL_STATE
 
-        refCount = pyObject->ob_refcnt;
+        refCount = Py_REFCNT(pyObject);
         if (refCount <= 0) {
             JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "Java_org_jpy_PyLib_decRef: error: refCount <= 0: pyObject=%p, refCount=%d\n", pyObject, refCount);
         } else {
@@ -1406,29 +1573,51 @@ JNIEXPORT jobjectArray JNICALL Java_org_jpy_PyLib_getObjectArrayValue
         length = PySequence_Length(pyObject);
 
         jObject = (*jenv)->NewObjectArray(jenv, length, itemClassRef, NULL);
+        if (jObject == NULL) {
+            goto error;
+        }
+
+        // The array lives outside of the frame, the converted items are released chunk-wise.
+        if (JPy_PushLocalFrame(jenv) < 0) {
+            (*jenv)->DeleteLocalRef(jenv, jObject);
+            jObject = NULL;
+            goto error;
+        }
 
         for (i = 0; i < length; i++) {
+            if (JPy_RenewLocalFrame(jenv, i) < 0) {
+                (*jenv)->DeleteLocalRef(jenv, jObject);
+                jObject = NULL;
+                goto error;
+            }
             pyItem = PySequence_GetItem(pyObject, i);
             if (pyItem == NULL) {
+                (*jenv)->PopLocalFrame(jenv, NULL);
                 (*jenv)->DeleteLocalRef(jenv, jObject);
                 jObject = NULL;
+                PyLib_HandlePythonException(jenv);
                 goto error;
             }
             if (JPy_AsJObject(jenv, pyItem, &jItem, JNI_FALSE) < 0) {
+                Py_DECREF(pyItem);
+                (*jenv)->PopLocalFrame(jenv, NULL);
                 (*jenv)->DeleteLocalRef(jenv, jObject);
                 jObject = NULL;
                 JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "Java_org_jpy_PyLib_getObjectArrayValue: error: failed to convert Python item to Java Object\n");
                 PyLib_HandlePythonException(jenv);
                 goto error;
             }
-            Py_XDECREF(pyItem);
+            Py_DECREF(pyItem);
             (*jenv)->SetObjectArrayElement(jenv, jObject, i, jItem);
             if ((*jenv)->ExceptionCheck(jenv)) {
+                (*jenv)->PopLocalFrame(jenv, NULL);
                 (*jenv)->DeleteLocalRef(jenv, jObject);
                 jObject = NULL;
                 goto error;
             }
         }
+
+        (*jenv)->PopLocalFrame(jenv, NULL);
     } else {
         jObject = NULL;
         (*jenv)->ThrowNew(jenv, JPy_RuntimeException_JClass, "python object cannot be converted to Object[]");
@@ -1440,6 +1629,32 @@ error:
     return jObject;
 }
 
+/**
+ * Converts a Python object and all Python containers nested in it into Java objects, see JPy_AsJObjectDeep().
+ *
+ * objId is a pointer to a PyObject, targetClass the requested Java type of the result.
+ */
+JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_toJava
+  (JNIEnv* jenv, jclass jLibClass, jlong objId, jclass targetClass)
+{
+    JPy_JType* type;
+    jobject jObject;
+
+    JPy_BEGIN_GIL_STATE
+
+    jObject = NULL;
+    type = JType_GetType(jenv, targetClass, JNI_FALSE);
+    if (type == NULL || JPy_AsJObjectDeep(jenv, (PyObject*) objId, type, &jObject) < 0) {
+        jObject = NULL;
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "Java_org_jpy_PyLib_toJava: error: failed to convert Python object to Java Object\n");
+        PyLib_HandlePythonException(jenv);
+    }
+
+    JPy_END_GIL_STATE
+
+    return jObject;
+}
+
 
 /*
  * Class:     org_jpy_python_PyLib
@@ -1687,11 +1902,16 @@ JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_callAndReturnObject
 {
     PyObject* pyObject;
     PyObject* pyReturnValue;
+    PyLib_CallSample sample;
 
     JPy_BEGIN_GIL_STATE
 
     pyObject = (PyObject*) objId;
-    pyReturnValue = PyLib_CallAndReturnObject(jenv, pyObject, isMethodCall, jName, argCount, jArgs, jParamClasses);
+    pyReturnValue = PyLib_CallAndReturnObject(jenv, pyObject, isMethodCall, jName, argCount, jArgs, jParamClasses, &sample);
+    if (pyReturnValue != NULL && sample.profile != NULL) {
+        // No result conversion here, the Python object is returned as-is
+        JPy_RecordCall(sample.profile, sample.t0, sample.t1, sample.t2, sample.t2);
+    }
 
     JPy_END_GIL_STATE
 
@@ -1710,12 +1930,13 @@ JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_callAndReturnValue
     PyObject* pyObject;
     PyObject* pyReturnValue;
     jobject jReturnValue;
+    PyLib_CallSample sample;
 
     JPy_BEGIN_GIL_STATE
 
     pyObject = (PyObject*) objId;
 
-    pyReturnValue = PyLib_CallAndReturnObject(jenv, pyObject, isMethodCall, jName, argCount, jArgs, jParamClasses);
+    pyReturnValue = PyLib_CallAndReturnObject(jenv, pyObject, isMethodCall, jName, argCount, jArgs, jParamClasses, &sample);
     if (pyReturnValue == NULL) {
         jReturnValue = NULL;
         goto error;
@@ -1729,6 +1950,10 @@ JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_callAndReturnValue
         goto error;
     }
 
+    if (sample.profile != NULL) {
+        JPy_RecordCall(sample.profile, sample.t0, sample.t1, sample.t2, JPy_GetNanos());
+    }
+
 error:
     JPy_END_GIL_STATE
 
@@ -1737,141 +1962,1042 @@ error:
 
 
 /*
- * Class:     org_jpy_python_PyLib
- * Method:    getDiagFlags
- * Signature: ()I
+ * Class:     org_jpy_PyLib
+ * Method:    newCallHandle
+ * Signature: (JLjava/lang/String;[Ljava/lang/Class;)J
  */
-JNIEXPORT jint JNICALL Java_org_jpy_PyLib_00024Diag_getFlags
-  (JNIEnv *jenv, jclass classRef)
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_newCallHandle
+  (JNIEnv *jenv, jclass jLibClass, jlong objId, jstring jName, jobjectArray jParamClasses)
 {
-    return JPy_DiagFlags;
+    PyLib_CallHandle* handle;
+
+    JPy_BEGIN_GIL_STATE
+
+    handle = PyLib_NewCallHandle(jenv, (PyObject*) objId, jName, jParamClasses);
+
+    JPy_END_GIL_STATE
+
+    return (jlong) handle;
 }
 
+
 /*
- * Class:     org_jpy_python_PyLib
- * Method:    setDiagFlags
- * Signature: (I)V
+ * Class:     org_jpy_PyLib
+ * Method:    releaseCallHandle
+ * Signature: (J)V
  */
-JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_setFlags
-  (JNIEnv *jenv, jclass classRef, jint flags)
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_releaseCallHandle
+  (JNIEnv *jenv, jclass jLibClass, jlong handleId)
 {
-    JPy_DiagFlags = flags;
-}
+    if (Py_IsInitialized()) {
+        JPy_BEGIN_GIL_STATE
 
-////////////////////////////////////////////////////////////////////////////////////
-// Helpers that also throw Java exceptions
+        PyLib_FreeCallHandle((PyLib_CallHandle*) handleId);
 
+        JPy_END_GIL_STATE
+    } else {
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "Java_org_jpy_PyLib_releaseCallHandle: error: no interpreter: handle=%p\n", (void*) handleId);
+    }
+}
 
-PyObject* PyLib_GetAttributeObject(JNIEnv* jenv, PyObject* pyObject, jstring jName)
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandle
+ * Signature: (J[Ljava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_callHandle
+  (JNIEnv *jenv, jclass jLibClass, jlong handleId, jobjectArray jArgs)
 {
-    PyObject* pyValue = NULL;
-    const char* nameChars;
+    PyObject* pyReturnValue;
+    PyLib_CallSample sample;
 
-    nameChars = (*jenv)->GetStringUTFChars(jenv, jName, NULL);
-    if (nameChars == NULL) {
-        PyLib_ThrowOOM(jenv);
-        goto error;
-    }
-    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "PyLib_GetAttributeObject: objId=%p, name='%s'\n", pyObject, nameChars);
-    /* Note: pyValue is a new reference */
-    pyValue = PyObject_GetAttrString(pyObject, nameChars);
-    if (pyValue == NULL) {
-        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_GetAttributeObject: error: attribute not found '%s'\n", nameChars);
-        PyLib_HandlePythonException(jenv);
-    }
-error:
-    if (nameChars != NULL) {
-        (*jenv)->ReleaseStringUTFChars(jenv, jName, nameChars);
+    JPy_BEGIN_GIL_STATE
+
+    pyReturnValue = PyLib_CallHandleAndReturnObject(jenv, (PyLib_CallHandle*) handleId, jArgs, &sample);
+    if (pyReturnValue != NULL) {
+        PyLib_EndHandleCall(jenv, pyReturnValue, &sample);
     }
-    return pyValue;
+
+    JPy_END_GIL_STATE
 }
 
-PyObject* PyLib_CallAndReturnObject(JNIEnv *jenv, PyObject* pyObject, jboolean isMethodCall, jstring jName, jint argCount, jobjectArray jArgs, jobjectArray jParamClasses)
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnBoolean
+ * Signature: (J[Ljava/lang/Object;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_jpy_PyLib_callHandleAndReturnBoolean
+  (JNIEnv *jenv, jclass jLibClass, jlong handleId, jobjectArray jArgs)
 {
-    PyObject* pyCallable = NULL;
-    PyObject* pyArgs = NULL;
-    PyObject* pyArg;
-    PyObject* pyReturnValue = Py_None;
-    const char* nameChars;
-    jint i;
-    jobject jArg;
-    jclass jParamClass;
-    JPy_JType* paramType;
+    PyObject* pyReturnValue;
+    PyLib_CallSample sample;
+    jboolean value = JNI_FALSE;
 
-    pyReturnValue = NULL;
+    JPy_BEGIN_GIL_STATE
 
-    nameChars = (*jenv)->GetStringUTFChars(jenv, jName, NULL);
-    if (nameChars == NULL) {
-        PyLib_ThrowOOM(jenv);
-        goto error;
+    pyReturnValue = PyLib_CallHandleAndReturnObject(jenv, (PyLib_CallHandle*) handleId, jArgs, &sample);
+    if (pyReturnValue != NULL) {
+        if (PyLib_CheckPrimitiveReturnValue(pyReturnValue, "boolean") == 0) {
+            value = JPy_AS_JBOOLEAN(pyReturnValue);
+        }
+        PyLib_EndHandleCall(jenv, pyReturnValue, &sample);
     }
 
-    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "PyLib_CallAndReturnObject: objId=%p, isMethodCall=%d, name='%s', argCount=%d\n", pyObject, isMethodCall, nameChars, argCount);
+    JPy_END_GIL_STATE
 
-    pyArgs = NULL;
+    return value;
+}
 
-    // Note: pyCallable is a new reference
-    pyCallable = PyObject_GetAttrString(pyObject, nameChars);
-    if (pyCallable == NULL) {
-        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: function or method not found: '%s'\n", nameChars);
-        PyLib_HandlePythonException(jenv);
-        goto error;
-    }
 
-    if (!PyCallable_Check(pyCallable)) {
-        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: object is not callable: '%s'\n", nameChars);
-        PyLib_HandlePythonException(jenv);
-        goto error;
-    }
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnInt
+ * Signature: (J[Ljava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL Java_org_jpy_PyLib_callHandleAndReturnInt
+  (JNIEnv *jenv, jclass jLibClass, jlong handleId, jobjectArray jArgs)
+{
+    PyObject* pyReturnValue;
+    PyLib_CallSample sample;
+    jint value = 0;
 
-    pyArgs = PyTuple_New(argCount);
-    for (i = 0; i < argCount; i++) {
-        jArg = (*jenv)->GetObjectArrayElement(jenv, jArgs, i);
+    JPy_BEGIN_GIL_STATE
 
-        if (jParamClasses != NULL) {
-            jParamClass = (*jenv)->GetObjectArrayElement(jenv, jParamClasses, i);
-        } else {
-            jParamClass = NULL;
+    pyReturnValue = PyLib_CallHandleAndReturnObject(jenv, (PyLib_CallHandle*) handleId, jArgs, &sample);
+    if (pyReturnValue != NULL) {
+        if (PyLib_CheckPrimitiveReturnValue(pyReturnValue, "int") == 0) {
+            value = JPy_AS_JINT(pyReturnValue);
         }
+        PyLib_EndHandleCall(jenv, pyReturnValue, &sample);
+    }
 
-        if (jParamClass != NULL) {
-            paramType = JType_GetType(jenv, jParamClass, JNI_FALSE);
-            if (paramType == NULL) {
-                JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: callable '%s': argument %d: failed to retrieve type\n", nameChars, i);
-                PyLib_HandlePythonException(jenv);
-                goto error;
-            }
-            pyArg = JPy_FromJObjectWithType(jenv, jArg, paramType);
+    JPy_END_GIL_STATE
 
-            // We must keep unchanged the reference counter when calling a Python method
-            // with a complex Python object as parameter. 
-            // Per example:
-            // PyObject dt_X = kycProcessor.getDataFrame(inputColumns.toArray(new String[0]));
-            // for (DataFrameColumn column : values) {
-            //    kycProcessor.addColumn(dt_X, column.getName(), column.getValues());
-            // }
-            if (paramType == JPy_JPyObject && paramType->componentType == NULL) {
-                Py_INCREF(pyArg);
-            } 
+    return value;
+}
 
-            (*jenv)->DeleteLocalRef(jenv, jParamClass);
-        } else {
-            pyArg = JPy_FromJObject(jenv, jArg);
-        }
 
-        (*jenv)->DeleteLocalRef(jenv, jArg);
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnLong
+ * Signature: (J[Ljava/lang/Object;)J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_callHandleAndReturnLong
+  (JNIEnv *jenv, jclass jLibClass, jlong handleId, jobjectArray jArgs)
+{
+    PyObject* pyReturnValue;
+    PyLib_CallSample sample;
+    jlong value = 0;
 
-        if (pyArg == NULL) {
-            JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: callable '%s': argument %d: failed to convert Java into Python object\n", nameChars, i);
-            PyLib_HandlePythonException(jenv);
-            goto error;
-        }
+    JPy_BEGIN_GIL_STATE
 
-        // pyArg reference stolen here
-        PyTuple_SetItem(pyArgs, i, pyArg);
+    pyReturnValue = PyLib_CallHandleAndReturnObject(jenv, (PyLib_CallHandle*) handleId, jArgs, &sample);
+    if (pyReturnValue != NULL) {
+        if (PyLib_CheckPrimitiveReturnValue(pyReturnValue, "long") == 0) {
+            value = JPy_AS_JLONG(pyReturnValue);
+        }
+        PyLib_EndHandleCall(jenv, pyReturnValue, &sample);
     }
 
-    // Check why: for some reason, we don't need the following code to invoke object methods.
+    JPy_END_GIL_STATE
+
+    return value;
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnDouble
+ * Signature: (J[Ljava/lang/Object;)D
+ */
+JNIEXPORT jdouble JNICALL Java_org_jpy_PyLib_callHandleAndReturnDouble
+  (JNIEnv *jenv, jclass jLibClass, jlong handleId, jobjectArray jArgs)
+{
+    PyObject* pyReturnValue;
+    PyLib_CallSample sample;
+    jdouble value = 0.0;
+
+    JPy_BEGIN_GIL_STATE
+
+    pyReturnValue = PyLib_CallHandleAndReturnObject(jenv, (PyLib_CallHandle*) handleId, jArgs, &sample);
+    if (pyReturnValue != NULL) {
+        if (PyLib_CheckPrimitiveReturnValue(pyReturnValue, "double") == 0) {
+            value = JPy_AS_JDOUBLE(pyReturnValue);
+        }
+        PyLib_EndHandleCall(jenv, pyReturnValue, &sample);
+    }
+
+    JPy_END_GIL_STATE
+
+    return value;
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnValue
+ * Signature: (J[Ljava/lang/Object;Ljava/lang/Class;)Ljava/lang/Object;
+ */
+JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_callHandleAndReturnValue
+  (JNIEnv *jenv, jclass jLibClass, jlong handleId, jobjectArray jArgs, jclass jReturnClass)
+{
+    PyObject* pyReturnValue;
+    PyLib_CallSample sample;
+    jobject jReturnValue = NULL;
+
+    JPy_BEGIN_GIL_STATE
+
+    pyReturnValue = PyLib_CallHandleAndReturnObject(jenv, (PyLib_CallHandle*) handleId, jArgs, &sample);
+    if (pyReturnValue != NULL) {
+        if (JPy_AsJObjectWithClass(jenv, pyReturnValue, &jReturnValue, jReturnClass) < 0) {
+            JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "Java_org_jpy_PyLib_callHandleAndReturnValue: error: failed to convert return value\n");
+            jReturnValue = NULL;
+        }
+        if (PyLib_EndHandleCall(jenv, pyReturnValue, &sample) < 0) {
+            jReturnValue = NULL;
+        }
+    }
+
+    JPy_END_GIL_STATE
+
+    return jReturnValue;
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    attachThread
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_attachThread
+  (JNIEnv *jenv, jclass jLibClass)
+{
+    PyThreadState* threadState;
+
+    JPy_INIT_THREADS
+
+    // Creates the calling thread's Python thread state, which is kept until detachThread() is called.
+    // Further PyGILState_Ensure() calls from this thread, e.g. by other PyLib functions called while
+    // the thread holds the GIL, will only increment the thread state's counter.
+    PyGILState_Ensure();
+    JPy_STAT_INC(JPy_STAT_GIL_ACQUISITIONS);
+    threadState = PyEval_SaveThread();
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_attachThread: threadState=%p\n", threadState);
+
+    return (jlong) threadState;
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    detachThread
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_detachThread
+  (JNIEnv *jenv, jclass jLibClass, jlong threadState)
+{
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_detachThread: threadState=%p\n", (void*) threadState);
+
+    PyEval_RestoreThread((PyThreadState*) threadState);
+    // Releases the GIL and deletes the thread state created by attachThread()
+    PyGILState_Release(PyGILState_UNLOCKED);
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    acquireGIL
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_acquireGIL
+  (JNIEnv *jenv, jclass jLibClass, jlong threadState)
+{
+    PyEval_RestoreThread((PyThreadState*) threadState);
+    JPy_STAT_INC(JPy_STAT_GIL_ACQUISITIONS);
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    releaseGIL
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_releaseGIL
+  (JNIEnv *jenv, jclass jLibClass, jlong threadState)
+{
+    PyEval_SaveThread();
+}
+
+
+#if PY_VERSION_HEX >= 0x030C0000
+
+// java.lang.Object[], set by newSubInterpreter()
+static jclass PyLib_ObjectArray_JClass = NULL;
+
+/**
+ * Converts a Java value into a Python object of the current sub-interpreter.
+ * Only plain values are supported, because jpy's own types belong to the main interpreter:
+ * null, Boolean, Number, Character, String and Object[] (converted into a list).
+ */
+static PyObject* PyLib_SubInterpreterFromJava(JNIEnv* jenv, jobject jValue)
+{
+    if (jValue == NULL) {
+        return Py_BuildValue("");
+    } else if ((*jenv)->IsInstanceOf(jenv, jValue, JPy_String_JClass)) {
+        return JPy_FromJString(jenv, (jstring) jValue);
+    } else if ((*jenv)->IsInstanceOf(jenv, jValue, JPy_Boolean_JClass)) {
+        return PyBool_FromLong((*jenv)->CallBooleanMethod(jenv, jValue, JPy_Boolean_BooleanValue_MID));
+    } else if ((*jenv)->IsInstanceOf(jenv, jValue, JPy_Double_JClass)
+               || (*jenv)->IsInstanceOf(jenv, jValue, JPy_Float_JClass)) {
+        return PyFloat_FromDouble((*jenv)->CallDoubleMethod(jenv, jValue, JPy_Number_DoubleValue_MID));
+    } else if ((*jenv)->IsInstanceOf(jenv, jValue, JPy_Number_JClass)) {
+        return PyLong_FromLongLong((*jenv)->CallLongMethod(jenv, jValue, JPy_Number_LongValue_MID));
+    } else if ((*jenv)->IsInstanceOf(jenv, jValue, JPy_Character_JClass)) {
+        jchar jChar = (*jenv)->CallCharMethod(jenv, jValue, JPy_Character_CharValue_MID);
+        return PyUnicode_FromOrdinal(jChar);
+    } else if ((*jenv)->IsInstanceOf(jenv, jValue, PyLib_ObjectArray_JClass)) {
+        jsize i, length;
+        PyObject* pyList;
+        length = (*jenv)->GetArrayLength(jenv, (jarray) jValue);
+        pyList = PyList_New(length);
+        if (pyList == NULL) {
+            return NULL;
+        }
+        for (i = 0; i < length; i++) {
+            jobject jItem;
+            PyObject* pyItem;
+            jItem = (*jenv)->GetObjectArrayElement(jenv, (jobjectArray) jValue, i);
+            pyItem = PyLib_SubInterpreterFromJava(jenv, jItem);
+            (*jenv)->DeleteLocalRef(jenv, jItem);
+            if (pyItem == NULL) {
+                Py_DECREF(pyList);
+                return NULL;
+            }
+            PyList_SET_ITEM(pyList, i, pyItem);
+        }
+        return pyList;
+    }
+    PyErr_SetString(PyExc_TypeError, "sub-interpreter arguments must be null, Boolean, Number, Character, String or Object[]");
+    return NULL;
+}
+
+/**
+ * Converts a Python object of the current sub-interpreter into a Java value:
+ * None, bool, int, float, str, list and tuple (converted into an Object[]).
+ * Returns 0 on success. Otherwise -1 is returned and either a Python error is set or a Java exception is pending.
+ */
+static int PyLib_SubInterpreterToJava(JNIEnv* jenv, PyObject* pyValue, jobject* jValue)
+{
+    *jValue = NULL;
+    if (pyValue == Py_None) {
+        return 0;
+    } else if (PyBool_Check(pyValue)) {
+        *jValue = (*jenv)->CallStaticObjectMethod(jenv, JPy_Boolean_JClass, JPy_Boolean_ValueOf_MID, (jboolean) (pyValue == Py_True));
+    } else if (PyLong_Check(pyValue)) {
+        jlong value = (jlong) PyLong_AsLongLong(pyValue);
+        if (value == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        *jValue = (*jenv)->CallStaticObjectMethod(jenv, JPy_Long_JClass, JPy_Long_ValueOf_MID, value);
+    } else if (PyFloat_Check(pyValue)) {
+        *jValue = (*jenv)->CallStaticObjectMethod(jenv, JPy_Double_JClass, JPy_Double_ValueOf_MID, (jdouble) PyFloat_AsDouble(pyValue));
+    } else if (PyUnicode_Check(pyValue)) {
+        return JPy_AsJString(jenv, pyValue, (jstring*) jValue);
+    } else if (PyList_Check(pyValue) || PyTuple_Check(pyValue)) {
+        PyObject* pySeq;
+        Py_ssize_t i, length;
+        jobjectArray jArray;
+        pySeq = PySequence_Fast(pyValue, "");
+        if (pySeq == NULL) {
+            return -1;
+        }
+        length = PySequence_Fast_GET_SIZE(pySeq);
+        jArray = (*jenv)->NewObjectArray(jenv, (jsize) length, JPy_Object_JClass, NULL);
+        if (jArray == NULL) {
+            Py_DECREF(pySeq);
+            return -1;
+        }
+        for (i = 0; i < length; i++) {
+            jobject jItem;
+            if (PyLib_SubInterpreterToJava(jenv, PySequence_Fast_GET_ITEM(pySeq, i), &jItem) < 0) {
+                Py_DECREF(pySeq);
+                (*jenv)->DeleteLocalRef(jenv, jArray);
+                return -1;
+            }
+            (*jenv)->SetObjectArrayElement(jenv, jArray, (jsize) i, jItem);
+            (*jenv)->DeleteLocalRef(jenv, jItem);
+        }
+        Py_DECREF(pySeq);
+        *jValue = jArray;
+        return 0;
+    } else {
+        PyErr_Format(PyExc_TypeError, "cannot convert a Python '%s' returned by a sub-interpreter into a Java value",
+                     Py_TYPE(pyValue)->tp_name);
+        return -1;
+    }
+    return *jValue != NULL ? 0 : -1;
+}
+
+/**
+ * Copies the entries of the current interpreter's sys.path into a new array of UTF-8 strings
+ * allocated by PyMem_RawMalloc, so that they can be passed to another interpreter.
+ */
+static int PyLib_CopyPathEntries(char*** paths, Py_ssize_t* pathCount)
+{
+    PyObject* pyPathList;
+    Py_ssize_t i, n;
+
+    *paths = NULL;
+    *pathCount = 0;
+    pyPathList = PySys_GetObject("path");
+    if (pyPathList == NULL || !PyList_Check(pyPathList)) {
+        return 0;
+    }
+    n = PyList_GET_SIZE(pyPathList);
+    *paths = PyMem_RawCalloc(n + 1, sizeof(char*));
+    if (*paths == NULL) {
+        return -1;
+    }
+    for (i = 0; i < n; i++) {
+        PyObject* pyPath = PyList_GET_ITEM(pyPathList, i);
+        const char* pathChars;
+        Py_ssize_t length;
+        if (!PyUnicode_Check(pyPath)) {
+            continue;
+        }
+        pathChars = PyUnicode_AsUTF8AndSize(pyPath, &length);
+        if (pathChars == NULL) {
+            return -1;
+        }
+        (*paths)[*pathCount] = PyMem_RawMalloc(length + 1);
+        if ((*paths)[*pathCount] == NULL) {
+            return -1;
+        }
+        memcpy((*paths)[*pathCount], pathChars, length + 1);
+        (*pathCount)++;
+    }
+    return 0;
+}
+
+static void PyLib_FreePathEntries(char** paths, Py_ssize_t pathCount)
+{
+    Py_ssize_t i;
+    if (paths != NULL) {
+        for (i = 0; i < pathCount; i++) {
+            PyMem_RawFree(paths[i]);
+        }
+        PyMem_RawFree(paths);
+    }
+}
+
+/**
+ * Sets the current interpreter's sys.path to the given UTF-8 strings.
+ */
+static int PyLib_SetPathEntries(char** paths, Py_ssize_t pathCount)
+{
+    PyObject* pyPathList;
+    Py_ssize_t i;
+    int result;
+
+    pyPathList = PyList_New(pathCount);
+    if (pyPathList == NULL) {
+        return -1;
+    }
+    for (i = 0; i < pathCount; i++) {
+        PyObject* pyPath = PyUnicode_FromString(paths[i]);
+        if (pyPath == NULL) {
+            Py_DECREF(pyPathList);
+            return -1;
+        }
+        PyList_SET_ITEM(pyPathList, i, pyPath);
+    }
+    result = PySys_SetObject("path", pyPathList);
+    Py_DECREF(pyPathList);
+    return result;
+}
+
+#endif
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    newSubInterpreter
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_newSubInterpreter
+  (JNIEnv *jenv, jclass jLibClass)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+    // An isolated interpreter with its own GIL. Extension modules not supporting multiple interpreters,
+    // such as jpy itself, cannot be imported into it.
+    PyInterpreterConfig config = {
+        .use_main_obmalloc = 0,
+        .allow_fork = 0,
+        .allow_exec = 0,
+        .allow_threads = 1,
+        .allow_daemon_threads = 0,
+        .check_multi_interp_extensions = 1,
+        .gil = PyInterpreterConfig_OWN_GIL,
+    };
+    PyThreadState* mainThreadState;
+    PyThreadState* threadState = NULL;
+    PyStatus status;
+    char** paths = NULL;
+    Py_ssize_t pathCount = 0;
+    int pathsCopied;
+
+    if (PyLib_ObjectArray_JClass == NULL) {
+        jclass objectArrayClass = (*jenv)->FindClass(jenv, "[Ljava/lang/Object;");
+        if (objectArrayClass == NULL) {
+            return 0;
+        }
+        PyLib_ObjectArray_JClass = (*jenv)->NewGlobalRef(jenv, objectArrayClass);
+        (*jenv)->DeleteLocalRef(jenv, objectArrayClass);
+    }
+
+    status = PyStatus_Ok();
+
+    JPy_BEGIN_GIL_STATE
+
+    mainThreadState = PyThreadState_Get();
+    // The sub-interpreter's sys.path shall include the entries added to the main interpreter's one
+    pathsCopied = PyLib_CopyPathEntries(&paths, &pathCount);
+    if (pathsCopied < 0) {
+        PyLib_HandlePythonException(jenv);
+    } else {
+        // On success, this releases the main interpreter's GIL and makes the new interpreter's thread state current
+        status = Py_NewInterpreterFromConfig(&threadState, &config);
+        if (!PyStatus_Exception(status) && threadState != NULL) {
+            if (PyLib_SetPathEntries(paths, pathCount) < 0) {
+                PyLib_HandlePythonException(jenv);
+                Py_EndInterpreter(threadState);
+                threadState = NULL;
+            } else {
+                PyEval_SaveThread();
+            }
+            PyEval_RestoreThread(mainThreadState);
+        } else {
+            threadState = NULL;
+        }
+    }
+
+    JPy_END_GIL_STATE
+
+    PyLib_FreePathEntries(paths, pathCount);
+
+    if (PyStatus_Exception(status)) {
+        PyLib_ThrowRTE(jenv, status.err_msg != NULL ? status.err_msg : "failed to create a Python sub-interpreter");
+    }
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_newSubInterpreter: threadState=%p\n", threadState);
+
+    return (jlong) threadState;
+#else
+    PyLib_ThrowUOE(jenv, "Python sub-interpreters with their own GIL require Python 3.12 or higher");
+    return 0;
+#endif
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    endSubInterpreter
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_endSubInterpreter
+  (JNIEnv *jenv, jclass jLibClass, jlong threadState)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "Java_org_jpy_PyLib_endSubInterpreter: threadState=%p\n", (void*) threadState);
+
+    PyEval_RestoreThread((PyThreadState*) threadState);
+    Py_EndInterpreter((PyThreadState*) threadState);
+#endif
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    execInSubInterpreter
+ * Signature: (JLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_execInSubInterpreter
+  (JNIEnv *jenv, jclass jLibClass, jlong threadState, jstring jCode)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+    const char* codeChars;
+    PyObject* pyMainModule;
+    PyObject* pyResult = NULL;
+
+    codeChars = (*jenv)->GetStringUTFChars(jenv, jCode, NULL);
+    if (codeChars == NULL) {
+        PyLib_ThrowOOM(jenv);
+        return;
+    }
+
+    PyEval_RestoreThread((PyThreadState*) threadState);
+    JPy_STAT_INC(JPy_STAT_GIL_ACQUISITIONS);
+
+    pyMainModule = PyImport_AddModule("__main__");
+    if (pyMainModule != NULL) {
+        PyObject* pyGlobals = PyModule_GetDict(pyMainModule);
+        pyResult = PyRun_String(codeChars, Py_file_input, pyGlobals, pyGlobals);
+    }
+    if (pyResult == NULL) {
+        PyLib_HandlePythonException(jenv);
+    }
+    Py_XDECREF(pyResult);
+
+    PyEval_SaveThread();
+
+    (*jenv)->ReleaseStringUTFChars(jenv, jCode, codeChars);
+#else
+    PyLib_ThrowUOE(jenv, "Python sub-interpreters with their own GIL require Python 3.12 or higher");
+#endif
+}
+
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callInSubInterpreter
+ * Signature: (JLjava/lang/String;Ljava/lang/String;[Ljava/lang/Object;)Ljava/lang/Object;
+ */
+JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_callInSubInterpreter
+  (JNIEnv *jenv, jclass jLibClass, jlong threadState, jstring jModuleName, jstring jFunctionName, jobjectArray jArgs)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+    const char* moduleNameChars;
+    const char* functionNameChars;
+    PyObject* pyModule = NULL;
+    PyObject* pyCallable = NULL;
+    PyObject* pyArgs = NULL;
+    PyObject* pyResult = NULL;
+    jobject jResult = NULL;
+    jsize i, argCount;
+
+    moduleNameChars = (*jenv)->GetStringUTFChars(jenv, jModuleName, NULL);
+    if (moduleNameChars == NULL) {
+        PyLib_ThrowOOM(jenv);
+        return NULL;
+    }
+    functionNameChars = (*jenv)->GetStringUTFChars(jenv, jFunctionName, NULL);
+    if (functionNameChars == NULL) {
+        (*jenv)->ReleaseStringUTFChars(jenv, jModuleName, moduleNameChars);
+        PyLib_ThrowOOM(jenv);
+        return NULL;
+    }
+    argCount = jArgs != NULL ? (*jenv)->GetArrayLength(jenv, jArgs) : 0;
+
+    PyEval_RestoreThread((PyThreadState*) threadState);
+    JPy_STAT_INC(JPy_STAT_GIL_ACQUISITIONS);
+
+    // Modules are imported only once per interpreter, later imports will find them in sys.modules
+    pyModule = PyImport_ImportModule(moduleNameChars);
+    if (pyModule == NULL) {
+        goto error;
+    }
+    pyCallable = PyObject_GetAttrString(pyModule, functionNameChars);
+    if (pyCallable == NULL) {
+        goto error;
+    }
+    pyArgs = PyTuple_New(argCount);
+    if (pyArgs == NULL) {
+        goto error;
+    }
+    for (i = 0; i < argCount; i++) {
+        jobject jArg;
+        PyObject* pyArg;
+        jArg = (*jenv)->GetObjectArrayElement(jenv, jArgs, i);
+        pyArg = PyLib_SubInterpreterFromJava(jenv, jArg);
+        (*jenv)->DeleteLocalRef(jenv, jArg);
+        if (pyArg == NULL) {
+            goto error;
+        }
+        PyTuple_SET_ITEM(pyArgs, i, pyArg);
+    }
+    pyResult = PyObject_Call(pyCallable, pyArgs, NULL);
+    if (pyResult == NULL) {
+        goto error;
+    }
+    if (PyLib_SubInterpreterToJava(jenv, pyResult, &jResult) < 0) {
+        goto error;
+    }
+    goto done;
+
+error:
+    if (!(*jenv)->ExceptionCheck(jenv)) {
+        PyLib_HandlePythonException(jenv);
+    }
+    PyErr_Clear();
+    jResult = NULL;
+
+done:
+    Py_XDECREF(pyResult);
+    Py_XDECREF(pyArgs);
+    Py_XDECREF(pyCallable);
+    Py_XDECREF(pyModule);
+
+    PyEval_SaveThread();
+
+    (*jenv)->ReleaseStringUTFChars(jenv, jFunctionName, functionNameChars);
+    (*jenv)->ReleaseStringUTFChars(jenv, jModuleName, moduleNameChars);
+
+    return jResult;
+#else
+    PyLib_ThrowUOE(jenv, "Python sub-interpreters with their own GIL require Python 3.12 or higher");
+    return NULL;
+#endif
+}
+
+/*
+ * Class:     org_jpy_python_PyLib
+ * Method:    getDiagFlags
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_org_jpy_PyLib_00024Diag_getFlags
+  (JNIEnv *jenv, jclass classRef)
+{
+    return JPy_DiagFlags;
+}
+
+/*
+ * Class:     org_jpy_python_PyLib
+ * Method:    setDiagFlags
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_setFlags
+  (JNIEnv *jenv, jclass classRef, jint flags)
+{
+    JPy_DiagFlags = flags;
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    getStats
+ * Signature: ()[J
+ */
+JNIEXPORT jlongArray JNICALL Java_org_jpy_PyLib_00024Diag_getStats
+  (JNIEnv *jenv, jclass classRef)
+{
+    long long stats[JPy_STAT_COUNT];
+    jlong jStats[JPy_STAT_COUNT];
+    jlongArray jStatsArray;
+    int i;
+
+    JPy_GetStats(stats);
+    for (i = 0; i < JPy_STAT_COUNT; i++) {
+        jStats[i] = (jlong) stats[i];
+    }
+
+    jStatsArray = (*jenv)->NewLongArray(jenv, JPy_STAT_COUNT);
+    if (jStatsArray == NULL) {
+        return NULL;
+    }
+    (*jenv)->SetLongArrayRegion(jenv, jStatsArray, 0, JPy_STAT_COUNT, jStats);
+    return jStatsArray;
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    isProfiling
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_jpy_PyLib_00024Diag_isProfiling
+  (JNIEnv *jenv, jclass classRef)
+{
+    return JPy_ProfilingEnabled ? JNI_TRUE : JNI_FALSE;
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    setProfiling
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_setProfiling
+  (JNIEnv *jenv, jclass classRef, jboolean enabled)
+{
+    JPy_ProfilingEnabled = enabled ? 1 : 0;
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    resetProfile
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_resetProfile
+  (JNIEnv *jenv, jclass classRef)
+{
+    if (!Py_IsInitialized()) {
+        return;
+    }
+
+    JPy_BEGIN_GIL_STATE
+
+    JPy_ResetProfiles();
+
+    JPy_END_GIL_STATE
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    getProfileReport
+ * Signature: (I)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_org_jpy_PyLib_00024Diag_getProfileReport
+  (JNIEnv *jenv, jclass classRef, jint n)
+{
+    char* text;
+    jstring jText = NULL;
+
+    if (!Py_IsInitialized()) {
+        PyLib_ThrowUOE(jenv, "Python interpreter not initialized");
+        return NULL;
+    }
+
+    JPy_BEGIN_GIL_STATE
+
+    text = JPy_FormatProfileReport(n);
+    if (text == NULL) {
+        PyLib_HandlePythonException(jenv);
+    } else {
+        jText = (*jenv)->NewStringUTF(jenv, text);
+        PyMem_Free(text);
+    }
+
+    JPy_END_GIL_STATE
+
+    return jText;
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    isTracing
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_jpy_PyLib_00024Diag_isTracing
+  (JNIEnv *jenv, jclass classRef)
+{
+    return JPy_TraceEnabled ? JNI_TRUE : JNI_FALSE;
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    setTracing
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_setTracing
+  (JNIEnv *jenv, jclass classRef, jboolean enabled)
+{
+    JPy_SetTracing(enabled ? 1 : 0);
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    clearTrace
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_clearTrace
+  (JNIEnv *jenv, jclass classRef)
+{
+    JPy_TraceClear();
+}
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    dumpTrace
+ * Signature: (Ljava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_00024Diag_dumpTrace
+  (JNIEnv *jenv, jclass classRef, jstring jPath)
+{
+    const char* pathChars;
+    long long count = -1;
+
+    if (!Py_IsInitialized()) {
+        PyLib_ThrowUOE(jenv, "Python interpreter not initialized");
+        return -1;
+    }
+
+    pathChars = (*jenv)->GetStringUTFChars(jenv, jPath, NULL);
+    if (pathChars == NULL) {
+        PyLib_ThrowOOM(jenv);
+        return -1;
+    }
+
+    JPy_BEGIN_GIL_STATE
+
+    count = JPy_TraceDump(pathChars);
+    if (count < 0) {
+        PyLib_HandlePythonException(jenv);
+    }
+
+    JPy_END_GIL_STATE
+
+    (*jenv)->ReleaseStringUTFChars(jenv, jPath, pathChars);
+    return (jlong) count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+// Helpers that also throw Java exceptions
+
+
+PyObject* PyLib_GetAttributeObject(JNIEnv* jenv, PyObject* pyObject, jstring jName)
+{
+    PyObject* pyValue = NULL;
+    const char* nameChars;
+
+    nameChars = (*jenv)->GetStringUTFChars(jenv, jName, NULL);
+    if (nameChars == NULL) {
+        PyLib_ThrowOOM(jenv);
+        goto error;
+    }
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "PyLib_GetAttributeObject: objId=%p, name='%s'\n", pyObject, nameChars);
+    /* Note: pyValue is a new reference */
+    pyValue = PyObject_GetAttrString(pyObject, nameChars);
+    if (pyValue == NULL) {
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_GetAttributeObject: error: attribute not found '%s'\n", nameChars);
+        PyLib_HandlePythonException(jenv);
+    }
+error:
+    if (nameChars != NULL) {
+        (*jenv)->ReleaseStringUTFChars(jenv, jName, nameChars);
+    }
+    return pyValue;
+}
+
+/**
+ * Writes the display name of the attribute with the given name of the given Python object into the given buffer.
+ * Names are of the form "<module>.<name>" for module-level callables and "<type>.<name>" otherwise.
+ */
+static void PyLib_GetCallableName(PyObject* pyObject, const char* nameChars, char* buffer, size_t bufferSize)
+{
+    const char* ownerName = NULL;
+
+    if (PyModule_Check(pyObject)) {
+        ownerName = PyModule_GetName(pyObject);
+        if (ownerName == NULL) {
+            PyErr_Clear();
+        }
+    }
+    if (ownerName == NULL) {
+        ownerName = Py_TYPE(pyObject)->tp_name;
+    }
+
+    PyOS_snprintf(buffer, bufferSize, "%s.%s", ownerName, nameChars);
+}
+
+/**
+ * Returns the latency profile for calls of the attribute with the given name of the given Python object.
+ */
+static JPy_CallProfile* PyLib_GetCallProfile(PyObject* pyObject, const char* nameChars)
+{
+    char profileName[512];
+
+    PyLib_GetCallableName(pyObject, nameChars, profileName, sizeof (profileName));
+    return JPy_GetCallProfile(JPy_PROF_KIND_PYTHON, profileName);
+}
+
+PyObject* PyLib_CallAndReturnObject(JNIEnv *jenv, PyObject* pyObject, jboolean isMethodCall, jstring jName, jint argCount, jobjectArray jArgs, jobjectArray jParamClasses, PyLib_CallSample* sample)
+{
+    PyObject* pyCallable = NULL;
+    PyObject* pyArgs = NULL;
+    PyObject* pyArg;
+    PyObject* pyReturnValue = Py_None;
+    const char* nameChars;
+    jint i;
+    jobject jArg;
+    jclass jParamClass;
+    JPy_JType* paramType;
+    long long traceStart;
+
+    pyReturnValue = NULL;
+    sample->profile = NULL;
+    traceStart = JPy_TRACE_BEGIN();
+
+    nameChars = (*jenv)->GetStringUTFChars(jenv, jName, NULL);
+    if (nameChars == NULL) {
+        PyLib_ThrowOOM(jenv);
+        goto error;
+    }
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "PyLib_CallAndReturnObject: objId=%p, isMethodCall=%d, name='%s', argCount=%d\n", pyObject, isMethodCall, nameChars, argCount);
+
+    pyArgs = NULL;
+
+    // Note: pyCallable is a new reference
+    pyCallable = PyObject_GetAttrString(pyObject, nameChars);
+    if (pyCallable == NULL) {
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: function or method not found: '%s'\n", nameChars);
+        PyLib_HandlePythonException(jenv);
+        goto error;
+    }
+
+    if (!PyCallable_Check(pyCallable)) {
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: object is not callable: '%s'\n", nameChars);
+        PyLib_HandlePythonException(jenv);
+        goto error;
+    }
+
+    if (JPy_ProfilingEnabled) {
+        sample->profile = PyLib_GetCallProfile(pyObject, nameChars);
+        if (sample->profile == NULL) {
+            PyLib_HandlePythonException(jenv);
+            goto error;
+        }
+        sample->t0 = JPy_GetNanos();
+    }
+
+    pyArgs = PyTuple_New(argCount);
+    for (i = 0; i < argCount; i++) {
+        jArg = (*jenv)->GetObjectArrayElement(jenv, jArgs, i);
+
+        if (jParamClasses != NULL) {
+            jParamClass = (*jenv)->GetObjectArrayElement(jenv, jParamClasses, i);
+        } else {
+            jParamClass = NULL;
+        }
+
+        if (jParamClass != NULL) {
+            paramType = JType_GetType(jenv, jParamClass, JNI_FALSE);
+            if (paramType == NULL) {
+                JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: callable '%s': argument %d: failed to retrieve type\n", nameChars, i);
+                PyLib_HandlePythonException(jenv);
+                goto error;
+            }
+            pyArg = JPy_FromJObjectWithType(jenv, jArg, paramType);
+
+            // We must keep unchanged the reference counter when calling a Python method
+            // with a complex Python object as parameter. 
+            // Per example:
+            // PyObject dt_X = kycProcessor.getDataFrame(inputColumns.toArray(new String[0]));
+            // for (DataFrameColumn column : values) {
+            //    kycProcessor.addColumn(dt_X, column.getName(), column.getValues());
+            // }
+            if (paramType == JPy_JPyObject && paramType->componentType == NULL) {
+                Py_INCREF(pyArg);
+            } 
+
+            (*jenv)->DeleteLocalRef(jenv, jParamClass);
+        } else {
+            pyArg = JPy_FromJObject(jenv, jArg);
+        }
+
+        (*jenv)->DeleteLocalRef(jenv, jArg);
+
+        if (pyArg == NULL) {
+            JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: callable '%s': argument %d: failed to convert Java into Python object\n", nameChars, i);
+            PyLib_HandlePythonException(jenv);
+            goto error;
+        }
+
+        // pyArg reference stolen here
+        PyTuple_SetItem(pyArgs, i, pyArg);
+    }
+
+    // Check why: for some reason, we don't need the following code to invoke object methods.
     /*
     if (isMethodCall) {
         PyObject* pyMethod;
@@ -1887,7 +3013,16 @@ PyObject* PyLib_CallAndReturnObject(JNIEnv *jenv, PyObject* pyObject, jboolean i
     }
     */
 
+    if (sample->profile != NULL) {
+        sample->t1 = JPy_GetNanos();
+    }
+
     pyReturnValue = PyObject_CallObject(pyCallable, argCount > 0 ? pyArgs : NULL);
+
+    if (sample->profile != NULL) {
+        sample->t2 = JPy_GetNanos();
+    }
+
     if (pyReturnValue == NULL) {
         JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallAndReturnObject: error: callable '%s': call returned NULL\n", nameChars);
         PyLib_HandlePythonException(jenv);
@@ -1897,6 +3032,11 @@ PyObject* PyLib_CallAndReturnObject(JNIEnv *jenv, PyObject* pyObject, jboolean i
     Py_INCREF(pyReturnValue);
 
 error:
+    if (traceStart != 0 && nameChars != NULL) {
+        char traceName[512];
+        PyLib_GetCallableName(pyObject, nameChars, traceName, sizeof (traceName));
+        JPy_TRACE_END(traceStart, JPy_TRACE_PYTHON_CALL, JPy_TraceInternName(traceName), argCount);
+    }
     if (nameChars != NULL) {
         (*jenv)->ReleaseStringUTFChars(jenv, jName, nameChars);
     }
@@ -1906,6 +3046,378 @@ error:
     return pyReturnValue;
 }
 
+PyLib_CallHandle* PyLib_NewCallHandle(JNIEnv* jenv, PyObject* pyObject, jstring jName, jobjectArray jParamClasses)
+{
+    PyLib_CallHandle* handle;
+    const char* nameChars;
+    jclass jParamClass;
+    int i;
+
+    handle = PyMem_New(PyLib_CallHandle, 1);
+    if (handle == NULL) {
+        PyLib_ThrowOOM(jenv);
+        return NULL;
+    }
+    memset(handle, 0, sizeof (PyLib_CallHandle));
+
+    Py_INCREF(pyObject);
+    handle->pyObject = pyObject;
+
+    nameChars = (*jenv)->GetStringUTFChars(jenv, jName, NULL);
+    if (nameChars == NULL) {
+        PyLib_ThrowOOM(jenv);
+        goto error;
+    }
+    handle->nameChars = PyMem_New(char, strlen(nameChars) + 1);
+    if (handle->nameChars != NULL) {
+        strcpy(handle->nameChars, nameChars);
+    }
+    (*jenv)->ReleaseStringUTFChars(jenv, jName, nameChars);
+    if (handle->nameChars == NULL) {
+        PyLib_ThrowOOM(jenv);
+        goto error;
+    }
+
+    handle->pyName = JPy_FROM_CSTR(handle->nameChars);
+    if (handle->pyName == NULL) {
+        PyLib_HandlePythonException(jenv);
+        goto error;
+    }
+#if defined(JPY_COMPAT_33P)
+    PyUnicode_InternInPlace(&handle->pyName);
+#elif defined(JPY_COMPAT_27)
+    PyString_InternInPlace(&handle->pyName);
+#endif
+
+    handle->paramCount = jParamClasses != NULL ? (*jenv)->GetArrayLength(jenv, jParamClasses) : 0;
+    if (handle->paramCount > 0) {
+        handle->paramTypes = PyMem_New(JPy_JType*, handle->paramCount);
+        if (handle->paramTypes == NULL) {
+            PyLib_ThrowOOM(jenv);
+            goto error;
+        }
+        memset(handle->paramTypes, 0, handle->paramCount * sizeof (JPy_JType*));
+        for (i = 0; i < handle->paramCount; i++) {
+            jParamClass = (*jenv)->GetObjectArrayElement(jenv, jParamClasses, i);
+            handle->paramTypes[i] = JType_GetType(jenv, jParamClass, JNI_FALSE);
+            (*jenv)->DeleteLocalRef(jenv, jParamClass);
+            if (handle->paramTypes[i] == NULL) {
+                JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_NewCallHandle: error: callable '%s': parameter %d: failed to retrieve type\n", handle->nameChars, i);
+                PyLib_HandlePythonException(jenv);
+                goto error;
+            }
+            Py_INCREF(handle->paramTypes[i]);
+        }
+    }
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "PyLib_NewCallHandle: handle=%p, objId=%p, name='%s', paramCount=%d\n", handle, pyObject, handle->nameChars, handle->paramCount);
+
+    return handle;
+
+error:
+    PyLib_FreeCallHandle(handle);
+    return NULL;
+}
+
+void PyLib_FreeCallHandle(PyLib_CallHandle* handle)
+{
+    int i;
+
+    if (handle == NULL) {
+        return;
+    }
+    if (handle->paramTypes != NULL) {
+        for (i = 0; i < handle->paramCount; i++) {
+            Py_XDECREF(handle->paramTypes[i]);
+        }
+        PyMem_Del(handle->paramTypes);
+    }
+    Py_XDECREF(handle->pyCallable);
+    Py_XDECREF(handle->pyType);
+    Py_XDECREF(handle->pyName);
+    Py_XDECREF(handle->pyObject);
+    PyMem_Del(handle->nameChars);
+    PyMem_Del(handle);
+}
+
+/**
+ * Returns the value of the attribute with the given name found in the dictionary of the given object,
+ * i.e. in the module's namespace or in the instance's __dict__. Returns a new reference or NULL.
+ * Only public API is used, so that free-threaded builds look up the instance's __dict__ safely.
+ */
+static PyObject* PyLib_GetInstanceDictValue(PyObject* pyObject, PyObject* pyName)
+{
+    PyTypeObject* type = Py_TYPE(pyObject);
+    PyObject* pyDict;
+    PyObject* pyValue;
+    int hasDict;
+
+    if (PyModule_Check(pyObject)) {
+        return JPy_GetDictItem(PyModule_GetDict(pyObject), pyName);
+    }
+
+    hasDict = type->tp_dictoffset != 0;
+#ifdef Py_TPFLAGS_MANAGED_DICT
+    hasDict = hasDict || PyType_HasFeature(type, Py_TPFLAGS_MANAGED_DICT);
+#endif
+    if (!hasDict) {
+        return NULL;
+    }
+#if defined(JPY_COMPAT_33P)
+    pyDict = PyObject_GenericGetDict(pyObject, NULL);
+    if (pyDict == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+#else
+    pyDict = *_PyObject_GetDictPtr(pyObject);
+    if (pyDict == NULL) {
+        return NULL;
+    }
+    Py_INCREF(pyDict);
+#endif
+    pyValue = PyDict_Check(pyDict) ? JPy_GetDictItem(pyDict, pyName) : NULL;
+    Py_DECREF(pyDict);
+    return pyValue;
+}
+
+/**
+ * Returns non-zero if the value of the attribute with the given name, looked up by PyObject_GenericGetAttr, only
+ * changes if the type or the instance's __dict__ is modified. 'fromInstanceDict' tells whether the value has been
+ * found in the instance's __dict__.
+ */
+static int PyLib_IsCacheableTypeAttr(PyTypeObject* type, PyObject* pyName, int fromInstanceDict)
+{
+    PyObject* pyTypeValue;
+    int cacheable;
+
+    pyTypeValue = JPy_LookupTypeAttr(type, pyName);
+    if (pyTypeValue == NULL) {
+        cacheable = fromInstanceDict;
+    } else {
+        cacheable = PyFunction_Check(pyTypeValue) || Py_TYPE(pyTypeValue) == &PyMethodDescr_Type;
+        Py_DECREF(pyTypeValue);
+    }
+    return cacheable;
+}
+
+/**
+ * Returns the callable of the given call handle (a new reference), or NULL if the attribute lookup failed.
+ *
+ * The callable is cached as long as the attribute is not rebound. For a module, this is the case while its
+ * namespace maps the name to the same object. For other objects using the generic attribute lookup, it is the
+ * case while the object's type and its version tag (changed by CPython whenever an attribute of the type or of one
+ * of its base types is set or deleted) are the same, and while the instance's __dict__ maps the name to
+ * the same object, or still doesn't contain it. The type's attribute must however be a plain function or method
+ * descriptor, or missing if the callable is found in the instance's __dict__, because other descriptors such as
+ * properties may return a different object on every access. For all other objects, the attribute is looked up
+ * on every call.
+ */
+static PyObject* PyLib_GetHandleCallable(PyLib_CallHandle* handle)
+{
+    PyObject* pyObject = handle->pyObject;
+    PyTypeObject* type = Py_TYPE(pyObject);
+    PyObject* pyCallable;
+    PyObject* pyDictValue;
+    int typeValid;
+
+    typeValid = type->tp_getattro == PyObject_GenericGetAttr
+                && PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)
+                && type->tp_version_tag != 0;
+
+    if (handle->pyCallable != NULL) {
+        pyDictValue = PyLib_GetInstanceDictValue(pyObject, handle->pyName);
+        // Only the identity of the value is compared
+        Py_XDECREF(pyDictValue);
+        if (handle->pyType == NULL) {
+            if (pyDictValue == handle->pyCallable) {
+                Py_INCREF(handle->pyCallable);
+                return handle->pyCallable;
+            }
+        } else if (typeValid
+                   && type == handle->pyType
+                   && type->tp_version_tag == handle->typeVersion
+                   && pyDictValue == (handle->fromInstanceDict ? handle->pyCallable : NULL)) {
+            Py_INCREF(handle->pyCallable);
+            return handle->pyCallable;
+        }
+        JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "PyLib_GetHandleCallable: attribute '%s' has been rebound\n", handle->nameChars);
+        Py_CLEAR(handle->pyCallable);
+        Py_CLEAR(handle->pyType);
+    }
+
+    // Note: pyCallable is a new reference
+    pyCallable = PyObject_GetAttr(pyObject, handle->pyName);
+    if (pyCallable == NULL) {
+        return NULL;
+    }
+
+    // The lookup may have assigned a new version tag
+    typeValid = type->tp_getattro == PyObject_GenericGetAttr
+                && PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)
+                && type->tp_version_tag != 0;
+
+    pyDictValue = PyLib_GetInstanceDictValue(pyObject, handle->pyName);
+    // Only the identity of the value is compared, pyCallable keeps it alive
+    Py_XDECREF(pyDictValue);
+    if (PyModule_Check(pyObject)) {
+        if (pyDictValue == pyCallable) {
+            Py_INCREF(pyCallable);
+            handle->pyCallable = pyCallable;
+        }
+    } else if (typeValid && PyLib_IsCacheableTypeAttr(type, handle->pyName, pyDictValue == pyCallable)) {
+        Py_INCREF(pyCallable);
+        handle->pyCallable = pyCallable;
+        Py_INCREF(type);
+        handle->pyType = type;
+        handle->typeVersion = type->tp_version_tag;
+        handle->fromInstanceDict = pyDictValue == pyCallable;
+    }
+
+    return pyCallable;
+}
+
+/**
+ * Calls the callable of the given handle and returns the resulting Python object (a new reference),
+ * or NULL if a Java exception has been thrown.
+ */
+PyObject* PyLib_CallHandleAndReturnObject(JNIEnv* jenv, PyLib_CallHandle* handle, jobjectArray jArgs, PyLib_CallSample* sample)
+{
+    PyObject* pyCallable;
+    PyObject* pyArgs = NULL;
+    PyObject* pyArg;
+    PyObject* pyReturnValue = NULL;
+    JPy_JType* paramType;
+    jobject jArg;
+    int i;
+    long long traceStart;
+
+    sample->profile = NULL;
+    traceStart = JPy_TRACE_BEGIN();
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_EXEC, "PyLib_CallHandleAndReturnObject: objId=%p, name='%s', argCount=%d\n", handle->pyObject, handle->nameChars, handle->paramCount);
+
+    // Note: pyCallable is a new reference
+    // Without a GIL, other threads may call the same handle and update its cached callable concurrently
+    JPy_BEGIN_CRITICAL_SECTION(handle->pyObject)
+    pyCallable = PyLib_GetHandleCallable(handle);
+    JPy_END_CRITICAL_SECTION
+    if (pyCallable == NULL) {
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallHandleAndReturnObject: error: function or method not found: '%s'\n", handle->nameChars);
+        PyLib_HandlePythonException(jenv);
+        goto error;
+    }
+
+    if (!PyCallable_Check(pyCallable)) {
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallHandleAndReturnObject: error: object is not callable: '%s'\n", handle->nameChars);
+        PyErr_Format(PyExc_TypeError, "attribute '%s' of '%s' object is not callable", handle->nameChars, Py_TYPE(handle->pyObject)->tp_name);
+        PyLib_HandlePythonException(jenv);
+        goto error;
+    }
+
+    if (JPy_ProfilingEnabled) {
+        if (handle->profile == NULL) {
+            handle->profile = PyLib_GetCallProfile(handle->pyObject, handle->nameChars);
+            if (handle->profile == NULL) {
+                PyLib_HandlePythonException(jenv);
+                goto error;
+            }
+        }
+        sample->profile = handle->profile;
+        sample->t0 = JPy_GetNanos();
+    }
+
+    pyArgs = PyTuple_New(handle->paramCount);
+    if (pyArgs == NULL) {
+        PyLib_HandlePythonException(jenv);
+        goto error;
+    }
+
+    for (i = 0; i < handle->paramCount; i++) {
+        paramType = handle->paramTypes[i];
+        jArg = (*jenv)->GetObjectArrayElement(jenv, jArgs, i);
+        pyArg = JPy_FromJObjectWithType(jenv, jArg, paramType);
+        (*jenv)->DeleteLocalRef(jenv, jArg);
+
+        if (pyArg == NULL) {
+            JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallHandleAndReturnObject: error: callable '%s': argument %d: failed to convert Java into Python object\n", handle->nameChars, i);
+            PyLib_HandlePythonException(jenv);
+            goto error;
+        }
+
+        // Same as in PyLib_CallAndReturnObject(): a PyObject argument is passed as borrowed reference
+        if (paramType == JPy_JPyObject && paramType->componentType == NULL) {
+            Py_INCREF(pyArg);
+        }
+
+        // pyArg reference stolen here
+        PyTuple_SET_ITEM(pyArgs, i, pyArg);
+    }
+
+    if (sample->profile != NULL) {
+        sample->t1 = JPy_GetNanos();
+    }
+
+    pyReturnValue = PyObject_CallObject(pyCallable, handle->paramCount > 0 ? pyArgs : NULL);
+
+    if (sample->profile != NULL) {
+        sample->t2 = JPy_GetNanos();
+    }
+
+    if (pyReturnValue == NULL) {
+        JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "PyLib_CallHandleAndReturnObject: error: callable '%s': call returned NULL\n", handle->nameChars);
+        PyLib_HandlePythonException(jenv);
+        goto error;
+    }
+
+error:
+    if (traceStart != 0) {
+        if (handle->traceName == NULL) {
+            char traceName[512];
+            PyLib_GetCallableName(handle->pyObject, handle->nameChars, traceName, sizeof (traceName));
+            handle->traceName = JPy_TraceInternName(traceName);
+        }
+        JPy_TRACE_END(traceStart, JPy_TRACE_PYTHON_CALL, handle->traceName, handle->paramCount);
+    }
+    Py_XDECREF(pyCallable);
+    Py_XDECREF(pyArgs);
+
+    return pyReturnValue;
+}
+
+/**
+ * Sets a Python TypeError if pyReturnValue is None, which cannot be returned as a Java primitive value.
+ * Returns 0 if the value can be converted, -1 otherwise.
+ */
+int PyLib_CheckPrimitiveReturnValue(PyObject* pyReturnValue, const char* typeName)
+{
+    if (pyReturnValue == Py_None) {
+        PyErr_Format(PyExc_TypeError, "cannot convert a Python 'NoneType' to a Java '%s'", typeName);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Completes a call made by PyLib_CallHandleAndReturnObject() after its return value has been converted:
+ * throws a Java exception if the conversion failed, records the call's latency profile otherwise.
+ * Releases the return value. Returns 0 on success, -1 if a Java exception has been thrown.
+ */
+int PyLib_EndHandleCall(JNIEnv* jenv, PyObject* pyReturnValue, PyLib_CallSample* sample)
+{
+    int result = 0;
+
+    if (PyErr_Occurred()) {
+        PyLib_HandlePythonException(jenv);
+        result = -1;
+    } else if (sample->profile != NULL) {
+        JPy_RecordCall(sample->profile, sample->t0, sample->t1, sample->t2, JPy_GetNanos());
+    }
+    Py_DECREF(pyReturnValue);
+
+    return result;
+}
+
 #if defined(JPY_COMPAT_33P)
 
 char* PyLib_ObjToChars(PyObject* pyObj, PyObject** pyNewRef)
@@ -1975,6 +3487,9 @@ void PyLib_HandlePythonException(JNIEnv* jenv)
         return;
     }
 
+    JPy_STAT_INC(JPy_STAT_PYTHON_EXCEPTIONS);
+    JPy_TRACE_EVENT(JPy_TRACE_PYTHON_EXCEPTION, NULL, 0);
+
     PyErr_Fetch(&pyType, &pyValue, &pyTraceback);
     //printf("M1: pyType=%p, pyValue=%p, pyTraceback=%p\n", pyType, pyValue, pyTraceback);
     //printf("U1: pyType=%s, pyValue=%s, pyTraceback=%s\n", Py_TYPE(pyType)->tp_name, Py_TYPE(pyValue)->tp_name, pyTraceback != NULL ? Py_TYPE(pyTraceback)->tp_name : "?");
@@ -263,6 +263,14 @@ JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_newDict
 JNIEXPORT jobjectArray JNICALL Java_org_jpy_PyLib_getObjectArrayValue
   (JNIEnv *, jclass, jlong, jclass);
 
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    toJava
+ * Signature: (JLjava/lang/Class;)Ljava/lang/Object;
+ */
+JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_toJava
+  (JNIEnv *, jclass, jlong, jclass);
+
 /*
  * Class:     org_jpy_PyLib
  * Method:    importModule
@@ -327,6 +335,134 @@ JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_callAndReturnObject
 JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_callAndReturnValue
   (JNIEnv *, jclass, jlong, jboolean, jstring, jint, jobjectArray, jobjectArray, jclass);
 
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    newCallHandle
+ * Signature: (JLjava/lang/String;[Ljava/lang/Class;)J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_newCallHandle
+  (JNIEnv *, jclass, jlong, jstring, jobjectArray);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    releaseCallHandle
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_releaseCallHandle
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandle
+ * Signature: (J[Ljava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_callHandle
+  (JNIEnv *, jclass, jlong, jobjectArray);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnBoolean
+ * Signature: (J[Ljava/lang/Object;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_jpy_PyLib_callHandleAndReturnBoolean
+  (JNIEnv *, jclass, jlong, jobjectArray);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnInt
+ * Signature: (J[Ljava/lang/Object;)I
+ */
+JNIEXPORT jint JNICALL Java_org_jpy_PyLib_callHandleAndReturnInt
+  (JNIEnv *, jclass, jlong, jobjectArray);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnLong
+ * Signature: (J[Ljava/lang/Object;)J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_callHandleAndReturnLong
+  (JNIEnv *, jclass, jlong, jobjectArray);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnDouble
+ * Signature: (J[Ljava/lang/Object;)D
+ */
+JNIEXPORT jdouble JNICALL Java_org_jpy_PyLib_callHandleAndReturnDouble
+  (JNIEnv *, jclass, jlong, jobjectArray);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callHandleAndReturnValue
+ * Signature: (J[Ljava/lang/Object;Ljava/lang/Class;)Ljava/lang/Object;
+ */
+JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_callHandleAndReturnValue
+  (JNIEnv *, jclass, jlong, jobjectArray, jclass);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    attachThread
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_attachThread
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    detachThread
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_detachThread
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    acquireGIL
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_acquireGIL
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    releaseGIL
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_releaseGIL
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    newSubInterpreter
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_newSubInterpreter
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    endSubInterpreter
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_endSubInterpreter
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    execInSubInterpreter
+ * Signature: (JLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_execInSubInterpreter
+  (JNIEnv *, jclass, jlong, jstring);
+
+/*
+ * Class:     org_jpy_PyLib
+ * Method:    callInSubInterpreter
+ * Signature: (JLjava/lang/String;Ljava/lang/String;[Ljava/lang/Object;)Ljava/lang/Object;
+ */
+JNIEXPORT jobject JNICALL Java_org_jpy_PyLib_callInSubInterpreter
+  (JNIEnv *, jclass, jlong, jstring, jstring, jobjectArray);
+
 #ifdef __cplusplus
 }
 #endif
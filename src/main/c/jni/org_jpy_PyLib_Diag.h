@@ -23,6 +23,32 @@ extern "C" {
 #define org_jpy_PyLib_Diag_F_ERR 32L
 #undef org_jpy_PyLib_Diag_F_ALL
 #define org_jpy_PyLib_Diag_F_ALL 255L
+#undef org_jpy_PyLib_Diag_STAT_JAVA_CALLS
+#define org_jpy_PyLib_Diag_STAT_JAVA_CALLS 0L
+#undef org_jpy_PyLib_Diag_STAT_OVERLOAD_RESOLUTIONS
+#define org_jpy_PyLib_Diag_STAT_OVERLOAD_RESOLUTIONS 1L
+#undef org_jpy_PyLib_Diag_STAT_OVERLOAD_CACHE_MISSES
+#define org_jpy_PyLib_Diag_STAT_OVERLOAD_CACHE_MISSES 2L
+#undef org_jpy_PyLib_Diag_STAT_TYPES_RESOLVED
+#define org_jpy_PyLib_Diag_STAT_TYPES_RESOLVED 3L
+#undef org_jpy_PyLib_Diag_STAT_GLOBAL_REFS_CREATED
+#define org_jpy_PyLib_Diag_STAT_GLOBAL_REFS_CREATED 4L
+#undef org_jpy_PyLib_Diag_STAT_GLOBAL_REFS_DELETED
+#define org_jpy_PyLib_Diag_STAT_GLOBAL_REFS_DELETED 5L
+#undef org_jpy_PyLib_Diag_STAT_GIL_ACQUISITIONS
+#define org_jpy_PyLib_Diag_STAT_GIL_ACQUISITIONS 6L
+#undef org_jpy_PyLib_Diag_STAT_BUFFER_EXPORTS
+#define org_jpy_PyLib_Diag_STAT_BUFFER_EXPORTS 7L
+#undef org_jpy_PyLib_Diag_STAT_BUFFER_BYTES_COPIED
+#define org_jpy_PyLib_Diag_STAT_BUFFER_BYTES_COPIED 8L
+#undef org_jpy_PyLib_Diag_STAT_JAVA_EXCEPTIONS
+#define org_jpy_PyLib_Diag_STAT_JAVA_EXCEPTIONS 9L
+#undef org_jpy_PyLib_Diag_STAT_PYTHON_EXCEPTIONS
+#define org_jpy_PyLib_Diag_STAT_PYTHON_EXCEPTIONS 10L
+#undef org_jpy_PyLib_Diag_STAT_BUFFER_ACQUISITIONS
+#define org_jpy_PyLib_Diag_STAT_BUFFER_ACQUISITIONS 11L
+#undef org_jpy_PyLib_Diag_STAT_COUNT
+#define org_jpy_PyLib_Diag_STAT_COUNT 12L
 /*
  * Class:     org_jpy_PyLib_Diag
  * Method:    getFlags
@@ -39,6 +65,78 @@ JNIEXPORT jint JNICALL Java_org_jpy_PyLib_00024Diag_getFlags
 JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_setFlags
   (JNIEnv *, jclass, jint);
 
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    getStats
+ * Signature: ()[J
+ */
+JNIEXPORT jlongArray JNICALL Java_org_jpy_PyLib_00024Diag_getStats
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    isProfiling
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_jpy_PyLib_00024Diag_isProfiling
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    setProfiling
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_setProfiling
+  (JNIEnv *, jclass, jboolean);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    resetProfile
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_resetProfile
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    getProfileReport
+ * Signature: (I)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_org_jpy_PyLib_00024Diag_getProfileReport
+  (JNIEnv *, jclass, jint);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    isTracing
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_jpy_PyLib_00024Diag_isTracing
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    setTracing
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_setTracing
+  (JNIEnv *, jclass, jboolean);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    clearTrace
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_org_jpy_PyLib_00024Diag_clearTrace
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_jpy_PyLib_Diag
+ * Method:    dumpTrace
+ * Signature: (Ljava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_org_jpy_PyLib_00024Diag_dumpTrace
+  (JNIEnv *, jclass, jstring);
+
 #ifdef __cplusplus
 }
 #endif
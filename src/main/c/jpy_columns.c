@@ -0,0 +1,514 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jpy_module.h"
+#include "jpy_diag.h"
+#include "jpy_jtype.h"
+#include "jpy_jfield.h"
+#include "jpy_jmethod.h"
+#include "jpy_conv.h"
+#include "jpy_columns.h"
+
+#include <ctype.h>
+
+
+/**
+ * A column being extracted: how to read its property from an element, and the values read so far.
+ */
+typedef struct JPy_Column
+{
+    // The type of the field or the getter's return type (borrowed reference).
+    JPy_JType* type;
+    // Either the field ID or the getter's method ID is set.
+    jfieldID fid;
+    jmethodID mid;
+    // The memoryview format of primitive types, NULL for all other types.
+    const char* format;
+    // A bytearray holding the items of primitive types, a list for all other types.
+    PyObject* values;
+    // The items of 'values' if it is a bytearray.
+    char* items;
+}
+JPy_Column;
+
+
+/**
+ * Looks up a public instance field of the given name in type and its super types.
+ * Returns 1 and sets column->fid if found, 0 if not, and -1 on error.
+ */
+static int JPy_FindColumnField(JNIEnv* jenv, JPy_JType* type, const char* name, JPy_Column* column)
+{
+    PyObject* value;
+    JPy_JField* field;
+
+    for (; type != NULL; type = type->superType) {
+        if (JType_ResolveType(jenv, type) < 0) {
+            return -1;
+        }
+        value = JPy_GetDictItemString(type->typeObj.tp_dict, name);
+        if (value == NULL) {
+            continue;
+        }
+        field = PyObject_TypeCheck(value, &JField_Type) ? (JPy_JField*) value : NULL;
+        if (field != NULL && !field->isStatic) {
+            column->type = field->type;
+            column->fid = field->fid;
+        }
+        Py_DECREF(value);
+        if (column->fid != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Looks up a public, non-static Java method of the given name taking no arguments and returning a value
+ * in type and its super types. Returns 1 and sets column->mid if found, 0 if not, and -1 on error.
+ */
+static int JPy_FindColumnGetter(JNIEnv* jenv, JPy_JType* type, const char* name, JPy_Column* column)
+{
+    PyObject* value;
+    PyObject* methodList;
+    JPy_JMethod* method;
+    Py_ssize_t i;
+
+    for (; type != NULL; type = type->superType) {
+        if (JType_ResolveType(jenv, type) < 0) {
+            return -1;
+        }
+        value = JPy_GetDictItemString(type->typeObj.tp_dict, name);
+        if (value == NULL) {
+            continue;
+        }
+        if (PyObject_TypeCheck(value, &JOverloadedMethod_Type)) {
+            methodList = ((JPy_JOverloadedMethod*) value)->methodList;
+            JPy_BEGIN_CRITICAL_SECTION(methodList)
+            for (i = 0; i < PyList_GET_SIZE(methodList); i++) {
+                method = (JPy_JMethod*) PyList_GET_ITEM(methodList, i);
+                if (method->paramCount == 0 && !method->isStatic
+                    && method->returnDescriptor != NULL && method->returnDescriptor->type != JPy_JVoid) {
+                    column->type = method->returnDescriptor->type;
+                    column->mid = method->mid;
+                    break;
+                }
+            }
+            JPy_END_CRITICAL_SECTION
+        }
+        Py_DECREF(value);
+        if (column->mid != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Resolves the property pyName of type into the field or getter read by column.
+ * Fields are preferred, followed by the getters 'getName()', 'isName()' and 'name()', the latter used by records.
+ */
+static int JPy_ResolveColumn(JNIEnv* jenv, JPy_JType* type, PyObject* pyName, JPy_Column* column)
+{
+    const char* name;
+    char* getterName;
+    int found;
+
+    if (!JPy_IS_STR(pyName)) {
+        PyErr_Format(PyExc_ValueError, "columns: property names must be strings, got a '%s'", Py_TYPE(pyName)->tp_name);
+        return -1;
+    }
+    name = JPy_AS_UTF8(pyName);
+    if (name == NULL) {
+        return -1;
+    }
+
+    found = JPy_FindColumnField(jenv, type, name, column);
+    if (found == 0) {
+        getterName = PyMem_New(char, strlen(name) + 4);
+        if (getterName == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        strcpy(getterName, "get");
+        strcat(getterName, name);
+        getterName[3] = (char) toupper((unsigned char) getterName[3]);
+        found = JPy_FindColumnGetter(jenv, type, getterName, column);
+        if (found == 0) {
+            strcpy(getterName, "is");
+            strcat(getterName, name);
+            getterName[2] = (char) toupper((unsigned char) getterName[2]);
+            found = JPy_FindColumnGetter(jenv, type, getterName, column);
+        }
+        if (found == 0) {
+            found = JPy_FindColumnGetter(jenv, type, name, column);
+        }
+        PyMem_Del(getterName);
+    }
+
+    if (found == 0) {
+        PyErr_Format(PyExc_AttributeError, "columns: Java type '%s' has no public field or getter for property '%s'", type->javaName, name);
+    }
+    return found > 0 ? 0 : -1;
+}
+
+static void JPy_FreeColumns(JPy_Column* columns, Py_ssize_t columnCount)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < columnCount; i++) {
+        Py_XDECREF(columns[i].values);
+    }
+    PyMem_Del(columns);
+}
+
+/**
+ * Creates the columns for the given property names and rowCount elements of type.
+ * If type is NULL, all columns are lists.
+ */
+static JPy_Column* JPy_NewColumns(JNIEnv* jenv, JPy_JType* type, PyObject* nameSeq, Py_ssize_t rowCount)
+{
+    JPy_Column* columns;
+    JPy_Column* column;
+    Py_ssize_t columnCount;
+    Py_ssize_t itemSize;
+    Py_ssize_t i;
+
+    columnCount = PySequence_Fast_GET_SIZE(nameSeq);
+    columns = PyMem_New(JPy_Column, columnCount > 0 ? columnCount : 1);
+    if (columns == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    memset(columns, 0, sizeof(JPy_Column) * columnCount);
+
+    for (i = 0; i < columnCount; i++) {
+        column = columns + i;
+        if (type != NULL && JPy_ResolveColumn(jenv, type, PySequence_Fast_GET_ITEM(nameSeq, i), column) < 0) {
+            JPy_FreeColumns(columns, columnCount);
+            return NULL;
+        }
+
+        itemSize = 0;
+        if (column->type == JPy_JBoolean) {
+            column->format = "?";
+            itemSize = sizeof(jboolean);
+        } else if (column->type == JPy_JChar) {
+            column->format = "H";
+            itemSize = sizeof(jchar);
+        } else if (column->type == JPy_JByte) {
+            column->format = "b";
+            itemSize = sizeof(jbyte);
+        } else if (column->type == JPy_JShort) {
+            column->format = "h";
+            itemSize = sizeof(jshort);
+        } else if (column->type == JPy_JInt) {
+            column->format = "i";
+            itemSize = sizeof(jint);
+        } else if (column->type == JPy_JLong) {
+            column->format = "q";
+            itemSize = sizeof(jlong);
+        } else if (column->type == JPy_JFloat) {
+            column->format = "f";
+            itemSize = sizeof(jfloat);
+        } else if (column->type == JPy_JDouble) {
+            column->format = "d";
+            itemSize = sizeof(jdouble);
+        }
+
+        if (column->format != NULL) {
+            column->values = PyByteArray_FromStringAndSize(NULL, rowCount * itemSize);
+        } else {
+            column->values = PyList_New(rowCount);
+        }
+        if (column->values == NULL) {
+            JPy_FreeColumns(columns, columnCount);
+            return NULL;
+        }
+        if (column->format != NULL) {
+            column->items = PyByteArray_AS_STRING(column->values);
+        }
+    }
+
+    return columns;
+}
+
+/**
+ * Reads the property of column from the given element and stores it in row.
+ */
+static int JPy_ReadColumnValue(JNIEnv* jenv, JPy_Column* column, jobject elementRef, Py_ssize_t row)
+{
+    JPy_JType* type;
+    jobject valueRef;
+    PyObject* pyValue;
+
+    type = column->type;
+
+#define JPy_READ_PRIMITIVE(J_TYPE, J_NAME) \
+    ((J_TYPE*) column->items)[row] = column->fid != NULL \
+        ? (*jenv)->Get##J_NAME##Field(jenv, elementRef, column->fid) \
+        : (*jenv)->Call##J_NAME##Method(jenv, elementRef, column->mid);
+
+    if (type == JPy_JBoolean) {
+        JPy_READ_PRIMITIVE(jboolean, Boolean)
+    } else if (type == JPy_JChar) {
+        JPy_READ_PRIMITIVE(jchar, Char)
+    } else if (type == JPy_JByte) {
+        JPy_READ_PRIMITIVE(jbyte, Byte)
+    } else if (type == JPy_JShort) {
+        JPy_READ_PRIMITIVE(jshort, Short)
+    } else if (type == JPy_JInt) {
+        JPy_READ_PRIMITIVE(jint, Int)
+    } else if (type == JPy_JLong) {
+        JPy_READ_PRIMITIVE(jlong, Long)
+    } else if (type == JPy_JFloat) {
+        JPy_READ_PRIMITIVE(jfloat, Float)
+    } else if (type == JPy_JDouble) {
+        JPy_READ_PRIMITIVE(jdouble, Double)
+    } else {
+        if (column->fid != NULL) {
+            valueRef = (*jenv)->GetObjectField(jenv, elementRef, column->fid);
+        } else {
+            valueRef = (*jenv)->CallObjectMethod(jenv, elementRef, column->mid);
+        }
+        JPy_ON_JAVA_EXCEPTION_RETURN(-1);
+        if (type == JPy_JString && valueRef != NULL) {
+            pyValue = JPy_FromJString(jenv, (jstring) valueRef);
+        } else {
+            // Convert boxed values of properties declared as Object, Number etc. as well
+            pyValue = JPy_FromJObjectDeep(jenv, valueRef, 0);
+        }
+        (*jenv)->DeleteLocalRef(jenv, valueRef);
+        if (pyValue == NULL) {
+            return -1;
+        }
+        PyList_SET_ITEM(column->values, row, pyValue);
+        return 0;
+    }
+
+#undef JPy_READ_PRIMITIVE
+
+    JPy_ON_JAVA_EXCEPTION_RETURN(-1);
+    return 0;
+}
+
+/**
+ * Reads the properties of the first rowCount elements of arrayRef into the rows starting at rowOffset.
+ */
+static int JPy_ReadColumnRows(JNIEnv* jenv, JPy_Column* columns, Py_ssize_t columnCount, JPy_JType* type,
+                              jobjectArray arrayRef, Py_ssize_t rowOffset, Py_ssize_t rowCount)
+{
+    jobject elementRef;
+    Py_ssize_t i;
+    Py_ssize_t j;
+
+    for (i = 0; i < rowCount; i++) {
+        elementRef = (*jenv)->GetObjectArrayElement(jenv, arrayRef, (jsize) i);
+        if (elementRef == NULL) {
+            PyErr_Format(PyExc_ValueError, "columns: element %zd is null", rowOffset + i);
+            return -1;
+        }
+        // Field and method IDs must only be used with instances of their class
+        if (!(*jenv)->IsInstanceOf(jenv, elementRef, type->classRef)) {
+            (*jenv)->DeleteLocalRef(jenv, elementRef);
+            PyErr_Format(PyExc_TypeError, "columns: element %zd is not an instance of '%s'", rowOffset + i, type->javaName);
+            return -1;
+        }
+        for (j = 0; j < columnCount; j++) {
+            if (JPy_ReadColumnValue(jenv, columns + j, elementRef, rowOffset + i) < 0) {
+                (*jenv)->DeleteLocalRef(jenv, elementRef);
+                return -1;
+            }
+        }
+        (*jenv)->DeleteLocalRef(jenv, elementRef);
+    }
+    return 0;
+}
+
+/**
+ * Reads the rows of a random access java.util.List chunk-wise, so that only the elements of the current chunk
+ * are referenced by the array fetched by subList(from, to).toArray().
+ */
+static int JPy_ReadColumnListRows(JNIEnv* jenv, JPy_Column* columns, Py_ssize_t columnCount, JPy_JType* type,
+                                  jobject listRef, Py_ssize_t rowCount)
+{
+    jobject subListRef;
+    jobjectArray chunkRef;
+    Py_ssize_t offset;
+    Py_ssize_t chunkSize;
+    int status;
+
+    for (offset = 0; offset < rowCount; offset += chunkSize) {
+        chunkSize = rowCount - offset < JPy_COLUMNS_CHUNK_SIZE ? rowCount - offset : JPy_COLUMNS_CHUNK_SIZE;
+        subListRef = (*jenv)->CallObjectMethod(jenv, listRef, JPy_List_SubList_MID, (jint) offset, (jint) (offset + chunkSize));
+        JPy_ON_JAVA_EXCEPTION_RETURN(-1);
+        chunkRef = (jobjectArray) (*jenv)->CallObjectMethod(jenv, subListRef, JPy_Collection_ToArray_MID);
+        (*jenv)->DeleteLocalRef(jenv, subListRef);
+        JPy_ON_JAVA_EXCEPTION_RETURN(-1);
+        if ((*jenv)->GetArrayLength(jenv, chunkRef) != chunkSize) {
+            (*jenv)->DeleteLocalRef(jenv, chunkRef);
+            PyErr_SetString(PyExc_RuntimeError, "columns: the list has been modified while reading it");
+            return -1;
+        }
+        status = JPy_ReadColumnRows(jenv, columns, columnCount, type, chunkRef, offset, chunkSize);
+        (*jenv)->DeleteLocalRef(jenv, chunkRef);
+        if (status < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+PyObject* JPy_GetColumns(JNIEnv* jenv, jobject containerRef, PyObject* names, JPy_JType* type)
+{
+    PyObject* nameSeq;
+    PyObject* result;
+    PyObject* view;
+    PyObject* value;
+    JPy_JType* containerType;
+    JPy_Column* columns;
+    jobjectArray arrayRef;
+    jobject firstRef;
+    Py_ssize_t columnCount;
+    Py_ssize_t rowCount;
+    Py_ssize_t i;
+    jboolean isList;
+    int status;
+
+    nameSeq = PySequence_Fast(names, "columns: argument 2 (names) must be a sequence of property names");
+    if (nameSeq == NULL) {
+        return NULL;
+    }
+    columnCount = PySequence_Fast_GET_SIZE(nameSeq);
+
+    result = NULL;
+    columns = NULL;
+    arrayRef = NULL;
+    Py_XINCREF(type);
+
+    // Lists supporting fast random access are read chunk-wise, other collections are copied into an array at once
+    isList = JNI_FALSE;
+    if ((*jenv)->IsInstanceOf(jenv, containerRef, JPy_Collection_JClass)) {
+        if ((*jenv)->IsInstanceOf(jenv, containerRef, JPy_List_JClass)
+            && (*jenv)->IsInstanceOf(jenv, containerRef, JPy_RandomAccess_JClass)) {
+            isList = JNI_TRUE;
+            rowCount = (*jenv)->CallIntMethod(jenv, containerRef, JPy_Collection_Size_MID);
+        } else {
+            arrayRef = (jobjectArray) (*jenv)->CallObjectMethod(jenv, containerRef, JPy_Collection_ToArray_MID);
+        }
+        JPy_ON_JAVA_EXCEPTION_GOTO(error);
+    } else {
+        containerType = JType_GetTypeForObject(jenv, containerRef);
+        if (containerType == NULL) {
+            goto error;
+        }
+        status = containerType->componentType != NULL && !containerType->componentType->isPrimitive;
+        Py_DECREF(containerType);
+        if (!status) {
+            PyErr_SetString(PyExc_ValueError, "columns: argument 1 (collection) must be a Java Collection or object array");
+            goto error;
+        }
+        arrayRef = (jobjectArray) (*jenv)->NewLocalRef(jenv, containerRef);
+    }
+    if (!isList) {
+        rowCount = (*jenv)->GetArrayLength(jenv, arrayRef);
+    }
+
+    if (type == NULL && rowCount > 0) {
+        if (isList) {
+            jobject subListRef = (*jenv)->CallObjectMethod(jenv, containerRef, JPy_List_SubList_MID, 0, 1);
+            JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            arrayRef = (jobjectArray) (*jenv)->CallObjectMethod(jenv, subListRef, JPy_Collection_ToArray_MID);
+            (*jenv)->DeleteLocalRef(jenv, subListRef);
+            JPy_ON_JAVA_EXCEPTION_GOTO(error);
+        }
+        firstRef = (*jenv)->GetObjectArrayElement(jenv, arrayRef, 0);
+        if (firstRef == NULL) {
+            PyErr_SetString(PyExc_ValueError, "columns: element 0 is null");
+            goto error;
+        }
+        type = JType_GetTypeForObject(jenv, firstRef);
+        (*jenv)->DeleteLocalRef(jenv, firstRef);
+        if (type == NULL) {
+            goto error;
+        }
+    }
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_TYPE, "JPy_GetColumns: type='%s', columnCount=%zd, rowCount=%zd\n",
+                   type != NULL ? type->javaName : "?", columnCount, rowCount);
+
+    // If there are no elements and no type is given, all columns are empty lists
+    columns = JPy_NewColumns(jenv, type, nameSeq, rowCount);
+    if (columns == NULL) {
+        goto error;
+    }
+
+    if (rowCount > 0) {
+        if (isList) {
+            status = JPy_ReadColumnListRows(jenv, columns, columnCount, type, containerRef, rowCount);
+        } else {
+            status = JPy_ReadColumnRows(jenv, columns, columnCount, type, arrayRef, 0, rowCount);
+        }
+        if (status < 0) {
+            goto error;
+        }
+    }
+
+    result = PyDict_New();
+    if (result == NULL) {
+        goto error;
+    }
+    for (i = 0; i < columnCount; i++) {
+        if (columns[i].format != NULL) {
+            view = PyMemoryView_FromObject(columns[i].values);
+            if (view == NULL) {
+                goto error;
+            }
+            value = PyObject_CallMethod(view, "cast", "s", columns[i].format);
+            Py_DECREF(view);
+            if (value == NULL) {
+                goto error;
+            }
+        } else {
+            value = columns[i].values;
+            Py_INCREF(value);
+        }
+        status = PyDict_SetItem(result, PySequence_Fast_GET_ITEM(nameSeq, i), value);
+        Py_DECREF(value);
+        if (status < 0) {
+            goto error;
+        }
+    }
+
+    JPy_FreeColumns(columns, columnCount);
+    if (arrayRef != NULL) {
+        (*jenv)->DeleteLocalRef(jenv, arrayRef);
+    }
+    Py_XDECREF(type);
+    Py_DECREF(nameSeq);
+    return result;
+
+error:
+    Py_XDECREF(result);
+    if (columns != NULL) {
+        JPy_FreeColumns(columns, columnCount);
+    }
+    if (arrayRef != NULL) {
+        (*jenv)->DeleteLocalRef(jenv, arrayRef);
+    }
+    Py_XDECREF(type);
+    Py_DECREF(nameSeq);
+    return NULL;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JPY_COLUMNS_H
+#define JPY_COLUMNS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "jpy_compat.h"
+
+struct JPy_JType;
+
+/**
+ * Number of elements of a java.util.List fetched at once by subList(from, to).toArray().
+ */
+#define JPy_COLUMNS_CHUNK_SIZE 4096
+
+/**
+ * Extracts the given properties of all elements of a Java Collection or object array into columns,
+ * see jpy.columns(). Each property name is resolved once to a public instance field, or to a public
+ * getter 'getName()', 'isName()' or 'name()' of the given element type. If type is NULL,
+ * the class of the first element is used.
+ *
+ * Returns a new dictionary mapping the names to the columns: memoryviews of typed contiguous buffers
+ * for primitive properties, lists for all other properties.
+ */
+PyObject* JPy_GetColumns(JNIEnv* jenv, jobject containerRef, PyObject* names, struct JPy_JType* type);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+#endif /* !JPY_COLUMNS_H */
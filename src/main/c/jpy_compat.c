@@ -67,3 +67,79 @@ error:
 }
 
 #endif
+
+
+PyObject* JPy_GetDictItemString(PyObject* dict, const char* key)
+{
+    PyObject* value;
+#ifdef JPY_FREE_THREADED
+    if (PyDict_GetItemStringRef(dict, key, &value) < 0) {
+        PyErr_Clear();
+        return NULL;
+    }
+#else
+    value = PyDict_GetItemString(dict, key);
+    Py_XINCREF(value);
+#endif
+    return value;
+}
+
+PyObject* JPy_GetDictItem(PyObject* dict, PyObject* key)
+{
+    PyObject* value;
+#ifdef JPY_FREE_THREADED
+    if (PyDict_GetItemRef(dict, key, &value) < 0) {
+        PyErr_Clear();
+        return NULL;
+    }
+#else
+    value = PyDict_GetItem(dict, key);
+    Py_XINCREF(value);
+#endif
+    return value;
+}
+
+PyObject* JPy_LookupTypeAttr(PyTypeObject* type, PyObject* name)
+{
+    PyObject* value;
+#ifdef JPY_FREE_THREADED
+    value = _PyType_LookupRef(type, name);
+#else
+    value = _PyType_Lookup(type, name);
+    Py_XINCREF(value);
+#endif
+    return value;
+}
+
+#ifdef JPY_FREE_THREADED
+
+static PyMutex JPy_GlobalMutex = {0};
+// Identifier of the thread holding JPy_GlobalMutex, 0 if not locked.
+static uintptr_t JPy_GlobalLockOwner = 0;
+// Number of nested JPy_AcquireGlobalLock() calls of the owning thread.
+static int JPy_GlobalLockDepth = 0;
+
+void JPy_AcquireGlobalLock(void)
+{
+    uintptr_t threadId = (uintptr_t) PyThread_get_thread_ident();
+
+    // Only the owning thread itself can have set the owner to its own identifier
+    if (_Py_atomic_load_uintptr_relaxed(&JPy_GlobalLockOwner) == threadId) {
+        JPy_GlobalLockDepth++;
+        return;
+    }
+    // Detaches the thread state while waiting, so that the waiting thread doesn't block garbage collection
+    PyMutex_Lock(&JPy_GlobalMutex);
+    _Py_atomic_store_uintptr_relaxed(&JPy_GlobalLockOwner, threadId);
+    JPy_GlobalLockDepth = 1;
+}
+
+void JPy_ReleaseGlobalLock(void)
+{
+    if (--JPy_GlobalLockDepth == 0) {
+        _Py_atomic_store_uintptr_relaxed(&JPy_GlobalLockOwner, 0);
+        PyMutex_Unlock(&JPy_GlobalMutex);
+    }
+}
+
+#endif
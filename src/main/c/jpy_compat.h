@@ -42,11 +42,13 @@ extern "C" {
 #if defined(JPY_COMPAT_33P)
 
 #define JPy_IS_CLONG(pyArg)      PyLong_Check(pyArg)
+#define JPy_IS_CLONG_EXACT(pyArg) PyLong_CheckExact(pyArg)
 #define JPy_AS_CLONG(pyArg)      PyLong_AsLong(pyArg)
 #define JPy_AS_CLONGLONG(pyArg)  PyLong_AsLongLong(pyArg)
 #define JPy_FROM_CLONG(cl)       PyLong_FromLong(cl)
 
 #define JPy_IS_STR(pyArg)        PyUnicode_Check(pyArg)
+#define JPy_IS_STR_EXACT(pyArg)  PyUnicode_CheckExact(pyArg)
 #define JPy_FROM_CSTR(cstr)      PyUnicode_FromString(cstr)
 #define JPy_FROM_FORMAT          PyUnicode_FromFormat
 
@@ -57,11 +59,13 @@ extern "C" {
 #elif defined(JPY_COMPAT_27)
 
 #define JPy_IS_CLONG(pyArg)      (PyInt_Check(pyArg) || PyLong_Check(pyArg))
+#define JPy_IS_CLONG_EXACT(pyArg) (PyInt_CheckExact(pyArg) || PyLong_CheckExact(pyArg))
 #define JPy_AS_CLONG(pyArg)      (PyInt_Check(pyArg) ? PyInt_AsLong(pyArg) : PyLong_AsLong(pyArg))
 #define JPy_AS_CLONGLONG(pyArg)  (PyInt_Check(pyArg) ? PyInt_AsLong(pyArg) : PyLong_AsLongLong(pyArg))
 #define JPy_FROM_CLONG(cl)        PyInt_FromLong(cl)
 
 #define JPy_IS_STR(pyArg)        (PyString_Check(pyArg) || PyUnicode_Check(pyArg))
+#define JPy_IS_STR_EXACT(pyArg)  (PyString_CheckExact(pyArg) || PyUnicode_CheckExact(pyArg))
 #define JPy_FROM_CSTR(cstr)      PyString_FromString(cstr)
 #define JPy_FROM_FORMAT          PyString_FromFormat
 
@@ -79,6 +83,63 @@ wchar_t* JPy_AsWideCharString_PriorToPy33(PyObject *unicode, Py_ssize_t *size);
 #endif
 
 
+/**
+ * Free-threaded CPython builds (3.13t and higher) have no GIL protecting jpy's shared mutable state.
+ * There, the code registering JTypes and other lazily created, process-wide registries is enclosed by
+ * JPy_BEGIN_GLOBAL_LOCK and JPy_END_GLOBAL_LOCK. The lock is recursive, because registering a type
+ * registers its super and component types, too. JPy_BEGIN_CRITICAL_SECTION and JPy_END_CRITICAL_SECTION
+ * protect caches stored in a single object. In builds with a GIL, the macros do nothing.
+ *
+ * Never return from within these blocks.
+ */
+#if defined(Py_GIL_DISABLED)
+
+#define JPY_FREE_THREADED 1
+
+void JPy_AcquireGlobalLock(void);
+void JPy_ReleaseGlobalLock(void);
+
+#define JPy_BEGIN_GLOBAL_LOCK             JPy_AcquireGlobalLock();
+#define JPy_END_GLOBAL_LOCK               JPy_ReleaseGlobalLock();
+#define JPy_BEGIN_CRITICAL_SECTION(OBJ)   Py_BEGIN_CRITICAL_SECTION(OBJ);
+#define JPy_END_CRITICAL_SECTION          Py_END_CRITICAL_SECTION();
+
+#else
+
+#define JPy_BEGIN_GLOBAL_LOCK
+#define JPy_END_GLOBAL_LOCK
+#define JPy_BEGIN_CRITICAL_SECTION(OBJ)   {
+#define JPy_END_CRITICAL_SECTION          }
+
+#endif
+
+/**
+ * Storage class of variables which have a separate instance in each thread.
+ */
+#if defined(_MSC_VER)
+#define JPy_THREAD_LOCAL __declspec(thread)
+#else
+#define JPy_THREAD_LOCAL __thread
+#endif
+
+/**
+ * Returns a new reference to the value for the given key in a dictionary, or NULL without an error set if not found.
+ * Unlike PyDict_GetItemString(), it is safe while other threads modify the dictionary in free-threaded builds.
+ */
+PyObject* JPy_GetDictItemString(PyObject* dict, const char* key);
+
+/**
+ * Like JPy_GetDictItemString(), for keys of any type.
+ */
+PyObject* JPy_GetDictItem(PyObject* dict, PyObject* key);
+
+/**
+ * Returns a new reference to the attribute with the given name found in the MRO of the given type,
+ * without invoking descriptors, or NULL without an error set if not found.
+ */
+PyObject* JPy_LookupTypeAttr(PyTypeObject* type, PyObject* name);
+
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
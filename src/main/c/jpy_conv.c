@@ -82,6 +82,490 @@ PyObject* JPy_FromJObjectWithType(JNIEnv* jenv, jobject objectRef, JPy_JType* ty
     return JType_ConvertJavaToPythonObject(jenv, type, objectRef);
 }
 
+/**
+ * Copies the items of a Java primitive array into a new Python list, fetching all of them by a single JNI call.
+ */
+static PyObject* JPy_FromJPrimitiveArrayDeep(JNIEnv* jenv, JPy_JType* componentType, jarray arrayRef)
+{
+    PyObject* result;
+    PyObject* item;
+    void* items;
+    jsize length;
+    jsize i;
+
+    length = (*jenv)->GetArrayLength(jenv, arrayRef);
+    result = PyList_New(length);
+    if (result == NULL || length == 0) {
+        return result;
+    }
+
+    // jlong and jdouble are the largest primitive types
+    items = PyMem_Malloc((size_t) length * sizeof(jlong));
+    if (items == NULL) {
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+
+#define JPy_COPY_PRIMITIVE_ITEMS(J_TYPE, GET_REGION, FROM_J_VALUE) \
+    (*jenv)->GET_REGION(jenv, (J_TYPE##Array) arrayRef, 0, length, (J_TYPE*) items); \
+    for (i = 0; i < length; i++) { \
+        item = FROM_J_VALUE(((J_TYPE*) items)[i]); \
+        if (item == NULL) { \
+            goto error; \
+        } \
+        PyList_SET_ITEM(result, i, item); \
+    }
+
+    if (componentType == JPy_JBoolean) {
+        JPy_COPY_PRIMITIVE_ITEMS(jboolean, GetBooleanArrayRegion, JPy_FROM_JBOOLEAN)
+    } else if (componentType == JPy_JChar) {
+        JPy_COPY_PRIMITIVE_ITEMS(jchar, GetCharArrayRegion, JPy_FROM_JCHAR)
+    } else if (componentType == JPy_JByte) {
+        JPy_COPY_PRIMITIVE_ITEMS(jbyte, GetByteArrayRegion, JPy_FROM_JBYTE)
+    } else if (componentType == JPy_JShort) {
+        JPy_COPY_PRIMITIVE_ITEMS(jshort, GetShortArrayRegion, JPy_FROM_JSHORT)
+    } else if (componentType == JPy_JInt) {
+        JPy_COPY_PRIMITIVE_ITEMS(jint, GetIntArrayRegion, JPy_FROM_JINT)
+    } else if (componentType == JPy_JLong) {
+        JPy_COPY_PRIMITIVE_ITEMS(jlong, GetLongArrayRegion, JPy_FROM_JLONG)
+    } else if (componentType == JPy_JFloat) {
+        JPy_COPY_PRIMITIVE_ITEMS(jfloat, GetFloatArrayRegion, JPy_FROM_JFLOAT)
+    } else if (componentType == JPy_JDouble) {
+        JPy_COPY_PRIMITIVE_ITEMS(jdouble, GetDoubleArrayRegion, JPy_FROM_JDOUBLE)
+    } else {
+        PyErr_Format(PyExc_TypeError, "jpy: internal error: unexpected primitive type '%s'", componentType->javaName);
+        goto error;
+    }
+
+#undef JPy_COPY_PRIMITIVE_ITEMS
+
+    PyMem_Free(items);
+    return result;
+
+error:
+    PyMem_Free(items);
+    Py_DECREF(result);
+    return NULL;
+}
+
+/**
+ * Converts the items of a Java object array into a new Python list, or into a new Python set if asSet is true.
+ * The local references created per item are released every JPy_LOCAL_FRAME_CHUNK_SIZE items.
+ */
+static PyObject* JPy_FromJObjectArrayDeep(JNIEnv* jenv, jobjectArray arrayRef, int depth, jboolean asSet)
+{
+    PyObject* result;
+    PyObject* item;
+    jobject itemRef;
+    jsize length;
+    jsize i;
+
+    length = (*jenv)->GetArrayLength(jenv, arrayRef);
+    result = asSet ? PySet_New(NULL) : PyList_New(length);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        JPy_HandleJavaException(jenv);
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    for (i = 0; i < length; i++) {
+        if (JPy_RenewLocalFrame(jenv, i) < 0) {
+            JPy_HandleJavaException(jenv);
+            Py_DECREF(result);
+            return NULL;
+        }
+        itemRef = (*jenv)->GetObjectArrayElement(jenv, arrayRef, i);
+        item = JPy_FromJObjectDeep(jenv, itemRef, depth);
+        if (item == NULL) {
+            goto error;
+        }
+        if (asSet) {
+            int addResult = PySet_Add(result, item);
+            Py_DECREF(item);
+            if (addResult < 0) {
+                goto error;
+            }
+        } else {
+            PyList_SET_ITEM(result, i, item);
+        }
+    }
+
+    (*jenv)->PopLocalFrame(jenv, NULL);
+    return result;
+
+error:
+    (*jenv)->PopLocalFrame(jenv, NULL);
+    Py_DECREF(result);
+    return NULL;
+}
+
+/**
+ * Converts the entries of a Java Map into a new Python dictionary. Keys are converted by JPy_FromJObject(),
+ * so that they are hashable, values are converted to the given depth.
+ */
+static PyObject* JPy_FromJMapDeep(JNIEnv* jenv, jobject mapRef, int depth)
+{
+    PyObject* result;
+    PyObject* pyKey;
+    PyObject* pyValue;
+    jobject entrySet;
+    jobjectArray entries;
+    jobject entry;
+    jobject keyRef;
+    jobject valueRef;
+    jsize length;
+    jsize i;
+    int setResult;
+
+    // Fetch all entries at once instead of iterating them by two Java calls per entry
+    entrySet = (*jenv)->CallObjectMethod(jenv, mapRef, JPy_Map_entrySet_MID);
+    JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+    entries = (jobjectArray) (*jenv)->CallObjectMethod(jenv, entrySet, JPy_Collection_ToArray_MID);
+    (*jenv)->DeleteLocalRef(jenv, entrySet);
+    JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+
+    result = PyDict_New();
+    if (result == NULL) {
+        (*jenv)->DeleteLocalRef(jenv, entries);
+        return NULL;
+    }
+
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        JPy_HandleJavaException(jenv);
+        (*jenv)->DeleteLocalRef(jenv, entries);
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    length = (*jenv)->GetArrayLength(jenv, entries);
+    for (i = 0; i < length; i++) {
+        if (JPy_RenewLocalFrame(jenv, i) < 0) {
+            JPy_HandleJavaException(jenv);
+            (*jenv)->DeleteLocalRef(jenv, entries);
+            Py_DECREF(result);
+            return NULL;
+        }
+        entry = (*jenv)->GetObjectArrayElement(jenv, entries, i);
+        keyRef = (*jenv)->CallObjectMethod(jenv, entry, JPy_Map_Entry_getKey_MID);
+        JPy_ON_JAVA_EXCEPTION_GOTO(error);
+        valueRef = (*jenv)->CallObjectMethod(jenv, entry, JPy_Map_Entry_getValue_MID);
+        JPy_ON_JAVA_EXCEPTION_GOTO(error);
+
+        pyKey = JPy_FromJObjectDeep(jenv, keyRef, 0);
+        if (pyKey == NULL) {
+            goto error;
+        }
+        pyValue = JPy_FromJObjectDeep(jenv, valueRef, depth);
+        if (pyValue == NULL) {
+            Py_DECREF(pyKey);
+            goto error;
+        }
+        setResult = PyDict_SetItem(result, pyKey, pyValue);
+        Py_DECREF(pyKey);
+        Py_DECREF(pyValue);
+        if (setResult < 0) {
+            goto error;
+        }
+    }
+
+    (*jenv)->PopLocalFrame(jenv, NULL);
+    (*jenv)->DeleteLocalRef(jenv, entries);
+    return result;
+
+error:
+    (*jenv)->PopLocalFrame(jenv, NULL);
+    (*jenv)->DeleteLocalRef(jenv, entries);
+    Py_DECREF(result);
+    return NULL;
+}
+
+/**
+ * Converts a Java Collection into a new Python list, or into a new Python set if asSet is true.
+ * All elements are fetched at once by Collection.toArray().
+ */
+static PyObject* JPy_FromJCollectionDeep(JNIEnv* jenv, jobject collectionRef, int depth, jboolean asSet)
+{
+    PyObject* result;
+    jobjectArray arrayRef;
+
+    arrayRef = (jobjectArray) (*jenv)->CallObjectMethod(jenv, collectionRef, JPy_Collection_ToArray_MID);
+    JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+    result = JPy_FromJObjectArrayDeep(jenv, arrayRef, depth, asSet);
+    (*jenv)->DeleteLocalRef(jenv, arrayRef);
+    return result;
+}
+
+PyObject* JPy_FromJObjectDeep(JNIEnv* jenv, jobject objectRef, int depth)
+{
+    JPy_JType* type;
+    PyObject* result;
+
+    if (objectRef == NULL) {
+        return JPy_FROM_JNULL();
+    }
+
+    if (JPy_PyObject_JClass != NULL && (*jenv)->IsInstanceOf(jenv, objectRef, JPy_PyObject_JClass)) {
+        // A Python object passed to Java, convert it back into itself
+        result = JPy_GetPyObjectPointer(jenv, objectRef);
+        Py_INCREF(result);
+        return result;
+    }
+
+    if (depth == 0) {
+        return JPy_FromJObject(jenv, objectRef);
+    }
+
+    type = JType_GetTypeForObject(jenv, objectRef);
+    if (type == NULL) {
+        return NULL;
+    }
+
+    if (type->componentType == NULL
+        && !(*jenv)->IsInstanceOf(jenv, objectRef, JPy_Map_JClass)
+        && !(*jenv)->IsInstanceOf(jenv, objectRef, JPy_Collection_JClass)) {
+        result = JType_ConvertJavaToPythonObject(jenv, type, objectRef);
+        Py_DECREF(type);
+        return result;
+    }
+
+    // Guard against Java containers containing themselves
+    if (Py_EnterRecursiveCall(" while converting a Java object")) {
+        Py_DECREF(type);
+        return NULL;
+    }
+    // Negative depths never reach zero, which means unlimited depth
+    depth--;
+    if (type->componentType != NULL && type->componentType->isPrimitive) {
+        result = JPy_FromJPrimitiveArrayDeep(jenv, type->componentType, (jarray) objectRef);
+    } else if (type->componentType != NULL) {
+        result = JPy_FromJObjectArrayDeep(jenv, (jobjectArray) objectRef, depth, JNI_FALSE);
+    } else if ((*jenv)->IsInstanceOf(jenv, objectRef, JPy_Map_JClass)) {
+        result = JPy_FromJMapDeep(jenv, objectRef, depth);
+    } else if ((*jenv)->IsInstanceOf(jenv, objectRef, JPy_Set_JClass)) {
+        // Set elements must be hashable, so they are not converted into lists or dictionaries
+        result = JPy_FromJCollectionDeep(jenv, objectRef, 0, JNI_TRUE);
+    } else {
+        result = JPy_FromJCollectionDeep(jenv, objectRef, depth, JNI_FALSE);
+    }
+    Py_LeaveRecursiveCall();
+    Py_DECREF(type);
+    return result;
+}
+
+/**
+ * Converts the items of a Python list or tuple and stores them in the Java array or adds them to the
+ * Java collection containerRef. The local references created per item are released chunk-wise.
+ */
+static int JPy_AsJSequenceDeep(JNIEnv* jenv, PyObject* pySeq, JPy_JType* itemType, jobject containerRef, jboolean isArray)
+{
+    jobject itemRef;
+    Py_ssize_t length;
+    Py_ssize_t i;
+    int status;
+
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        JPy_HandleJavaException(jenv);
+        return -1;
+    }
+
+    status = 0;
+    JPy_BEGIN_CRITICAL_SECTION(pySeq)
+    length = PySequence_Fast_GET_SIZE(pySeq);
+    for (i = 0; i < length; i++) {
+        if (JPy_RenewLocalFrame(jenv, (jint) i) < 0) {
+            JPy_HandleJavaException(jenv);
+            // There is no frame left to pop
+            status = -2;
+            break;
+        }
+        if (JPy_AsJObjectDeep(jenv, PySequence_Fast_GET_ITEM(pySeq, i), itemType, &itemRef) < 0) {
+            status = -1;
+            break;
+        }
+        if (isArray) {
+            (*jenv)->SetObjectArrayElement(jenv, (jobjectArray) containerRef, (jsize) i, itemRef);
+        } else {
+            (*jenv)->CallBooleanMethod(jenv, containerRef, JPy_Collection_Add_MID, itemRef);
+        }
+        if ((*jenv)->ExceptionCheck(jenv)) {
+            JPy_HandleJavaException(jenv);
+            status = -1;
+            break;
+        }
+    }
+    JPy_END_CRITICAL_SECTION
+
+    if (status != -2) {
+        (*jenv)->PopLocalFrame(jenv, NULL);
+    }
+    return status < 0 ? -1 : 0;
+}
+
+/**
+ * Converts the items of a Python dictionary and puts them into the Java map mapRef.
+ */
+static int JPy_AsJMapDeep(JNIEnv* jenv, PyObject* pyDict, jobject mapRef)
+{
+    PyObject* pyKey;
+    PyObject* pyValue;
+    jobject keyRef;
+    jobject valueRef;
+    Py_ssize_t pos;
+    jint index;
+    int status;
+
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        JPy_HandleJavaException(jenv);
+        return -1;
+    }
+
+    status = 0;
+    pos = 0;
+    index = 0;
+    JPy_BEGIN_CRITICAL_SECTION(pyDict)
+    while (PyDict_Next(pyDict, &pos, &pyKey, &pyValue)) {
+        if (JPy_RenewLocalFrame(jenv, index++) < 0) {
+            JPy_HandleJavaException(jenv);
+            status = -2;
+            break;
+        }
+        if (JPy_AsJObjectDeep(jenv, pyKey, JPy_JObject, &keyRef) < 0
+            || JPy_AsJObjectDeep(jenv, pyValue, JPy_JObject, &valueRef) < 0) {
+            status = -1;
+            break;
+        }
+        (*jenv)->CallObjectMethod(jenv, mapRef, JPy_Map_put_MID, keyRef, valueRef);
+        if ((*jenv)->ExceptionCheck(jenv)) {
+            JPy_HandleJavaException(jenv);
+            status = -1;
+            break;
+        }
+    }
+    JPy_END_CRITICAL_SECTION
+
+    if (status != -2) {
+        (*jenv)->PopLocalFrame(jenv, NULL);
+    }
+    return status < 0 ? -1 : 0;
+}
+
+/**
+ * Converts the items of a Python set or frozenset and adds them to the Java collection setRef.
+ */
+static int JPy_AsJSetDeep(JNIEnv* jenv, PyObject* pySet, jobject setRef)
+{
+    PyObject* pyIter;
+    PyObject* pyItem;
+    jobject itemRef;
+    jint index;
+
+    pyIter = PyObject_GetIter(pySet);
+    if (pyIter == NULL) {
+        return -1;
+    }
+
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        JPy_HandleJavaException(jenv);
+        Py_DECREF(pyIter);
+        return -1;
+    }
+
+    for (index = 0; (pyItem = PyIter_Next(pyIter)) != NULL; index++) {
+        if (JPy_RenewLocalFrame(jenv, index) < 0) {
+            JPy_HandleJavaException(jenv);
+            Py_DECREF(pyItem);
+            Py_DECREF(pyIter);
+            return -1;
+        }
+        if (JPy_AsJObjectDeep(jenv, pyItem, JPy_JObject, &itemRef) < 0) {
+            Py_DECREF(pyItem);
+            break;
+        }
+        Py_DECREF(pyItem);
+        (*jenv)->CallBooleanMethod(jenv, setRef, JPy_Collection_Add_MID, itemRef);
+        if ((*jenv)->ExceptionCheck(jenv)) {
+            JPy_HandleJavaException(jenv);
+            break;
+        }
+    }
+
+    (*jenv)->PopLocalFrame(jenv, NULL);
+    Py_DECREF(pyIter);
+    // Conversion errors and errors raised by the iterator are both set
+    return PyErr_Occurred() ? -1 : 0;
+}
+
+/**
+ * Returns the initial capacity of a Java HashMap or HashSet which never needs to grow for the given size.
+ */
+static jint JPy_GetHashCapacity(Py_ssize_t size)
+{
+    return (jint) (size + size / 3 + 1);
+}
+
+int JPy_AsJObjectDeep(JNIEnv* jenv, PyObject* pyObj, JPy_JType* type, jobject* objectRef)
+{
+    JPy_JType* itemType;
+    jobject containerRef;
+    jboolean isArray;
+    int status;
+
+    isArray = JNI_FALSE;
+    itemType = JPy_JObject;
+    if (PyDict_Check(pyObj)) {
+        containerRef = (*jenv)->NewObject(jenv, JPy_HashMap_JClass, JPy_HashMap_Init_MID, JPy_GetHashCapacity(PyDict_Size(pyObj)));
+    } else if (PyList_Check(pyObj) || PyTuple_Check(pyObj)) {
+        if (type->componentType != NULL && type->componentType->isPrimitive) {
+            // Primitive arrays can't contain containers
+            return JType_ConvertPythonToJavaObject(jenv, type, pyObj, objectRef, JNI_TRUE);
+        }
+        // Tuples become arrays unless another type is requested, lists become array lists unless an array is requested
+        if (type->componentType != NULL || (PyTuple_Check(pyObj) && type == JPy_JObject)) {
+            if (type->componentType != NULL) {
+                itemType = type->componentType;
+            }
+            containerRef = (*jenv)->NewObjectArray(jenv, (jsize) PySequence_Fast_GET_SIZE(pyObj), itemType->classRef, NULL);
+            isArray = JNI_TRUE;
+        } else {
+            containerRef = (*jenv)->NewObject(jenv, JPy_ArrayList_JClass, JPy_ArrayList_Init_MID, (jint) PySequence_Fast_GET_SIZE(pyObj));
+        }
+    } else if (PyAnySet_Check(pyObj)) {
+        containerRef = (*jenv)->NewObject(jenv, JPy_HashSet_JClass, JPy_HashSet_Init_MID, JPy_GetHashCapacity(PySet_Size(pyObj)));
+    } else {
+        return JType_ConvertPythonToJavaObject(jenv, type, pyObj, objectRef, JNI_TRUE);
+    }
+
+    if (containerRef == NULL) {
+        JPy_HandleJavaException(jenv);
+        return -1;
+    }
+
+    // Guard against Python containers containing themselves
+    if (Py_EnterRecursiveCall(" while converting a Python object to Java")) {
+        (*jenv)->DeleteLocalRef(jenv, containerRef);
+        return -1;
+    }
+    if (PyDict_Check(pyObj)) {
+        status = JPy_AsJMapDeep(jenv, pyObj, containerRef);
+    } else if (PyAnySet_Check(pyObj)) {
+        status = JPy_AsJSetDeep(jenv, pyObj, containerRef);
+    } else {
+        status = JPy_AsJSequenceDeep(jenv, pyObj, itemType, containerRef, isArray);
+    }
+    Py_LeaveRecursiveCall();
+
+    if (status < 0) {
+        (*jenv)->DeleteLocalRef(jenv, containerRef);
+        return -1;
+    }
+    *objectRef = containerRef;
+    return 0;
+}
+
 
 /**
  * Copies the UTF, zero-terminated C-string.
@@ -79,6 +79,13 @@ PyObject* JPy_FromJObject(JNIEnv* jenv, jobject objectRef);
  */
 PyObject* JPy_FromJObjectWithType(JNIEnv* jenv, jobject objectRef, JPy_JType* type);
 
+/**
+ * Convert any Java Object to Python Object, also converting Java containers into Python containers
+ * down to the given depth: Maps into dicts, Sets into sets, other Collections and arrays into lists.
+ * A depth of 0 is the same as JPy_FromJObject(), a negative depth means unlimited depth.
+ */
+PyObject* JPy_FromJObjectDeep(JNIEnv* jenv, jobject objectRef, int depth);
+
 /**
  * Convert Python unicode object to Java String.
  */
@@ -101,6 +108,14 @@ int JPy_AsJObjectWithType(JNIEnv* jenv, PyObject* pyObj, jobject* objectRef, JPy
  */
 int JPy_AsJObjectWithClass(JNIEnv* jenv, PyObject* pyObj, jobject* objectRef, jclass classRef);
 
+/**
+ * Convert Python objects to Java object with known type, also converting nested Python containers into
+ * Java containers: dicts into HashMaps, lists into ArrayLists, tuples into Object[] and sets into HashSets.
+ * Lists and tuples become arrays if type is an array type, and tuples become ArrayLists if type is not Object.
+ * Objects which can't be converted otherwise are wrapped into org.jpy.PyObject instances.
+ */
+int JPy_AsJObjectDeep(JNIEnv* jenv, PyObject* pyObj, JPy_JType* type, jobject* objectRef);
+
 
 /**
  * Creates a Python unicode object representing the name of the given class.
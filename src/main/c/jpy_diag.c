@@ -17,10 +17,29 @@
 #include <Python.h>
 #include "structmember.h"
 #include "jpy_diag.h"
+#include "jpy_prof.h"
+#include "jpy_trace.h"
 #include "jpy_compat.h"
 
 int JPy_DiagFlags = JPy_DIAG_F_OFF;
 
+long long JPy_Stats[JPy_STAT_COUNT];
+
+const char* JPy_StatNames[JPy_STAT_COUNT] = {
+    "java_calls",
+    "overload_resolutions",
+    "overload_cache_misses",
+    "types_resolved",
+    "global_refs_created",
+    "global_refs_deleted",
+    "gil_acquisitions",
+    "buffer_exports",
+    "buffer_bytes_copied",
+    "java_exceptions",
+    "python_exceptions",
+    "buffer_acquisitions",
+};
+
 
 void JPy_DiagPrint(int diagFlags, const char * format, ...)
 {
@@ -34,6 +53,15 @@ void JPy_DiagPrint(int diagFlags, const char * format, ...)
 }
 
 
+void JPy_GetStats(long long* stats)
+{
+    int i;
+    for (i = 0; i < JPy_STAT_COUNT; i++) {
+        stats[i] = JPy_ATOMIC_GET(&JPy_Stats[i]);
+    }
+}
+
+
 PyObject* Diag_New(void)
 {
     JPy_Diag* self;
@@ -58,6 +86,10 @@ PyObject* Diag_getattro(JPy_Diag* self, PyObject *attr_name)
     //printf("Diag_getattro: attr_name=%s\n", JPy_AS_UTF8(attr_name));
     if (strcmp(JPy_AS_UTF8(attr_name), "flags") == 0) {
         return JPy_FROM_CLONG(JPy_DiagFlags);
+    } else if (strcmp(JPy_AS_UTF8(attr_name), "profiling") == 0) {
+        return PyBool_FromLong(JPy_ProfilingEnabled);
+    } else if (strcmp(JPy_AS_UTF8(attr_name), "tracing") == 0) {
+        return PyBool_FromLong(JPy_TraceEnabled);
     } else {
         return PyObject_GenericGetAttr((PyObject*) self, attr_name);
     }
@@ -75,12 +107,138 @@ int Diag_setattro(JPy_Diag* self, PyObject *attr_name, PyObject *v)
             return -1;
         }
         return 0;
+    } else if (strcmp(JPy_AS_UTF8(attr_name), "profiling") == 0) {
+        if (PyBool_Check(v)) {
+            JPy_ProfilingEnabled = v == Py_True;
+        } else {
+            PyErr_SetString(PyExc_ValueError, "value for 'profiling' must be a boolean");
+            return -1;
+        }
+        return 0;
+    } else if (strcmp(JPy_AS_UTF8(attr_name), "tracing") == 0) {
+        if (PyBool_Check(v)) {
+            JPy_SetTracing(v == Py_True);
+        } else {
+            PyErr_SetString(PyExc_ValueError, "value for 'tracing' must be a boolean");
+            return -1;
+        }
+        return 0;
     } else {
         return PyObject_GenericSetAttr((PyObject*) self, attr_name, v);
     }
 }
 
 
+/**
+ * Implements the jpy.diag.stats() method.
+ */
+PyObject* Diag_stats(JPy_Diag* self, PyObject* args)
+{
+    long long stats[JPy_STAT_COUNT];
+    PyObject* dict;
+    PyObject* value;
+    int i;
+
+    JPy_GetStats(stats);
+
+    dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < JPy_STAT_COUNT; i++) {
+        value = PyLong_FromLongLong(stats[i]);
+        if (value == NULL || PyDict_SetItemString(dict, JPy_StatNames[i], value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+    return dict;
+}
+
+
+/**
+ * Implements the jpy.diag.profile_report(n=20) method.
+ */
+PyObject* Diag_profile_report(JPy_Diag* self, PyObject* args)
+{
+    int n = 20;
+    if (!PyArg_ParseTuple(args, "|i:profile_report", &n)) {
+        return NULL;
+    }
+    return JPy_GetProfileReport(n);
+}
+
+
+/**
+ * Implements the jpy.diag.reset_profile() method.
+ */
+PyObject* Diag_reset_profile(JPy_Diag* self, PyObject* args)
+{
+    JPy_ResetProfiles();
+    return Py_BuildValue("");
+}
+
+
+/**
+ * Implements the jpy.diag.trace_dump(path) method.
+ */
+PyObject* Diag_trace_dump(JPy_Diag* self, PyObject* args)
+{
+    const char* path;
+    long long count;
+
+    if (!PyArg_ParseTuple(args, "s:trace_dump", &path)) {
+        return NULL;
+    }
+    count = JPy_TraceDump(path);
+    if (count < 0) {
+        return NULL;
+    }
+    return PyLong_FromLongLong(count);
+}
+
+
+/**
+ * Implements the jpy.diag.trace_clear() method.
+ */
+PyObject* Diag_trace_clear(JPy_Diag* self, PyObject* args)
+{
+    JPy_TraceClear();
+    return Py_BuildValue("");
+}
+
+
+/**
+ * Implements the jpy.diag.trace_dump_on_crash(path) method.
+ */
+PyObject* Diag_trace_dump_on_crash(JPy_Diag* self, PyObject* args)
+{
+    const char* path = NULL;
+
+    if (!PyArg_ParseTuple(args, "z:trace_dump_on_crash", &path)) {
+        return NULL;
+    }
+    if (JPy_TraceSetCrashFile(path) < 0) {
+        return NULL;
+    }
+    return Py_BuildValue("");
+}
+
+
+static PyMethodDef Diag_methods[] =
+{
+    {"stats", (PyCFunction) Diag_stats, METH_NOARGS, "stats() - Returns a dictionary of jpy's runtime counters: Java calls, overload resolutions, types resolved, global references, GIL acquisitions, buffer exports and copies, translated exceptions"},
+    {"profile_report", (PyCFunction) Diag_profile_report, METH_VARARGS, "profile_report(n=20) - Returns a list of dictionaries describing the n Java methods and Python callables with the highest total time recorded while jpy.diag.profiling was enabled. A negative n returns all of them."},
+    {"reset_profile", (PyCFunction) Diag_reset_profile, METH_NOARGS, "reset_profile() - Clears all latency histograms recorded while jpy.diag.profiling was enabled"},
+    {"trace_dump", (PyCFunction) Diag_trace_dump, METH_VARARGS, "trace_dump(path) - Writes the trace events recorded while jpy.diag.tracing was enabled into a binary file that can be decoded using the jpytrace module. Returns the number of events written."},
+    {"trace_clear", (PyCFunction) Diag_trace_clear, METH_NOARGS, "trace_clear() - Discards all recorded trace events"},
+    {"trace_dump_on_crash", (PyCFunction) Diag_trace_dump_on_crash, METH_VARARGS, "trace_dump_on_crash(path) - Dumps the recorded trace events into the given file if the process aborts. None disables the crash dump. Not supported on Windows."},
+    {NULL}  /* Sentinel */
+};
+
+
 static PyMemberDef Diag_members[] =
 {
     {"flags",    T_INT, offsetof(JPy_Diag, flags),   READONLY, "Combination of diagnostic flags (F_* constants). If != 0, diagnostic messages are printed out."},
@@ -125,7 +283,7 @@ PyTypeObject Diag_Type =
     0,                            /* tp_weaklistoffset */
     NULL,                         /* tp_iter */
     NULL,                         /* tp_iternext */
-    NULL,                         /* tp_methods */
+    Diag_methods,                 /* tp_methods */
     Diag_members,                 /* tp_members */
     NULL,                         /* tp_getset */
     NULL,                         /* tp_base */
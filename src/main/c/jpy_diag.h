@@ -58,6 +58,59 @@ void JPy_DiagPrint(int diagFlags, const char * format, ...);
 #define JPy_DIAG_PRINT if (JPy_DiagFlags != 0) JPy_DiagPrint
 
 
+/**
+ * Relaxed atomic operations on 64-bit counters. They are used for the always-on runtime statistics,
+ * which may be updated from any thread, also from Java threads not holding the GIL.
+ * JPy_ATOMIC_CAS is a sequentially consistent compare-and-swap, which evaluates to non-zero on success.
+ */
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define JPy_ATOMIC_ADD(PTR, N) _InterlockedExchangeAdd64((volatile long long*) (PTR), (long long) (N))
+    #define JPy_ATOMIC_GET(PTR)    (*(volatile long long*) (PTR))
+    #define JPy_ATOMIC_CAS(PTR, EXPECTED, DESIRED) \
+        (_InterlockedCompareExchange64((volatile long long*) (PTR), (long long) (DESIRED), (long long) (EXPECTED)) == (long long) (EXPECTED))
+#else
+    #define JPy_ATOMIC_ADD(PTR, N) __atomic_fetch_add((PTR), (long long) (N), __ATOMIC_RELAXED)
+    #define JPy_ATOMIC_GET(PTR)    __atomic_load_n((PTR), __ATOMIC_RELAXED)
+    #define JPy_ATOMIC_CAS(PTR, EXPECTED, DESIRED) \
+        __sync_bool_compare_and_swap((PTR), (long long) (EXPECTED), (long long) (DESIRED))
+#endif
+
+// Make sure the following constants are same as the STAT_* constants in class org.jpy.PyLib.Diag
+#define JPy_STAT_JAVA_CALLS              0
+#define JPy_STAT_OVERLOAD_RESOLUTIONS    1
+#define JPy_STAT_OVERLOAD_CACHE_MISSES   2
+#define JPy_STAT_TYPES_RESOLVED          3
+#define JPy_STAT_GLOBAL_REFS_CREATED     4
+#define JPy_STAT_GLOBAL_REFS_DELETED     5
+#define JPy_STAT_GIL_ACQUISITIONS        6
+#define JPy_STAT_BUFFER_EXPORTS          7
+#define JPy_STAT_BUFFER_BYTES_COPIED     8
+#define JPy_STAT_JAVA_EXCEPTIONS         9
+#define JPy_STAT_PYTHON_EXCEPTIONS      10
+#define JPy_STAT_BUFFER_ACQUISITIONS    11
+#define JPy_STAT_COUNT                  12
+
+/**
+ * The always-on runtime counters, indexed by the JPy_STAT_* constants.
+ * Only modify them using the JPy_STAT_ADD and JPy_STAT_INC macros.
+ */
+extern long long JPy_Stats[JPy_STAT_COUNT];
+
+/**
+ * The names of the runtime counters as used as keys in the dictionary returned by jpy.diag.stats().
+ */
+extern const char* JPy_StatNames[JPy_STAT_COUNT];
+
+#define JPy_STAT_ADD(STAT_ID, N) JPy_ATOMIC_ADD(&JPy_Stats[STAT_ID], N)
+#define JPy_STAT_INC(STAT_ID)    JPy_ATOMIC_ADD(&JPy_Stats[STAT_ID], 1)
+
+/**
+ * Copies a consistent-enough snapshot of all runtime counters into the given array of JPy_STAT_COUNT elements.
+ */
+void JPy_GetStats(long long* stats);
+
+
 #ifdef __cplusplus
 }  /* extern "C" */
 #endif
@@ -17,6 +17,14 @@
 #include "jpy_module.h"
 #include "jpy_diag.h"
 #include "jpy_jarray.h"
+#include "jpy_jtype.h"
+#include "jpy_compat.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
 
 
 #define PRINT_FLAG(F) printf("JArray_GetBufferProc: %s = %d\n", #F, (flags & F) != 0);
@@ -128,6 +136,7 @@ int JArray_GetBufferProc(JPy_JArray* self, Py_buffer* view, int flags, char java
 
     // Step 3/5
     self->bufferExportCount++;
+    JPy_STAT_INC(JPy_STAT_BUFFER_EXPORTS);
 
     // Step 4/5
     view->obj = (PyObject*) self;
@@ -356,3 +365,655 @@ PyBufferProcs JArray_as_buffer_double = {
     (getbufferproc) JArray_getbufferproc_double,
     (releasebufferproc) JArray_releasebufferproc_double
 };
+
+
+/**
+ * Describes a Java primitive array type exchanged with NumPy, see JArray_ToNumPy() and JArray_FromBuffer().
+ * 'kind' is '?' for booleans, 'i' for signed and 'u' for unsigned integers, and 'f' for floating point numbers.
+ */
+typedef struct JArray_PrimitiveInfo
+{
+    char javaType;
+    const char* typeName;
+    const char* dtype;
+    char kind;
+    int itemSize;
+}
+JArray_PrimitiveInfo;
+
+static const JArray_PrimitiveInfo JArray_PrimitiveInfos[] = {
+    {'Z', "boolean", "bool",    '?', 1},
+    {'B', "byte",    "int8",    'i', 1},
+    {'C', "char",    "uint16",  'u', 2},
+    {'S', "short",   "int16",   'i', 2},
+    {'I', "int",     "int32",   'i', 4},
+    {'J', "long",    "int64",   'i', 8},
+    {'F', "float",   "float32", 'f', 4},
+    {'D', "double",  "float64", 'f', 8},
+    {0,   NULL,      NULL,      0,   0}
+};
+
+static const JArray_PrimitiveInfo* JArray_GetPrimitiveInfo(JPy_JType* componentType)
+{
+    const JArray_PrimitiveInfo* info;
+
+    if (componentType == NULL || !componentType->isPrimitive) {
+        return NULL;
+    }
+    for (info = JArray_PrimitiveInfos; info->typeName != NULL; info++) {
+        if (strcmp(componentType->javaName, info->typeName) == 0) {
+            return info;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Returns the kind of the items described by a buffer format (see the 'struct' module), or 0 if the items
+ * are not numbers or not in native byte order.
+ */
+static char JArray_GetFormatKind(const char* format)
+{
+    const int one = 1;
+    int littleEndian = *((const char*) &one) == 1;
+
+    if (format == NULL) {
+        return 'u';
+    }
+    if (*format == '@' || *format == '=' || (*format == '<' && littleEndian) || ((*format == '>' || *format == '!') && !littleEndian)) {
+        format++;
+    }
+    if (format[0] == 0 || format[1] != 0) {
+        return 0;
+    }
+    if (strchr("bhilqn", *format) != NULL) {
+        return 'i';
+    } else if (strchr("BHILQN", *format) != NULL) {
+        return 'u';
+    } else if (strchr("fd", *format) != NULL) {
+        return 'f';
+    } else if (*format == '?') {
+        return '?';
+    }
+    return 0;
+}
+
+/**
+ * Tests if the items of a buffer can be copied into a Java array with the given element type without conversion.
+ * Unsigned bytes (e.g. Python 'bytes') are accepted for Java 'byte' arrays.
+ */
+static int JArray_IsCompatibleFormat(const JArray_PrimitiveInfo* info, char kind, Py_ssize_t itemSize)
+{
+    if (itemSize != info->itemSize) {
+        return 0;
+    }
+    return kind == info->kind || (info->kind == 'i' && info->itemSize == 1 && kind == 'u');
+}
+
+static jarray JArray_NewPrimitiveArray(JNIEnv* jenv, const JArray_PrimitiveInfo* info, jint length)
+{
+    if (info->javaType == 'Z') {
+        return (*jenv)->NewBooleanArray(jenv, length);
+    } else if (info->javaType == 'B') {
+        return (*jenv)->NewByteArray(jenv, length);
+    } else if (info->javaType == 'C') {
+        return (*jenv)->NewCharArray(jenv, length);
+    } else if (info->javaType == 'S') {
+        return (*jenv)->NewShortArray(jenv, length);
+    } else if (info->javaType == 'I') {
+        return (*jenv)->NewIntArray(jenv, length);
+    } else if (info->javaType == 'J') {
+        return (*jenv)->NewLongArray(jenv, length);
+    } else if (info->javaType == 'F') {
+        return (*jenv)->NewFloatArray(jenv, length);
+    } else {
+        return (*jenv)->NewDoubleArray(jenv, length);
+    }
+}
+
+/**
+ * Tests if the items of a buffer can be converted into items of a Java array with the given element type by a C cast,
+ * as done for single Python numbers. Floating point numbers are not converted into integers, and booleans
+ * only into booleans.
+ */
+static int JArray_IsConvertibleFormat(const JArray_PrimitiveInfo* info, char kind, Py_ssize_t itemSize)
+{
+    if (info->kind == '?' || kind == '?' || kind == 0) {
+        return 0;
+    } else if (kind == 'f') {
+        return info->kind == 'f' && (itemSize == 4 || itemSize == 8);
+    }
+    return itemSize == 1 || itemSize == 2 || itemSize == 4 || itemSize == 8;
+}
+
+/*
+ * The conversion loops are plain casts between contiguous arrays, which compilers vectorise.
+ */
+#define JArray_CONVERT_ITEMS(DST_TYPE, SRC_TYPE) \
+    do { \
+        DST_TYPE* dst = (DST_TYPE*) dstItems; \
+        const SRC_TYPE* src = (const SRC_TYPE*) srcItems; \
+        Py_ssize_t i; \
+        for (i = 0; i < count; i++) { \
+            dst[i] = (DST_TYPE) src[i]; \
+        } \
+    } while (0)
+
+#define JArray_CONVERT_ITEMS_FROM(DST_TYPE) \
+    if (srcKind == 'f') { \
+        if (srcItemSize == 4) JArray_CONVERT_ITEMS(DST_TYPE, float); \
+        else JArray_CONVERT_ITEMS(DST_TYPE, double); \
+    } else if (srcKind == 'i') { \
+        if (srcItemSize == 1) JArray_CONVERT_ITEMS(DST_TYPE, int8_t); \
+        else if (srcItemSize == 2) JArray_CONVERT_ITEMS(DST_TYPE, int16_t); \
+        else if (srcItemSize == 4) JArray_CONVERT_ITEMS(DST_TYPE, int32_t); \
+        else JArray_CONVERT_ITEMS(DST_TYPE, int64_t); \
+    } else { \
+        if (srcItemSize == 1) JArray_CONVERT_ITEMS(DST_TYPE, uint8_t); \
+        else if (srcItemSize == 2) JArray_CONVERT_ITEMS(DST_TYPE, uint16_t); \
+        else if (srcItemSize == 4) JArray_CONVERT_ITEMS(DST_TYPE, uint32_t); \
+        else JArray_CONVERT_ITEMS(DST_TYPE, uint64_t); \
+    }
+
+/**
+ * Returns the range of the integral Java element types, so that buffer items are converted only if their values
+ * are preserved. Returns 0 for floating point element types, which all integer items are converted into.
+ */
+static int JArray_GetIntegralRange(const JArray_PrimitiveInfo* info, int64_t* minValue, uint64_t* maxValue)
+{
+    if (info->javaType == 'B') {
+        *minValue = -128;
+        *maxValue = 127;
+    } else if (info->javaType == 'C') {
+        *minValue = 0;
+        *maxValue = 65535;
+    } else if (info->javaType == 'S') {
+        *minValue = -32768;
+        *maxValue = 32767;
+    } else if (info->javaType == 'I') {
+        *minValue = INT32_MIN;
+        *maxValue = INT32_MAX;
+    } else if (info->javaType == 'J') {
+        *minValue = INT64_MIN;
+        *maxValue = INT64_MAX;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+#define JArray_FIND_SIGNED_OUT_OF_RANGE(SRC_TYPE) \
+    do { \
+        const SRC_TYPE* src = (const SRC_TYPE*) srcItems; \
+        Py_ssize_t i; \
+        for (i = 0; i < count; i++) { \
+            if (src[i] < minValue || (src[i] > 0 && (uint64_t) src[i] > maxValue)) { \
+                return i; \
+            } \
+        } \
+    } while (0)
+
+#define JArray_FIND_UNSIGNED_OUT_OF_RANGE(SRC_TYPE) \
+    do { \
+        const SRC_TYPE* src = (const SRC_TYPE*) srcItems; \
+        Py_ssize_t i; \
+        for (i = 0; i < count; i++) { \
+            if (src[i] > maxValue) { \
+                return i; \
+            } \
+        } \
+    } while (0)
+
+/**
+ * Returns the index of the first integer buffer item which is out of the range of the integral Java element type,
+ * or -1 if all items can be converted without changing their values.
+ */
+static Py_ssize_t JArray_FindItemOutOfRange(const JArray_PrimitiveInfo* info, char srcKind, Py_ssize_t srcItemSize, const void* srcItems, Py_ssize_t count)
+{
+    int64_t minValue;
+    uint64_t maxValue;
+
+    if (srcKind == 'f' || !JArray_GetIntegralRange(info, &minValue, &maxValue)) {
+        return -1;
+    }
+    if (srcKind == 'i') {
+        if (srcItemSize == 1) JArray_FIND_SIGNED_OUT_OF_RANGE(int8_t);
+        else if (srcItemSize == 2) JArray_FIND_SIGNED_OUT_OF_RANGE(int16_t);
+        else if (srcItemSize == 4) JArray_FIND_SIGNED_OUT_OF_RANGE(int32_t);
+        else JArray_FIND_SIGNED_OUT_OF_RANGE(int64_t);
+    } else {
+        if (srcItemSize == 1) JArray_FIND_UNSIGNED_OUT_OF_RANGE(uint8_t);
+        else if (srcItemSize == 2) JArray_FIND_UNSIGNED_OUT_OF_RANGE(uint16_t);
+        else if (srcItemSize == 4) JArray_FIND_UNSIGNED_OUT_OF_RANGE(uint32_t);
+        else JArray_FIND_UNSIGNED_OUT_OF_RANGE(uint64_t);
+    }
+    return -1;
+}
+
+static void JArray_ConvertItems(const JArray_PrimitiveInfo* info, void* dstItems, char srcKind, Py_ssize_t srcItemSize, const void* srcItems, Py_ssize_t count)
+{
+    if (info->javaType == 'B') {
+        JArray_CONVERT_ITEMS_FROM(jbyte)
+    } else if (info->javaType == 'C') {
+        JArray_CONVERT_ITEMS_FROM(jchar)
+    } else if (info->javaType == 'S') {
+        JArray_CONVERT_ITEMS_FROM(jshort)
+    } else if (info->javaType == 'I') {
+        JArray_CONVERT_ITEMS_FROM(jint)
+    } else if (info->javaType == 'J') {
+        JArray_CONVERT_ITEMS_FROM(jlong)
+    } else if (info->javaType == 'F') {
+        JArray_CONVERT_ITEMS_FROM(jfloat)
+    } else if (info->javaType == 'D') {
+        JArray_CONVERT_ITEMS_FROM(jdouble)
+    }
+}
+
+int JArray_FromBuffer(JNIEnv* jenv, JPy_JType* componentType, PyObject* pyArg, jarray* arrayRef)
+{
+    const JArray_PrimitiveInfo* info;
+    Py_buffer view;
+    char kind;
+    int convert;
+    jint itemCount;
+    void* srcItems;
+    void* items;
+
+    *arrayRef = NULL;
+
+    if (!PyObject_CheckBuffer(pyArg)) {
+        return 0;
+    }
+    if (PyObject_GetBuffer(pyArg, &view, PyBUF_RECORDS_RO) < 0) {
+        PyErr_Clear();
+        return 0;
+    }
+
+    kind = JArray_GetFormatKind(view.format);
+    if (componentType != NULL) {
+        info = JArray_GetPrimitiveInfo(componentType);
+    } else {
+        // Infer the Java element type from the buffer's format
+        for (info = JArray_PrimitiveInfos; info->typeName != NULL; info++) {
+            if (JArray_IsCompatibleFormat(info, kind, view.itemsize)) {
+                break;
+            }
+        }
+        if (info->typeName == NULL) {
+            info = NULL;
+        }
+    }
+    // 0-dimensional buffers, e.g. NumPy scalars, are single numbers rather than arrays
+    if (info == NULL || view.ndim != 1) {
+        PyBuffer_Release(&view);
+        return 0;
+    }
+    if (JArray_IsCompatibleFormat(info, kind, view.itemsize)) {
+        convert = 0;
+    } else if (JArray_IsConvertibleFormat(info, kind, view.itemsize)) {
+        convert = 1;
+    } else {
+        PyBuffer_Release(&view);
+        return 0;
+    }
+
+    if (view.len / view.itemsize > 0x7fffffff) {
+        PyBuffer_Release(&view);
+        PyErr_SetString(PyExc_OverflowError, "buffer too large for a Java array");
+        return -1;
+    }
+    itemCount = (jint) (view.len / view.itemsize);
+
+    // A strided view, e.g. a sliced NumPy array, must be gathered first if its items are converted
+    srcItems = view.buf;
+    if (convert && itemCount > 0 && !PyBuffer_IsContiguous(&view, 'C')) {
+        srcItems = PyMem_Malloc(view.len);
+        if (srcItems == NULL) {
+            PyBuffer_Release(&view);
+            PyErr_NoMemory();
+            return -1;
+        }
+        if (PyBuffer_ToContiguous(srcItems, &view, view.len, 'C') < 0) {
+            PyMem_Free(srcItems);
+            PyBuffer_Release(&view);
+            return -1;
+        }
+    }
+
+    if (convert) {
+        Py_ssize_t index = JArray_FindItemOutOfRange(info, kind, view.itemsize, srcItems, itemCount);
+        if (index >= 0) {
+            if (srcItems != view.buf) {
+                PyMem_Free(srcItems);
+            }
+            PyBuffer_Release(&view);
+            PyErr_Format(PyExc_OverflowError, "buffer item %zd is out of the range of Java '%s'", index, info->typeName);
+            return -1;
+        }
+    }
+
+    *arrayRef = JArray_NewPrimitiveArray(jenv, info, itemCount);
+    if (*arrayRef == NULL || (*jenv)->ExceptionCheck(jenv)) {
+        if (srcItems != view.buf) {
+            PyMem_Free(srcItems);
+        }
+        PyBuffer_Release(&view);
+        JPy_HandleJavaException(jenv);
+        return -1;
+    }
+    if (itemCount > 0) {
+        items = (*jenv)->GetPrimitiveArrayCritical(jenv, *arrayRef, NULL);
+        if (items == NULL) {
+            if (srcItems != view.buf) {
+                PyMem_Free(srcItems);
+            }
+            PyBuffer_Release(&view);
+            (*jenv)->DeleteLocalRef(jenv, *arrayRef);
+            *arrayRef = NULL;
+            PyErr_NoMemory();
+            return -1;
+        }
+        if (convert) {
+            JArray_ConvertItems(info, items, kind, view.itemsize, srcItems, itemCount);
+        } else if (PyBuffer_IsContiguous(&view, 'C')) {
+            memcpy(items, view.buf, view.len);
+        } else if (PyBuffer_ToContiguous(items, &view, view.len, 'C') < 0) {
+            (*jenv)->ReleasePrimitiveArrayCritical(jenv, *arrayRef, items, JNI_ABORT);
+            PyBuffer_Release(&view);
+            (*jenv)->DeleteLocalRef(jenv, *arrayRef);
+            *arrayRef = NULL;
+            return -1;
+        }
+        (*jenv)->ReleasePrimitiveArrayCritical(jenv, *arrayRef, items, 0);
+        JPy_STAT_ADD(JPy_STAT_BUFFER_BYTES_COPIED, view.len);
+    }
+
+    if (srcItems != view.buf) {
+        PyMem_Free(srcItems);
+    }
+    PyBuffer_Release(&view);
+    return 1;
+}
+
+PyObject* JArray_ToNumPy(JNIEnv* jenv, JPy_JArray* self, int copy)
+{
+    const JArray_PrimitiveInfo* info;
+    PyObject* numpy;
+    PyObject* result;
+    Py_buffer view;
+    jint itemCount;
+    void* items;
+
+    info = JArray_GetPrimitiveInfo(((JPy_JType*) Py_TYPE(self))->componentType);
+    if (info == NULL) {
+        PyErr_Format(PyExc_ValueError, "to_numpy: expected a Java primitive array, got a '%s'", Py_TYPE(self)->tp_name);
+        return NULL;
+    }
+
+    numpy = PyImport_ImportModule("numpy");
+    if (numpy == NULL) {
+        return NULL;
+    }
+
+    if (!copy) {
+        // The NumPy array views the buffer exported by the Java array, see JArray_GetBufferProc()
+        result = PyObject_CallMethod(numpy, "frombuffer", "Os", self, info->dtype);
+        Py_DECREF(numpy);
+        return result;
+    }
+
+    itemCount = (*jenv)->GetArrayLength(jenv, self->objectRef);
+    result = PyObject_CallMethod(numpy, "empty", "ns", (Py_ssize_t) itemCount, info->dtype);
+    Py_DECREF(numpy);
+    if (result == NULL) {
+        return NULL;
+    }
+    if (itemCount == 0) {
+        return result;
+    }
+
+    if (PyObject_GetBuffer(result, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    items = (*jenv)->GetPrimitiveArrayCritical(jenv, self->objectRef, NULL);
+    if (items == NULL) {
+        PyBuffer_Release(&view);
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+    memcpy(view.buf, items, (size_t) itemCount * info->itemSize);
+    (*jenv)->ReleasePrimitiveArrayCritical(jenv, self->objectRef, items, JNI_ABORT);
+    JPy_STAT_ADD(JPy_STAT_BUFFER_BYTES_COPIED, (size_t) itemCount * info->itemSize);
+    PyBuffer_Release(&view);
+
+    return result;
+}
+
+
+jarray JArray_NewPrimitive(JNIEnv* jenv, JPy_JType* componentType, jint length)
+{
+    const JArray_PrimitiveInfo* info = JArray_GetPrimitiveInfo(componentType);
+    if (info == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "internal error: illegal primitive Java type");
+        return NULL;
+    }
+    return JArray_NewPrimitiveArray(jenv, info, length);
+}
+
+
+#define JArray_SCRATCH_POOL_CAPACITY 8
+
+/**
+ * The scratch arrays of a single thread. Pools are never freed: when their thread terminates,
+ * they are released and later reused by new threads, together with the arrays they hold.
+ * The arrays themselves are deleted by JArray_ClearScratchPools().
+ */
+typedef struct JArray_ScratchPool
+{
+    // Next pool in the registry.
+    struct JArray_ScratchPool* next;
+    // Non-zero while the pool is owned by a thread.
+    volatile long inUse;
+    int count;
+    JPy_JType* componentTypes[JArray_SCRATCH_POOL_CAPACITY];
+    jint lengths[JArray_SCRATCH_POOL_CAPACITY];
+    // Non-zero while the array is passed to a Java method.
+    jboolean taken[JArray_SCRATCH_POOL_CAPACITY];
+    // Global references.
+    jarray arrays[JArray_SCRATCH_POOL_CAPACITY];
+}
+JArray_ScratchPool;
+
+// Head of the list of all pools ever allocated, guarded by the GIL (JPy_BEGIN_GLOBAL_LOCK in free-threaded builds).
+static JArray_ScratchPool* JArray_ScratchPools = NULL;
+
+
+#if defined(_WIN32)
+
+static DWORD JArray_ScratchPoolKey = FLS_OUT_OF_INDEXES;
+static INIT_ONCE JArray_ScratchPoolKeyOnce = INIT_ONCE_STATIC_INIT;
+
+static VOID WINAPI JArray_ReleaseScratchPool(PVOID pool)
+{
+    if (pool != NULL) {
+        ((JArray_ScratchPool*) pool)->inUse = 0;
+    }
+}
+
+static BOOL CALLBACK JArray_CreateScratchPoolKey(PINIT_ONCE initOnce, PVOID parameter, PVOID* context)
+{
+    JArray_ScratchPoolKey = FlsAlloc(JArray_ReleaseScratchPool);
+    return TRUE;
+}
+
+#define JArray_INIT_SCRATCH_POOL_KEY()      InitOnceExecuteOnce(&JArray_ScratchPoolKeyOnce, JArray_CreateScratchPoolKey, NULL, NULL)
+#define JArray_SCRATCH_POOL_KEY_VALID()     (JArray_ScratchPoolKey != FLS_OUT_OF_INDEXES)
+#define JArray_GET_SCRATCH_POOL()           ((JArray_ScratchPool*) FlsGetValue(JArray_ScratchPoolKey))
+#define JArray_SET_SCRATCH_POOL(POOL)       FlsSetValue(JArray_ScratchPoolKey, (POOL))
+
+#else
+
+static pthread_key_t JArray_ScratchPoolKey;
+static int JArray_ScratchPoolKeyValid = 0;
+static pthread_once_t JArray_ScratchPoolKeyOnce = PTHREAD_ONCE_INIT;
+
+static void JArray_ReleaseScratchPool(void* pool)
+{
+    if (pool != NULL) {
+        ((JArray_ScratchPool*) pool)->inUse = 0;
+    }
+}
+
+static void JArray_CreateScratchPoolKey(void)
+{
+    JArray_ScratchPoolKeyValid = pthread_key_create(&JArray_ScratchPoolKey, JArray_ReleaseScratchPool) == 0;
+}
+
+#define JArray_INIT_SCRATCH_POOL_KEY()      pthread_once(&JArray_ScratchPoolKeyOnce, JArray_CreateScratchPoolKey)
+#define JArray_SCRATCH_POOL_KEY_VALID()     JArray_ScratchPoolKeyValid
+#define JArray_GET_SCRATCH_POOL()           ((JArray_ScratchPool*) pthread_getspecific(JArray_ScratchPoolKey))
+#define JArray_SET_SCRATCH_POOL(POOL)       pthread_setspecific(JArray_ScratchPoolKey, (POOL))
+
+#endif
+
+
+/**
+ * Returns the calling thread's pool, takes over a released one or allocates a new one on first use.
+ * Returns NULL if thread-specific storage is not available.
+ */
+static JArray_ScratchPool* JArray_GetScratchPool(void)
+{
+    JArray_ScratchPool* pool;
+
+    JArray_INIT_SCRATCH_POOL_KEY();
+    if (!JArray_SCRATCH_POOL_KEY_VALID()) {
+        return NULL;
+    }
+
+    pool = JArray_GET_SCRATCH_POOL();
+    if (pool != NULL) {
+        return pool;
+    }
+
+    JPy_BEGIN_GLOBAL_LOCK
+    for (pool = JArray_ScratchPools; pool != NULL; pool = pool->next) {
+        if (pool->inUse == 0) {
+            break;
+        }
+    }
+    if (pool == NULL) {
+        pool = (JArray_ScratchPool*) calloc(1, sizeof (JArray_ScratchPool));
+        if (pool != NULL) {
+            pool->next = JArray_ScratchPools;
+            JArray_ScratchPools = pool;
+        }
+    }
+    if (pool != NULL) {
+        pool->inUse = 1;
+    }
+    JPy_END_GLOBAL_LOCK
+
+    if (pool != NULL) {
+        JArray_SET_SCRATCH_POOL(pool);
+    }
+    return pool;
+}
+
+jarray JArray_TakeScratchArray(JNIEnv* jenv, JPy_JType* componentType, jint length)
+{
+    JArray_ScratchPool* pool;
+    jarray localRef;
+    jarray globalRef;
+    int i;
+
+    pool = JArray_GetScratchPool();
+    if (pool != NULL) {
+        for (i = 0; i < pool->count; i++) {
+            if (!pool->taken[i] && pool->componentTypes[i] == componentType && pool->lengths[i] == length) {
+                pool->taken[i] = JNI_TRUE;
+                JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "JArray_TakeScratchArray: reusing array=%p, length=%d\n", pool->arrays[i], length);
+                return pool->arrays[i];
+            }
+        }
+    }
+
+    localRef = JArray_NewPrimitive(jenv, componentType, length);
+    if (localRef == NULL) {
+        if (!PyErr_Occurred()) {
+            PyErr_NoMemory();
+        }
+        return NULL;
+    }
+    globalRef = (*jenv)->NewGlobalRef(jenv, localRef);
+    (*jenv)->DeleteLocalRef(jenv, localRef);
+    if (globalRef == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_CREATED);
+
+    if (pool != NULL) {
+        if (pool->count < JArray_SCRATCH_POOL_CAPACITY) {
+            i = pool->count++;
+        } else {
+            // Evict an array not passed to any pending call, if there is one
+            for (i = 0; i < pool->count && pool->taken[i]; i++) {
+            }
+            if (i < pool->count) {
+                (*jenv)->DeleteGlobalRef(jenv, pool->arrays[i]);
+                JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
+            }
+        }
+        if (i < pool->count) {
+            pool->componentTypes[i] = componentType;
+            pool->lengths[i] = length;
+            pool->taken[i] = JNI_TRUE;
+            pool->arrays[i] = globalRef;
+        }
+    }
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "JArray_TakeScratchArray: created array=%p, length=%d\n", globalRef, length);
+    return globalRef;
+}
+
+void JArray_ReleaseScratchArray(JNIEnv* jenv, jarray jArray)
+{
+    JArray_ScratchPool* pool;
+    int i;
+
+    pool = JArray_SCRATCH_POOL_KEY_VALID() ? JArray_GET_SCRATCH_POOL() : NULL;
+    if (pool != NULL) {
+        for (i = 0; i < pool->count; i++) {
+            if (pool->arrays[i] == jArray && pool->taken[i]) {
+                pool->taken[i] = JNI_FALSE;
+                return;
+            }
+        }
+    }
+
+    // Not pooled, because the pool was full of pending arrays
+    (*jenv)->DeleteGlobalRef(jenv, jArray);
+    JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
+}
+
+void JArray_ClearScratchPools(JNIEnv* jenv)
+{
+    JArray_ScratchPool* pool;
+    int i;
+
+    JPy_BEGIN_GLOBAL_LOCK
+    for (pool = JArray_ScratchPools; pool != NULL; pool = pool->next) {
+        for (i = 0; i < pool->count; i++) {
+            // Arrays passed to a pending call are deleted by JArray_ReleaseScratchArray(), which won't find them anymore
+            if (jenv != NULL && !pool->taken[i]) {
+                (*jenv)->DeleteGlobalRef(jenv, pool->arrays[i]);
+                JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
+            }
+            pool->componentTypes[i] = NULL;
+            pool->arrays[i] = NULL;
+        }
+        pool->count = 0;
+    }
+    JPy_END_GLOBAL_LOCK
+}
@@ -34,6 +34,7 @@ typedef struct JPy_JArray
 {
     PyObject_HEAD
     jobject objectRef;
+    Py_ssize_t hash;
     jint bufferExportCount;
 }
 JPy_JArray;
@@ -47,6 +48,46 @@ extern PyBufferProcs JArray_as_buffer_long;
 extern PyBufferProcs JArray_as_buffer_float;
 extern PyBufferProcs JArray_as_buffer_double;
 
+/**
+ * Creates a Java primitive array from the contents of an object supporting the buffer protocol (e.g. a NumPy array)
+ * using a single memory copy, or a single conversion loop if the buffer's items are numbers of another type.
+ * If 'componentType' is NULL, it is derived from the buffer's item format.
+ * Returns 1 on success, 0 without an error set if the buffer's items cannot be used directly
+ * (no buffer, more than one dimension, or items not convertible by a C cast), and -1 on error.
+ */
+int JArray_FromBuffer(JNIEnv* jenv, struct JPy_JType* componentType, PyObject* pyArg, jarray* arrayRef);
+
+/**
+ * Creates a new primitive Java array with the given component type and length.
+ * Returns a local reference, or NULL on failure.
+ */
+jarray JArray_NewPrimitive(JNIEnv* jenv, struct JPy_JType* componentType, jint length);
+
+/**
+ * Takes a primitive Java array with the given component type and length from the calling thread's pool of
+ * scratch arrays, or creates one if there is none available. The items of a reused array are not cleared.
+ * Returns a global reference, which must be given back using JArray_ReleaseScratchArray() on the same thread
+ * once the Java call it is passed to has returned. Returns NULL with an error set on failure.
+ */
+jarray JArray_TakeScratchArray(JNIEnv* jenv, struct JPy_JType* componentType, jint length);
+
+/**
+ * Gives back an array obtained from JArray_TakeScratchArray() to the calling thread's pool.
+ */
+void JArray_ReleaseScratchArray(JNIEnv* jenv, jarray jArray);
+
+/**
+ * Deletes the global references to the arrays held by the scratch array pools of all threads.
+ * 'jenv' may be NULL if the JVM is already gone.
+ */
+void JArray_ClearScratchPools(JNIEnv* jenv);
+
+/**
+ * Returns a NumPy array holding the items of a Java primitive array. If 'copy' is zero, the NumPy array views
+ * the buffer exported by the Java array, which is the Java array's memory itself if the JVM supports pinning.
+ */
+PyObject* JArray_ToNumPy(JNIEnv* jenv, JPy_JArray* self, int copy);
+
 #ifdef __cplusplus
 }  /* extern "C" */
 #endif
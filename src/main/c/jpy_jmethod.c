@@ -22,6 +22,8 @@
 #include "jpy_jobj.h"
 #include "jpy_jmethod.h"
 #include "jpy_conv.h"
+#include "jpy_prof.h"
+#include "jpy_trace.h"
 #include "jpy_compat.h"
 
 
@@ -46,6 +48,8 @@ JPy_JMethod* JMethod_New(JPy_JType* declaringClass,
     method->isStatic = isStatic;
     method->isVarArgs = isVarArgs;
     method->mid = mid;
+    method->callCount = 0;
+    method->profile = NULL;
 
     Py_INCREF(declaringClass);
     Py_INCREF(method->name);
@@ -84,6 +88,66 @@ void JMethod_Del(JPy_JMethod* method)
     JMethod_dealloc(method);
 }
 
+/**
+ * Returns a new, PyMem_Malloc'ed name of the form "<class>#<method>(<param-types>)" identifying the given method overload.
+ * Returns NULL and sets a Python error if memory allocation fails.
+ */
+char* JMethod_GetSignatureName(JPy_JMethod* method)
+{
+    const char* methodName;
+    char* signatureName;
+    size_t nameLength;
+    int i;
+
+    methodName = JPy_AS_UTF8(method->name);
+    nameLength = strlen(method->declaringClass->javaName) + strlen(methodName) + 3;
+    for (i = 0; i < method->paramCount; i++) {
+        nameLength += strlen(method->paramDescriptors[i].type->javaName) + 1;
+    }
+
+    signatureName = PyMem_Malloc(nameLength + 1);
+    if (signatureName == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    strcpy(signatureName, method->declaringClass->javaName);
+    strcat(signatureName, "#");
+    strcat(signatureName, methodName);
+    strcat(signatureName, "(");
+    for (i = 0; i < method->paramCount; i++) {
+        if (i > 0) {
+            strcat(signatureName, ",");
+        }
+        strcat(signatureName, method->paramDescriptors[i].type->javaName);
+    }
+    strcat(signatureName, ")");
+
+    return signatureName;
+}
+
+/**
+ * Returns the latency profile of the given method, creates it on first use.
+ * Profiles are named after the method's signature name, so overloads are profiled separately.
+ * Returns NULL and sets a Python error if the profile cannot be created.
+ */
+JPy_CallProfile* JMethod_GetProfile(JPy_JMethod* method)
+{
+    char* profileName;
+
+    if (method->profile != NULL) {
+        return method->profile;
+    }
+
+    profileName = JMethod_GetSignatureName(method);
+    if (profileName == NULL) {
+        return NULL;
+    }
+    method->profile = JPy_GetCallProfile(JPy_PROF_KIND_JAVA, profileName);
+    PyMem_Free(profileName);
+
+    return method->profile;
+}
+
 /**
  * Matches the give Python argument tuple against the Java method's formal parameters.
  * Returns the sum of the i-th argument against the i-th Java parameter.
@@ -239,6 +303,9 @@ PyObject* JMethod_FromJObject(JNIEnv* jenv, JPy_JMethod* method, PyObject* pyArg
     return JPy_FromJObjectWithType(jenv, jReturnValue, returnType);
 }
 
+// Takes the timestamp after the JNI call, if the current call is being profiled.
+#define JMethod_PROFILE_STAMP(T) if (profile != NULL) (T) = JPy_GetNanos()
+
 /**
  * Invoke a method. We have already ensured that the Python arguments and expected Java parameters match.
  */
@@ -250,12 +317,32 @@ PyObject* JMethod_InvokeMethod(JNIEnv* jenv, JPy_JMethod* method, PyObject* pyAr
     JPy_JType* declaringClass;
     JPy_JType* returnType;
     jclass classRef;
+    JPy_CallProfile* profile;
+    long long t0 = 0, t1 = 0, t2 = 0;
+    long long traceStart;
+
+    JPy_STAT_INC(JPy_STAT_JAVA_CALLS);
+    JPy_ATOMIC_ADD(&method->callCount, 1);
+    traceStart = JPy_TRACE_BEGIN();
+
+    profile = NULL;
+    if (JPy_ProfilingEnabled) {
+        profile = JMethod_GetProfile(method);
+        if (profile == NULL) {
+            return NULL;
+        }
+        t0 = JPy_GetNanos();
+    }
 
     //printf("JMethod_InvokeMethod 1: typeCode=%c\n", typeCode);
     if (JMethod_CreateJArgs(jenv, method, pyArgs, &jArgs, &argDisposers, isVarArgsArray) < 0) {
         return NULL;
     }
 
+    if (profile != NULL) {
+        t1 = JPy_GetNanos();
+    }
+
     //printf("JMethod_InvokeMethod 2: typeCode=%c\n", typeCode);
 
     returnType = method->returnDescriptor->type;
@@ -270,47 +357,58 @@ PyObject* JMethod_InvokeMethod(JNIEnv* jenv, JPy_JMethod* method, PyObject* pyAr
         if (returnType == JPy_JVoid) {
             (*jenv)->CallStaticVoidMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JVOID();
         } else if (returnType == JPy_JBoolean) {
             jboolean v = (*jenv)->CallStaticBooleanMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JBOOLEAN(v);
         } else if (returnType == JPy_JChar) {
             jchar v = (*jenv)->CallStaticCharMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JCHAR(v);
         } else if (returnType == JPy_JByte) {
             jbyte v = (*jenv)->CallStaticByteMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JBYTE(v);
         } else if (returnType == JPy_JShort) {
             jshort v = (*jenv)->CallStaticShortMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JSHORT(v);
         } else if (returnType == JPy_JInt) {
             jint v = (*jenv)->CallStaticIntMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JINT(v);
         } else if (returnType == JPy_JLong) {
             jlong v = (*jenv)->CallStaticLongMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JLONG(v);
         } else if (returnType == JPy_JFloat) {
             jfloat v = (*jenv)->CallStaticFloatMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JFLOAT(v);
         } else if (returnType == JPy_JDouble) {
             jdouble v = (*jenv)->CallStaticDoubleMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JDOUBLE(v);
         } else if (returnType == JPy_JString) {
             jstring v = (*jenv)->CallStaticObjectMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FromJString(jenv, v);
             (*jenv)->DeleteLocalRef(jenv, v);
         } else {
             jobject v = (*jenv)->CallStaticObjectMethodA(jenv, classRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JMethod_FromJObject(jenv, method, pyArgs, jArgs, 0, returnType, v);
             (*jenv)->DeleteLocalRef(jenv, v);
         }
@@ -328,47 +426,58 @@ PyObject* JMethod_InvokeMethod(JNIEnv* jenv, JPy_JMethod* method, PyObject* pyAr
         if (returnType == JPy_JVoid) {
             (*jenv)->CallVoidMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JVOID();
         } else if (returnType == JPy_JBoolean) {
             jboolean v = (*jenv)->CallBooleanMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JBOOLEAN(v);
         } else if (returnType == JPy_JChar) {
             jchar v = (*jenv)->CallCharMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JCHAR(v);
         } else if (returnType == JPy_JByte) {
             jbyte v = (*jenv)->CallByteMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JBYTE(v);
         } else if (returnType == JPy_JShort) {
             jshort v = (*jenv)->CallShortMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JSHORT(v);
         } else if (returnType == JPy_JInt) {
             jint v = (*jenv)->CallIntMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JINT(v);
         } else if (returnType == JPy_JLong) {
             jlong v = (*jenv)->CallLongMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JLONG(v);
         } else if (returnType == JPy_JFloat) {
             jfloat v = (*jenv)->CallFloatMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JFLOAT(v);
         } else if (returnType == JPy_JDouble) {
             jdouble v = (*jenv)->CallDoubleMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FROM_JDOUBLE(v);
         } else if (returnType == JPy_JString) {
             jstring v = (*jenv)->CallObjectMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JPy_FromJString(jenv, v);
             (*jenv)->DeleteLocalRef(jenv, v);
         } else {
             jobject v = (*jenv)->CallObjectMethodA(jenv, objectRef, method->mid, jArgs);
             JPy_ON_JAVA_EXCEPTION_GOTO(error);
+            JMethod_PROFILE_STAMP(t2);
             returnValue = JMethod_FromJObject(jenv, method, pyArgs, jArgs, 1, returnType, v);
             (*jenv)->DeleteLocalRef(jenv, v);
         }
@@ -379,6 +488,12 @@ error:
         JMethod_DisposeJArgs(jenv, method->paramCount, jArgs, argDisposers);
     }
 
+    if (profile != NULL && returnValue != NULL) {
+        JPy_RecordCall(profile, t0, t1, t2, JPy_GetNanos());
+    }
+
+    JPy_TRACE_END(traceStart, JPy_TRACE_JAVA_CALL, method, method->paramCount);
+
     return returnValue;
 }
 
@@ -517,6 +632,7 @@ static PyMemberDef JMethod_members[] =
     {"name",        T_OBJECT_EX, offsetof(JPy_JMethod, name),       READONLY, "Method name"},
     {"param_count", T_INT,       offsetof(JPy_JMethod, paramCount), READONLY, "Number of method parameters"},
     {"is_static",   T_BOOL,      offsetof(JPy_JMethod, isStatic),   READONLY, "Tests if this is a static method"},
+    {"call_count",  T_LONGLONG,  offsetof(JPy_JMethod, callCount),  READONLY, "Number of times this method has been invoked"},
     {NULL}  /* Sentinel */
 };
 
@@ -633,6 +749,37 @@ PyObject* JMethod_set_param_return(JPy_JMethod* self, PyObject* args)
     return Py_BuildValue("");
 }
 
+PyObject* JMethod_is_param_pooled(JPy_JMethod* self, PyObject* args)
+{
+    int index = 0;
+    int value = 0;
+    if (!PyArg_ParseTuple(args, "i:is_param_pooled", &index)) {
+        return NULL;
+    }
+    JMethod_CHECK_PARAMETER_INDEX(self, index);
+    value = self->paramDescriptors[index].isPooled;
+    return PyBool_FromLong(value);
+}
+
+PyObject* JMethod_set_param_pooled(JPy_JMethod* self, PyObject* args)
+{
+    int index = 0;
+    int value = 0;
+#if defined(JPY_COMPAT_33P)
+    if (!PyArg_ParseTuple(args, "ip:set_param_pooled", &index, &value)) {
+#elif defined(JPY_COMPAT_27)
+    if (!PyArg_ParseTuple(args, "ii:set_param_pooled", &index, &value)) {
+#else
+#error JPY_VERSION_ERROR
+#endif
+        return NULL;
+    }
+    JMethod_CHECK_PARAMETER_INDEX(self, index);
+    self->paramDescriptors[index].isPooled = value;
+    return Py_BuildValue("");
+}
+
+
 
 static PyMethodDef JMethod_methods[] =
 {
@@ -640,9 +787,11 @@ static PyMethodDef JMethod_methods[] =
     {"is_param_mutable",  (PyCFunction) JMethod_is_param_mutable,  METH_VARARGS, "Tests if the method parameter given by index is mutable"},
     {"is_param_output",   (PyCFunction) JMethod_is_param_output,   METH_VARARGS, "Tests if the method parameter given by index is a mere output value (and not read from)"},
     {"is_param_return",   (PyCFunction) JMethod_is_param_return,   METH_VARARGS, "Tests if the method parameter given by index is the return value"},
+    {"is_param_pooled",   (PyCFunction) JMethod_is_param_pooled,   METH_VARARGS, "Tests if a buffer passed for the method parameter given by index may be copied into a pooled Java array"},
     {"set_param_mutable", (PyCFunction) JMethod_set_param_mutable, METH_VARARGS, "Sets whether the method parameter given by index is mutable"},
     {"set_param_output",  (PyCFunction) JMethod_set_param_output,  METH_VARARGS, "Sets whether the method parameter given by index is a mere output value (and not read from)"},
     {"set_param_return",  (PyCFunction) JMethod_set_param_return,  METH_VARARGS, "Sets whether the method parameter given by index is the return value"},
+    {"set_param_pooled",  (PyCFunction) JMethod_set_param_pooled,  METH_VARARGS, "Sets whether a buffer passed for the method parameter given by index may be copied into a pooled Java array"},
     {NULL}  /* Sentinel */
 };
 
@@ -702,92 +851,417 @@ typedef struct JPy_MethodFindResult
 }
 JPy_MethodFindResult;
 
-JPy_JMethod* JOverloadedMethod_FindMethod0(JNIEnv* jenv, JPy_JOverloadedMethod* overloadedMethod, PyObject* pyArgs, JPy_MethodFindResult* result)
+/**
+ * Decision table of an overloaded method. It buckets the overloads by the number of Python arguments they accept
+ * (including 'self'). A table may also hold the overloads inherited from the super classes of the declaring class,
+ * which are then assigned to the level of the class hierarchy they are declared in.
+ */
+typedef struct JPy_OverloadDispatch
+{
+    // The largest fixed argument count. Greater argument counts use the last bucket, which only holds varargs methods.
+    int maxArgCount;
+    // Start index of each of the maxArgCount + 2 buckets in candidates, followed by the total candidate count.
+    int* bucketStarts;
+    // The overloads of each bucket, ordered by level and then as in the methodList of their level (borrowed references).
+    JPy_JMethod** candidates;
+    // The level of each candidate, 0 being the declaring class of the overloaded method.
+    int* candidateLevels;
+}
+JPy_OverloadDispatch;
+
+/**
+ * Returns the least number of Python arguments (including 'self') the method accepts.
+ */
+static int JMethod_GetMinArgCount(JPy_JMethod* method)
+{
+    return method->paramCount + (method->isStatic ? 0 : 1) - (method->isVarArgs ? 1 : 0);
+}
+
+static int JMethod_AcceptsArgCount(JPy_JMethod* method, int argCount)
+{
+    int minArgCount = JMethod_GetMinArgCount(method);
+    return method->isVarArgs ? argCount >= minArgCount : argCount == minArgCount;
+}
+
+/**
+ * Checks the kinds of the fixed arguments against the parameter's argKinds. Returns 0 if JMethod_MatchPyArgs
+ * would certainly return 0, or 1 if the method must be scored. The argument count must already be accepted.
+ */
+static int JMethod_MayMatchPyArgs(JPy_JMethod* method, PyObject* pyArgs)
+{
+    int fixedParamCount;
+    int i0;
+    int i;
+
+    i0 = 0;
+    if (!method->isStatic) {
+        if (!JObj_Check(PyTuple_GET_ITEM(pyArgs, 0))) {
+            return 0;
+        }
+        i0 = 1;
+    }
+    fixedParamCount = method->isVarArgs ? method->paramCount - 1 : method->paramCount;
+    for (i = 0; i < fixedParamCount; i++) {
+        if ((method->paramDescriptors[i].argKinds & JType_GetArgKind(PyTuple_GET_ITEM(pyArgs, i0 + i))) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Returns 1 if the methods have the same parameter types, i.e. if one overrides the other.
+ */
+static int JMethod_HasSameParamTypes(JPy_JMethod* method1, JPy_JMethod* method2)
 {
-    Py_ssize_t overloadCount;
-    Py_ssize_t argCount;
-    int matchCount;
-    int matchValue;
-    int matchValueMax;
-    JPy_JMethod* currMethod;
-    JPy_JMethod* bestMethod;
     int i;
-    int currentIsVarArgsArray;
-    int bestIsVarArgsArray;
 
-    result->method = NULL;
-    result->matchValue = 0;
-    result->matchCount = 0;
+    if (method1->paramCount != method2->paramCount || method1->isStatic != method2->isStatic) {
+        return 0;
+    }
+    for (i = 0; i < method1->paramCount; i++) {
+        if (method1->paramDescriptors[i].type != method2->paramDescriptors[i].type) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void JOverloadedMethod_FreeDispatch(JPy_OverloadDispatch* dispatch)
+{
+    if (dispatch != NULL) {
+        PyMem_Free(dispatch->bucketStarts);
+        PyMem_Free(dispatch->candidates);
+        PyMem_Free(dispatch->candidateLevels);
+        PyMem_Free(dispatch);
+    }
+}
+
+/**
+ * Creates a dispatch table for the given methods, which must be ordered by level. methodLevels may be NULL,
+ * if all methods are of level 0.
+ */
+static JPy_OverloadDispatch* JOverloadedMethod_NewDispatch(JPy_JMethod** methods, const int* methodLevels, int methodCount)
+{
+    JPy_OverloadDispatch* dispatch;
+    int bucketCount;
+    int candidateCount;
+    int argCount;
+    int i;
 
-    overloadCount = PyList_Size(overloadedMethod->methodList);
-    if (overloadCount <= 0) {
-        PyErr_SetString(PyExc_RuntimeError, "internal error: invalid overloadedMethod->methodList");
+    dispatch = PyMem_New(JPy_OverloadDispatch, 1);
+    if (dispatch == NULL) {
+        PyErr_NoMemory();
         return NULL;
     }
+    dispatch->maxArgCount = 0;
+    for (i = 0; i < methodCount; i++) {
+        if (JMethod_GetMinArgCount(methods[i]) > dispatch->maxArgCount) {
+            dispatch->maxArgCount = JMethod_GetMinArgCount(methods[i]);
+        }
+    }
+    bucketCount = dispatch->maxArgCount + 2;
 
-    argCount = PyTuple_Size(pyArgs);
-    matchCount = 0;
-    matchValueMax = -1;
-    bestMethod = NULL;
-    bestIsVarArgsArray = 0;
+    candidateCount = 0;
+    for (argCount = 0; argCount < bucketCount; argCount++) {
+        for (i = 0; i < methodCount; i++) {
+            if (JMethod_AcceptsArgCount(methods[i], argCount)) {
+                candidateCount++;
+            }
+        }
+    }
 
-    JPy_DIAG_PRINT(JPy_DIAG_F_METH, "JOverloadedMethod_FindMethod0: method '%s#%s': overloadCount=%d, argCount=%d\n",
-                              overloadedMethod->declaringClass->javaName, JPy_AS_UTF8(overloadedMethod->name), overloadCount, argCount);
+    dispatch->bucketStarts = PyMem_New(int, bucketCount + 1);
+    dispatch->candidates = PyMem_New(JPy_JMethod*, candidateCount > 0 ? candidateCount : 1);
+    dispatch->candidateLevels = PyMem_New(int, candidateCount > 0 ? candidateCount : 1);
+    if (dispatch->bucketStarts == NULL || dispatch->candidates == NULL || dispatch->candidateLevels == NULL) {
+        JOverloadedMethod_FreeDispatch(dispatch);
+        PyErr_NoMemory();
+        return NULL;
+    }
 
-    for (i = 0; i < overloadCount; i++) {
-        currMethod = (JPy_JMethod*) PyList_GetItem(overloadedMethod->methodList, i);
+    candidateCount = 0;
+    for (argCount = 0; argCount < bucketCount; argCount++) {
+        dispatch->bucketStarts[argCount] = candidateCount;
+        for (i = 0; i < methodCount; i++) {
+            if (JMethod_AcceptsArgCount(methods[i], argCount)) {
+                dispatch->candidates[candidateCount] = methods[i];
+                dispatch->candidateLevels[candidateCount] = methodLevels != NULL ? methodLevels[i] : 0;
+                candidateCount++;
+            }
+        }
+    }
+    dispatch->bucketStarts[bucketCount] = candidateCount;
+
+    return dispatch;
+}
+
+/**
+ * Creates the dispatch table of the overloaded method merged with the overloads of the same name declared by the
+ * super classes, which are not overridden. *isComplete is set to 0 if a class of the hierarchy is not yet resolved,
+ * so that the table must not be cached.
+ */
+static JPy_OverloadDispatch* JOverloadedMethod_NewHierarchyDispatch(JNIEnv* jenv, JPy_JOverloadedMethod* overloadedMethod, int* isComplete)
+{
+    JPy_OverloadDispatch* dispatch;
+    JPy_JOverloadedMethod* currentOM;
+    JPy_JType* type;
+    PyObject* superOM;
+    JPy_JMethod** methods;
+    int* methodLevels;
+    int methodCount;
+    int methodCapacity;
+    int levelStart;
+    int level;
+    int i;
+    int j;
+
+    *isComplete = 1;
+    for (type = overloadedMethod->declaringClass; type != NULL; type = type->superType) {
+        if (!JType_IS_RESOLVED(type)) {
+            *isComplete = 0;
+        }
+    }
+    if (JPy_JObject != NULL && !JType_IS_RESOLVED(JPy_JObject)) {
+        *isComplete = 0;
+    }
+
+    methods = NULL;
+    methodLevels = NULL;
+    methodCount = 0;
+    methodCapacity = 0;
+    level = 0;
+    currentOM = overloadedMethod;
+    while (currentOM != NULL) {
+        Py_ssize_t overloadCount = PyList_Size(currentOM->methodList);
+
+        if (methodCount + overloadCount > methodCapacity) {
+            methodCapacity = (int) (methodCount + overloadCount) * 2;
+            if (PyMem_Resize(methods, JPy_JMethod*, methodCapacity) == NULL
+                || PyMem_Resize(methodLevels, int, methodCapacity) == NULL) {
+                PyMem_Free(methods);
+                PyMem_Free(methodLevels);
+                PyErr_NoMemory();
+                return NULL;
+            }
+        }
+
+        levelStart = methodCount;
+        for (i = 0; i < overloadCount; i++) {
+            JPy_JMethod* method = (JPy_JMethod*) PyList_GET_ITEM(currentOM->methodList, i);
+            // Overridden methods never match better than their overriding methods in a subclass
+            for (j = 0; j < levelStart; j++) {
+                if (JMethod_HasSameParamTypes(methods[j], method)) {
+                    break;
+                }
+            }
+            if (j == levelStart) {
+                methods[methodCount] = method;
+                methodLevels[methodCount] = level;
+                methodCount++;
+            }
+        }
+
+        type = currentOM->declaringClass->superType;
+        superOM = type != NULL ? JType_GetOverloadedMethod(jenv, type, currentOM->name, JNI_TRUE) : Py_None;
+        if (superOM == NULL) {
+            PyMem_Free(methods);
+            PyMem_Free(methodLevels);
+            return NULL;
+        }
+        currentOM = superOM != Py_None ? (JPy_JOverloadedMethod*) superOM : NULL;
+        level++;
+    }
+
+    dispatch = JOverloadedMethod_NewDispatch(methods, methodLevels, methodCount);
+    PyMem_Free(methods);
+    PyMem_Free(methodLevels);
+    return dispatch;
+}
+
+/**
+ * Applies the result of a level to the best result found so far. Returns 1 if the level's result can't get any better.
+ */
+static int JOverloadedMethod_ApplyLevelResult(JPy_MethodFindResult* levelResult, JPy_MethodFindResult* bestResult, int argCount)
+{
+    if (levelResult->method != NULL) {
+        // in the case where we have a match count that is perfect, but more than one match; the super class might
+        // have a better match count, because varargs can have fewer arguments than actual parameters.
+        if (levelResult->matchValue >= 100 * argCount && levelResult->matchCount == 1) {
+            // We can't get any better.
+            *bestResult = *levelResult;
+            return 1;
+        } else if (levelResult->matchValue > 0 && levelResult->matchValue > bestResult->matchValue) {
+            // We may have better matching methods overloads in the super class (if any)
+            *bestResult = *levelResult;
+        }
+    }
+    levelResult->method = NULL;
+    levelResult->matchValue = -1;
+    levelResult->matchCount = 0;
+    levelResult->isVarArgsArray = 0;
+    return 0;
+}
+
+/**
+ * Scores the candidates of the dispatch table accepting the argument count. Within a level, the best matching
+ * overload wins, and fixed arity methods are preferred over varargs methods. A level's best overload is only
+ * replaced by an overload of a super class level, if that matches better. If dispatch is NULL, the overloads
+ * in the methodList of the overloaded method are scored.
+ */
+static JPy_JMethod* JOverloadedMethod_FindMethodInDispatch(JNIEnv* jenv, JPy_JOverloadedMethod* overloadedMethod, JPy_OverloadDispatch* dispatch, PyObject* pyArgs, int *isVarArgsArray)
+{
+    JPy_MethodFindResult levelResult;
+    JPy_MethodFindResult bestResult;
+    JPy_JMethod** candidates;
+    int* candidateLevels;
+    int candidateCount;
+    int argCount;
+    int bucket;
+    int scoreCount;
+    int level;
+    int skipLevel;
+    int matchValue;
+    int currentIsVarArgsArray;
+    int i;
+
+    argCount = (int) PyTuple_Size(pyArgs);
+    if (dispatch != NULL) {
+        bucket = argCount > dispatch->maxArgCount ? dispatch->maxArgCount + 1 : argCount;
+        candidates = dispatch->candidates + dispatch->bucketStarts[bucket];
+        candidateLevels = dispatch->candidateLevels + dispatch->bucketStarts[bucket];
+        candidateCount = dispatch->bucketStarts[bucket + 1] - dispatch->bucketStarts[bucket];
+    } else {
+        // Without a dispatch table, all overloads of the declaring class are candidates
+        candidates = (JPy_JMethod**) PySequence_Fast_ITEMS(overloadedMethod->methodList);
+        candidateLevels = NULL;
+        candidateCount = (int) PyList_GET_SIZE(overloadedMethod->methodList);
+    }
+
+    JPy_DIAG_PRINT(JPy_DIAG_F_METH, "JOverloadedMethod_FindMethodInDispatch: method '%s#%s': candidateCount=%d, argCount=%d\n",
+                   overloadedMethod->declaringClass->javaName, JPy_AS_UTF8(overloadedMethod->name), candidateCount, argCount);
+
+    bestResult.method = NULL;
+    bestResult.matchValue = 0;
+    bestResult.matchCount = 0;
+    bestResult.isVarArgsArray = 0;
+    levelResult.method = NULL;
+    levelResult.matchValue = -1;
+    levelResult.matchCount = 0;
+    levelResult.isVarArgsArray = 0;
+
+    scoreCount = 0;
+    level = 0;
+    skipLevel = 0;
+    for (i = 0; i < candidateCount; i++) {
+        JPy_JMethod* currMethod = candidates[i];
+
+        if (candidateLevels != NULL && candidateLevels[i] != level) {
+            if (JOverloadedMethod_ApplyLevelResult(&levelResult, &bestResult, argCount)) {
+                break;
+            }
+            level = candidateLevels[i];
+            skipLevel = 0;
+        }
+        if (skipLevel || (dispatch == NULL && !JMethod_AcceptsArgCount(currMethod, argCount))) {
+            continue;
+        }
 
-        if (currMethod->isVarArgs && matchValueMax > 0 && !bestMethod->isVarArgs) {
+        if (currMethod->isVarArgs && levelResult.matchValue > 0 && !levelResult.method->isVarArgs) {
             // we should not process varargs if we have already found a suitable fixed arity method
-            break;
+            skipLevel = 1;
+            continue;
         }
 
-        matchValue = JMethod_MatchPyArgs(jenv, overloadedMethod->declaringClass, currMethod, argCount, pyArgs, &currentIsVarArgsArray);
+        if (!JMethod_MayMatchPyArgs(currMethod, pyArgs)) {
+            // Skipping is safe, JMethod_MatchPyArgs would return 0 for the argument kinds
+            JPy_DIAG_PRINT(JPy_DIAG_F_METH, "JOverloadedMethod_FindMethodInDispatch: candidates[%d]: argument kinds do not match\n", i);
+            continue;
+        }
+
+        scoreCount++;
+        matchValue = JMethod_MatchPyArgs(jenv, currMethod->declaringClass, currMethod, argCount, pyArgs, &currentIsVarArgsArray);
 
-        JPy_DIAG_PRINT(JPy_DIAG_F_METH, "JOverloadedMethod_FindMethod0: methodList[%d]: paramCount=%d, matchValue=%d, isVarArgs=%d\n", i,
-                                  currMethod->paramCount, matchValue, currMethod->isVarArgs);
+        JPy_DIAG_PRINT(JPy_DIAG_F_METH, "JOverloadedMethod_FindMethodInDispatch: candidates[%d]: level=%d, paramCount=%d, matchValue=%d, isVarArgs=%d\n", i,
+                       level, currMethod->paramCount, matchValue, currMethod->isVarArgs);
 
         if (matchValue > 0) {
-            if (matchValue > matchValueMax) {
-                matchValueMax = matchValue;
-                bestMethod = currMethod;
-                matchCount = 1;
-                bestIsVarArgsArray = currentIsVarArgsArray;
-            } else if (matchValue == matchValueMax) {
-                matchCount++;
+            if (matchValue > levelResult.matchValue) {
+                levelResult.method = currMethod;
+                levelResult.matchValue = matchValue;
+                levelResult.matchCount = 1;
+                levelResult.isVarArgsArray = currentIsVarArgsArray;
+            } else if (matchValue == levelResult.matchValue) {
+                levelResult.matchCount++;
             }
             if (!currMethod->isVarArgs && (matchValue >= 100 * argCount)) {
-                // we can't get any better (if so, we have an internal problem)
-                break;
+                // we can't get any better on this level (if so, we have an internal problem)
+                skipLevel = 1;
             }
         }
     }
+    if (i == candidateCount) {
+        JOverloadedMethod_ApplyLevelResult(&levelResult, &bestResult, argCount);
+    }
+
+    if (scoreCount > 1) {
+        JPy_STAT_INC(JPy_STAT_OVERLOAD_CACHE_MISSES);
+    }
+
+    if (bestResult.method == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "no matching Java method overloads found");
+        return NULL;
+    } else if (bestResult.matchCount > 1) {
+        PyErr_SetString(PyExc_RuntimeError, "ambiguous Java method call, too many matching method overloads found");
+        return NULL;
+    }
+    *isVarArgsArray = bestResult.isVarArgsArray;
+    return bestResult.method;
+}
+
+/**
+ * Returns the dispatch table merged with the super class overloads, which is created on the first call (borrowed
+ * reference). If the class hierarchy is not completely resolved yet, a temporary table is returned in *tempDispatch.
+ */
+static JPy_OverloadDispatch* JOverloadedMethod_GetHierarchyDispatch(JNIEnv* jenv, JPy_JOverloadedMethod* overloadedMethod, JPy_OverloadDispatch** tempDispatch)
+{
+    JPy_OverloadDispatch* dispatch;
+    int isComplete;
 
-    if (bestMethod == NULL) {
-        matchValueMax = 0;
-        matchCount = 0;
-        bestIsVarArgsArray = 0;
+    *tempDispatch = NULL;
+    dispatch = JOverloadedMethod_GET_HIERARCHY_DISPATCH(overloadedMethod);
+    if (dispatch != NULL) {
+        return dispatch;
     }
 
-    result->method = bestMethod;
-    result->matchValue = matchValueMax;
-    result->matchCount = matchCount;
-    result->isVarArgsArray = bestIsVarArgsArray;
+    JPy_BEGIN_CRITICAL_SECTION(overloadedMethod)
+    dispatch = overloadedMethod->hierarchyDispatch;
+    if (dispatch == NULL) {
+        dispatch = JOverloadedMethod_NewHierarchyDispatch(jenv, overloadedMethod, &isComplete);
+        if (dispatch != NULL) {
+            if (isComplete) {
+                JOverloadedMethod_SET_HIERARCHY_DISPATCH(overloadedMethod, dispatch);
+            } else {
+                *tempDispatch = dispatch;
+            }
+        }
+    }
+    JPy_END_CRITICAL_SECTION
 
-    return bestMethod;
+    return dispatch;
 }
 
-JPy_JMethod* JOverloadedMethod_FindMethod(JNIEnv* jenv, JPy_JOverloadedMethod* overloadedMethod, PyObject* pyArgs, jboolean visitSuperClass, int *isVarArgsArray)
+static JPy_JMethod* JOverloadedMethod_FindMethodInHierarchy(JNIEnv* jenv, JPy_JOverloadedMethod* overloadedMethod, PyObject* pyArgs, jboolean visitSuperClass, int *isVarArgsArray)
 {
-    JPy_JOverloadedMethod* currentOM;
-    JPy_MethodFindResult result;
-    JPy_MethodFindResult bestResult;
-    JPy_JType* superClass;
-    PyObject* superOM;
+    JPy_OverloadDispatch* dispatch;
+    JPy_OverloadDispatch* tempDispatch;
+    JPy_JMethod* method;
     int argCount;
 
     argCount = PyTuple_Size(pyArgs);
 
+    JPy_STAT_INC(JPy_STAT_OVERLOAD_RESOLUTIONS);
+
     if ((JPy_DiagFlags & JPy_DIAG_F_METH) != 0) {
         int i;
         printf("JOverloadedMethod_FindMethod: argCount=%d, visitSuperClass=%d\n", argCount, visitSuperClass);
@@ -797,65 +1271,32 @@ JPy_JMethod* JOverloadedMethod_FindMethod(JNIEnv* jenv, JPy_JOverloadedMethod* o
         }
     }
 
-    bestResult.method = NULL;
-    bestResult.matchValue = 0;
-    bestResult.matchCount = 0;
-    bestResult.isVarArgsArray = 0;
-
-    currentOM = overloadedMethod;
-    while (1) {
-        if (JOverloadedMethod_FindMethod0(jenv, currentOM, pyArgs, &result) < 0) {
-            // oops, error
+    tempDispatch = NULL;
+    if (visitSuperClass) {
+        dispatch = JOverloadedMethod_GetHierarchyDispatch(jenv, overloadedMethod, &tempDispatch);
+        if (dispatch == NULL) {
             return NULL;
         }
-        if (result.method != NULL) {
-            // in the case where we have a match count that is perfect, but more than one match; the super class might
-            // have a better match count, because varargs can have fewer arguments than actual parameters.
-            if (result.matchValue >= 100 * argCount && result.matchCount == 1) {
-                // We can't get any better.
-                *isVarArgsArray = result.isVarArgsArray;
-                return result.method;
-            } else if (result.matchValue > 0 && result.matchValue > bestResult.matchValue) {
-                // We may have better matching methods overloads in the super class (if any)
-                bestResult = result;
-            }
-        }
+    } else {
+        // NULL if the dispatch table could not be created when the overload was added
+        dispatch = overloadedMethod->dispatch;
+    }
 
-        if (visitSuperClass) {
-            superClass = currentOM->declaringClass->superType;
-            if (superClass != NULL) {
-                superOM = JType_GetOverloadedMethod(jenv, superClass, currentOM->name, JNI_TRUE);
-            } else {
-                superOM = Py_None;
-            }
-        } else {
-            superOM = Py_None;
-        }
+    method = JOverloadedMethod_FindMethodInDispatch(jenv, overloadedMethod, dispatch, pyArgs, isVarArgsArray);
+    JOverloadedMethod_FreeDispatch(tempDispatch);
+    return method;
+}
 
-        if (superOM == NULL) {
-            // oops, error
-            return NULL;
-        } else if (superOM == Py_None) {
-            // no overloaded methods found in super class, so return best result found so far
-            if (bestResult.method == NULL) {
-                PyErr_SetString(PyExc_RuntimeError, "no matching Java method overloads found");
-                return NULL;
-            } else if (bestResult.matchCount > 1) {
-                PyErr_SetString(PyExc_RuntimeError, "ambiguous Java method call, too many matching method overloads found");
-                return NULL;
-            } else {
-                *isVarArgsArray = bestResult.isVarArgsArray;
-                return bestResult.method;
-            }
-        } else {
-            // Continue trying with overloads from super type
-            currentOM = (JPy_JOverloadedMethod*) superOM;
-        }
-    }
+JPy_JMethod* JOverloadedMethod_FindMethod(JNIEnv* jenv, JPy_JOverloadedMethod* overloadedMethod, PyObject* pyArgs, jboolean visitSuperClass, int *isVarArgsArray)
+{
+    JPy_JMethod* method;
+    long long traceStart;
 
-    // Should never come here
-    PyErr_SetString(PyExc_RuntimeError, "internal error");
-    return NULL;
+    traceStart = JPy_TRACE_BEGIN();
+    method = JOverloadedMethod_FindMethodInHierarchy(jenv, overloadedMethod, pyArgs, visitSuperClass, isVarArgsArray);
+    JPy_TRACE_END(traceStart, JPy_TRACE_OVERLOAD_RESOLUTION, overloadedMethod, (int) PyTuple_Size(pyArgs));
+
+    return method;
 }
 
 JPy_JOverloadedMethod* JOverloadedMethod_New(JPy_JType* declaringClass, PyObject* name, JPy_JMethod* method)
@@ -867,6 +1308,8 @@ JPy_JOverloadedMethod* JOverloadedMethod_New(JPy_JType* declaringClass, PyObject
     overloadedMethod->declaringClass = declaringClass;
     overloadedMethod->name = name;
     overloadedMethod->methodList = PyList_New(0);
+    overloadedMethod->dispatch = NULL;
+    overloadedMethod->hierarchyDispatch = NULL;
 
     Py_INCREF((PyObject*) overloadedMethod->declaringClass);
     Py_INCREF((PyObject*) overloadedMethod->name);
@@ -877,9 +1320,14 @@ JPy_JOverloadedMethod* JOverloadedMethod_New(JPy_JType* declaringClass, PyObject
     return overloadedMethod;
 }
 
+/**
+ * Adds an overload and rebuilds the dispatch table. Overloads are only added while the declaring type is resolved,
+ * i.e. before the overloaded method can be called and before the merged dispatch table of the hierarchy is created.
+ */
 int JOverloadedMethod_AddMethod(JPy_JOverloadedMethod* overloadedMethod, JPy_JMethod* method)
 {
     Py_ssize_t destinationIndex = -1;
+    int status;
 
     if (!method->isVarArgs) {
         Py_ssize_t ii;
@@ -896,10 +1344,24 @@ int JOverloadedMethod_AddMethod(JPy_JOverloadedMethod* overloadedMethod, JPy_JMe
     }
 
     if (destinationIndex >= 0) {
-        return PyList_Insert(overloadedMethod->methodList, destinationIndex, (PyObject *) method);
+        status = PyList_Insert(overloadedMethod->methodList, destinationIndex, (PyObject *) method);
     } else {
-        return PyList_Append(overloadedMethod->methodList, (PyObject *) method);
+        status = PyList_Append(overloadedMethod->methodList, (PyObject *) method);
+    }
+
+    // Without a dispatch table, all overloads are scored
+    JOverloadedMethod_FreeDispatch(overloadedMethod->dispatch);
+    JOverloadedMethod_FreeDispatch(overloadedMethod->hierarchyDispatch);
+    overloadedMethod->hierarchyDispatch = NULL;
+    overloadedMethod->dispatch = NULL;
+    if (status == 0) {
+        overloadedMethod->dispatch = JOverloadedMethod_NewDispatch((JPy_JMethod**) PySequence_Fast_ITEMS(overloadedMethod->methodList),
+                                                                   NULL, (int) PyList_GET_SIZE(overloadedMethod->methodList));
+        if (overloadedMethod->dispatch == NULL) {
+            PyErr_Clear();
+        }
     }
+    return status;
 }
 
 /**
@@ -910,6 +1372,8 @@ void JOverloadedMethod_dealloc(JPy_JOverloadedMethod* self)
     Py_DECREF((PyObject*) self->declaringClass);
     Py_DECREF((PyObject*) self->name);
     Py_DECREF((PyObject*) self->methodList);
+    JOverloadedMethod_FreeDispatch(self->dispatch);
+    JOverloadedMethod_FreeDispatch(self->hierarchyDispatch);
     Py_TYPE(self)->tp_free((PyObject*) self);
 }
 
@@ -920,16 +1384,22 @@ PyObject* JOverloadedMethod_call(JPy_JOverloadedMethod* self, PyObject *args, Py
 {
     JNIEnv* jenv;
     JPy_JMethod* method;
+    JPy_CallScratch scratch;
+    PyObject* result;
     int isVarArgsArray;
 
     JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
 
+    JType_BeginCallScratch(&scratch);
     method = JOverloadedMethod_FindMethod(jenv, self, args, JNI_TRUE, &isVarArgsArray);
     if (method == NULL) {
+        JType_EndCallScratch(&scratch);
         return NULL;
     }
 
-    return JMethod_InvokeMethod(jenv, method, args, isVarArgsArray);
+    result = JMethod_InvokeMethod(jenv, method, args, isVarArgsArray);
+    JType_EndCallScratch(&scratch);
+    return result;
 }
 
 /**
@@ -48,6 +48,10 @@ typedef struct
     JPy_ReturnDescriptor* returnDescriptor;
     // The JNI method ID obtained from the declaring class.
     jmethodID mid;
+    // Number of times this method has been invoked. Updated atomically, see JPy_ATOMIC_ADD.
+    long long callCount;
+    // Latency profile, created on the first call made while profiling is enabled. Owned by the profile registry.
+    struct JPy_CallProfile* profile;
 }
 JPy_JMethod;
 
@@ -69,9 +73,21 @@ typedef struct
     PyObject* name;
     // List of method overloads (a PyList with items of type JPy_JMethod).
     PyObject* methodList;
+    // Overloads bucketed by argument count, rebuilt whenever an overload is added. May be NULL.
+    struct JPy_OverloadDispatch* dispatch;
+    // Like dispatch, but merged with the overloads of the super classes. Created on the first call. May be NULL.
+    struct JPy_OverloadDispatch* hierarchyDispatch;
 }
 JPy_JOverloadedMethod;
 
+#ifdef JPY_FREE_THREADED
+#define JOverloadedMethod_GET_HIERARCHY_DISPATCH(OM)        ((struct JPy_OverloadDispatch*) _Py_atomic_load_ptr_acquire(&(OM)->hierarchyDispatch))
+#define JOverloadedMethod_SET_HIERARCHY_DISPATCH(OM, VALUE) _Py_atomic_store_ptr_release(&(OM)->hierarchyDispatch, (VALUE))
+#else
+#define JOverloadedMethod_GET_HIERARCHY_DISPATCH(OM)        ((OM)->hierarchyDispatch)
+#define JOverloadedMethod_SET_HIERARCHY_DISPATCH(OM, VALUE) ((OM)->hierarchyDispatch = (VALUE))
+#endif
+
 /**
  * The Python 'JOverloadedMethod' type singleton.
  */
@@ -98,6 +114,9 @@ int JMethod_ConvertToJavaValues(JNIEnv* jenv, JPy_JMethod* jMethod, int argCount
 int  JMethod_CreateJArgs(JNIEnv* jenv, JPy_JMethod* jMethod, PyObject* argTuple, jvalue** jValues, JPy_ArgDisposer** jDisposers, int isVarArgsArray);
 void JMethod_DisposeJArgs(JNIEnv* jenv, int paramCount, jvalue* jValues, JPy_ArgDisposer* jDisposers);
 
+char* JMethod_GetSignatureName(JPy_JMethod* method);
+struct JPy_CallProfile* JMethod_GetProfile(JPy_JMethod* method);
+
 #ifdef __cplusplus
 }  /* extern "C" */
 #endif
@@ -25,6 +25,8 @@
 #include "jpy_jmethod.h"
 #include "jpy_jfield.h"
 #include "jpy_conv.h"
+#include "jpy_prof.h"
+#include "jpy_trace.h"
 
 PyObject* JObj_New(JNIEnv* jenv, jobject objectRef)
 {
@@ -58,8 +60,10 @@ PyObject* JObj_FromType(JNIEnv* jenv, JPy_JType* type, jobject objectRef)
         PyErr_NoMemory();
         return NULL;
     }
+    JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_CREATED);
 
     obj->objectRef = objectRef;
+    obj->hash = -1;
 
     // For special treatment of primitive array refer to JType_InitSlots()
     if (type->componentType != NULL && type->componentType->isPrimitive) {
@@ -71,16 +75,18 @@ PyObject* JObj_FromType(JNIEnv* jenv, JPy_JType* type, jobject objectRef)
 
     // we check the type translations dictionary for a callable for this java type name,
     // and apply the returned callable to the wrapped object
-    callable = PyDict_GetItemString(JPy_Type_Translations, type->javaName);
+    callable = JType_GetTranslation(type);
     if (callable != NULL) {
         if (PyCallable_Check(callable)) {
             callableResult = PyObject_CallFunction(callable, "OO", type, obj);
+            Py_DECREF(callable);
             if (callableResult == NULL) {
                 return Py_None;
             } else {
                 return callableResult;
             }
         }
+        Py_DECREF(callable);
     }
 
     return (PyObject *)obj;
@@ -99,7 +105,11 @@ int JObj_init(JPy_JObj* self, PyObject* args, PyObject* kwds)
     jobject objectRef;
     jvalue* jArgs;
     JPy_ArgDisposer* jDisposers;
+    JPy_CallScratch scratch;
     int isVarArgsArray;
+    JPy_CallProfile* profile;
+    long long t0 = 0, t1 = 0, t2 = 0;
+    long long traceStart;
 
     JPy_GET_JNI_ENV_OR_RETURN(jenv, -1)
 
@@ -122,14 +132,36 @@ int JObj_init(JPy_JObj* self, PyObject* args, PyObject* kwds)
         return -1;
     }
 
+    JType_BeginCallScratch(&scratch);
     jMethod = JOverloadedMethod_FindMethod(jenv, (JPy_JOverloadedMethod*) constructor, args, JNI_FALSE, &isVarArgsArray);
     if (jMethod == NULL) {
+        JType_EndCallScratch(&scratch);
         return -1;
     }
 
+    JPy_STAT_INC(JPy_STAT_JAVA_CALLS);
+    JPy_ATOMIC_ADD(&jMethod->callCount, 1);
+    traceStart = JPy_TRACE_BEGIN();
+
+    profile = NULL;
+    if (JPy_ProfilingEnabled) {
+        profile = JMethod_GetProfile(jMethod);
+        if (profile == NULL) {
+            JType_EndCallScratch(&scratch);
+            return -1;
+        }
+        t0 = JPy_GetNanos();
+    }
+
     if (JMethod_CreateJArgs(jenv, jMethod, args, &jArgs, &jDisposers, isVarArgsArray) < 0) {
+        JType_EndCallScratch(&scratch);
         return -1;
     }
+    JType_EndCallScratch(&scratch);
+
+    if (profile != NULL) {
+        t1 = JPy_GetNanos();
+    }
 
     JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "JObj_init: calling Java constructor %s\n", jType->javaName);
 
@@ -141,6 +173,10 @@ int JObj_init(JPy_JObj* self, PyObject* args, PyObject* kwds)
         return -1;
     }
 
+    if (profile != NULL) {
+        t2 = JPy_GetNanos();
+    }
+
     if (jMethod->paramCount > 0) {
         JMethod_DisposeJArgs(jenv, jMethod->paramCount, jArgs, jDisposers);
     }
@@ -150,13 +186,22 @@ int JObj_init(JPy_JObj* self, PyObject* args, PyObject* kwds)
         PyErr_NoMemory();
         return -1;
     }
+    JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_CREATED);
 
     // Note:  __init__ may be called multiple times, so we have to release the old objectRef
     if (self->objectRef != NULL) {
         (*jenv)->DeleteGlobalRef(jenv, self->objectRef);
+        JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
     }
 
     self->objectRef = objectRef;
+    self->hash = -1;
+
+    if (profile != NULL) {
+        JPy_RecordCall(profile, t0, t1, t2, JPy_GetNanos());
+    }
+
+    JPy_TRACE_END(traceStart, JPy_TRACE_JAVA_NEW, jMethod, jMethod->paramCount);
 
     JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "JObj_init: self->objectRef=%p\n", self->objectRef);
 
@@ -176,6 +221,7 @@ void JObj_dealloc(JPy_JObj* self)
     if (jenv != NULL) {
         if (self->objectRef != NULL) {
             (*jenv)->DeleteGlobalRef(jenv, self->objectRef);
+            JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
         }
     }
 
@@ -193,7 +239,7 @@ int JObj_CompareTo(JNIEnv* jenv, JPy_JObj* obj1, JPy_JObj* obj2)
 
     if (ref1 == ref2 || (*jenv)->IsSameObject(jenv, ref1, ref2)) {
         return 0;
-    } else if ((*jenv)->IsInstanceOf(jenv, ref1, JPy_Comparable_JClass)) {
+    } else if (((JPy_JType*) Py_TYPE(obj1))->isComparable || (*jenv)->IsInstanceOf(jenv, ref1, JPy_Comparable_JClass)) {
         value = (*jenv)->CallIntMethod(jenv, ref1, JPy_Comparable_CompareTo_MID, ref2);
         (*jenv)->ExceptionClear(jenv); // we can't deal with exceptions here, so clear any
     } else {
@@ -207,13 +253,20 @@ int JObj_Equals(JNIEnv* jenv, JPy_JObj* obj1, JPy_JObj* obj2)
 {
     jobject ref1;
     jobject ref2;
+    Py_ssize_t hash1;
+    Py_ssize_t hash2;
     int returnValue;
 
     ref1 = obj1->objectRef;
     ref2 = obj2->objectRef;
+    hash1 = JObj_GET_HASH(obj1);
+    hash2 = JObj_GET_HASH(obj2);
 
-    if ((*jenv)->IsSameObject(jenv, ref1, ref2)) {
+    if (ref1 == ref2 || (*jenv)->IsSameObject(jenv, ref1, ref2)) {
         returnValue = 1;
+    } else if (hash1 != -1 && hash2 != -1 && hash1 != hash2) {
+        // Equal objects must have equal hash codes
+        returnValue = 0;
     } else {
         returnValue = (*jenv)->CallIntMethod(jenv, ref1, JPy_Object_Equals_MID, ref2);
     }
@@ -296,14 +349,29 @@ PyObject* JObj_richcompare(PyObject* obj1, PyObject* obj2, int opid)
 
 /**
  * The JObj type's tp_hash slot. Python: hash(obj)
+ * The hash code is cached in the object if its type's 'isHashCached' flag is set.
  */
 long JObj_hash(JPy_JObj* self)
 {
     JNIEnv* jenv;
+    Py_ssize_t hash;
+
+    hash = JObj_GET_HASH(self);
+    if (hash != -1) {
+        return (long) hash;
+    }
+
     jenv = JPy_GetJNIEnv();
     if (jenv != NULL) {
         int returnValue = (*jenv)->CallIntMethod(jenv, self->objectRef, JPy_Object_HashCode_MID);
         (*jenv)->ExceptionClear(jenv); // we can't deal with exceptions here, so clear any
+        // -1 signals an error to Python
+        if (returnValue == -1) {
+            returnValue = -2;
+        }
+        if (JType_IS_HASH_CACHED((JPy_JType*) Py_TYPE(self))) {
+            JObj_SET_HASH(self, returnValue);
+        }
         return returnValue;
     }
     return -1;
@@ -425,7 +493,7 @@ PyObject* JObj_getattro(JPy_JObj* self, PyObject* name)
 
     // First make sure that the Java type is resolved, otherwise we won't find any methods at all.
     selfType = (JPy_JType*) Py_TYPE(self);
-    if (!selfType->isResolved) {
+    if (!JType_IS_RESOLVED(selfType)) {
         JNIEnv* jenv;
         JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
         if (JType_ResolveType(jenv, selfType) < 0) {
@@ -690,6 +758,225 @@ static PySequenceMethods JObj_as_sequence = {
 };
 
 
+/**
+ * Kinds of java.lang.Number instances, see JObj_GetNumberKind().
+ */
+#define JObj_NUMBER_OTHER       0
+#define JObj_NUMBER_INTEGRAL    1
+#define JObj_NUMBER_BIG_INTEGER 2
+#define JObj_NUMBER_FLOATING    3
+#define JObj_NUMBER_BIG_DECIMAL 4
+
+static const char* JObj_IntegralNumberTypeNames[] = {
+    "java.lang.Byte",
+    "java.lang.Short",
+    "java.lang.Integer",
+    "java.lang.Long",
+    "java.util.concurrent.atomic.AtomicInteger",
+    "java.util.concurrent.atomic.AtomicLong",
+    "java.util.concurrent.atomic.LongAdder",
+    "java.util.concurrent.atomic.LongAccumulator",
+    NULL
+};
+
+static const char* JObj_FloatingNumberTypeNames[] = {
+    "java.lang.Float",
+    "java.lang.Double",
+    "java.util.concurrent.atomic.DoubleAdder",
+    "java.util.concurrent.atomic.DoubleAccumulator",
+    NULL
+};
+
+static int JObj_GetNumberKindForName(const char* typeName)
+{
+    const char** name;
+
+    for (name = JObj_IntegralNumberTypeNames; *name != NULL; name++) {
+        if (strcmp(typeName, *name) == 0) {
+            return JObj_NUMBER_INTEGRAL;
+        }
+    }
+    for (name = JObj_FloatingNumberTypeNames; *name != NULL; name++) {
+        if (strcmp(typeName, *name) == 0) {
+            return JObj_NUMBER_FLOATING;
+        }
+    }
+    if (strcmp(typeName, "java.math.BigInteger") == 0) {
+        return JObj_NUMBER_BIG_INTEGER;
+    }
+    if (strcmp(typeName, "java.math.BigDecimal") == 0) {
+        return JObj_NUMBER_BIG_DECIMAL;
+    }
+    return -1;
+}
+
+/**
+ * Returns the kind of a java.lang.Number instance, or -1 on error.
+ * Instances wrapped by types other than the well-known ones (e.g. 'java.lang.Number') are classified by their actual class.
+ */
+static int JObj_GetNumberKind(JNIEnv* jenv, JPy_JObj* self)
+{
+    JPy_JType* actualType;
+    int kind;
+
+    kind = JObj_GetNumberKindForName(Py_TYPE(self)->tp_name);
+    if (kind >= 0) {
+        return kind;
+    }
+
+    actualType = JType_GetTypeForObject(jenv, self->objectRef);
+    if (actualType == NULL) {
+        return -1;
+    }
+    kind = JObj_GetNumberKindForName(actualType->javaName);
+    Py_DECREF(actualType);
+    return kind >= 0 ? kind : JObj_NUMBER_OTHER;
+}
+
+static PyObject* JObj_BigIntegerToPyLong(JNIEnv* jenv, jobject objectRef)
+{
+    jstring stringRef;
+    PyObject* pyString;
+    PyObject* pyLong;
+
+    stringRef = (*jenv)->CallObjectMethod(jenv, objectRef, JPy_Object_ToString_MID);
+    JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+    pyString = JPy_FromJString(jenv, stringRef);
+    (*jenv)->DeleteLocalRef(jenv, stringRef);
+    if (pyString == NULL) {
+        return NULL;
+    }
+    pyLong = PyNumber_Long(pyString);
+    Py_DECREF(pyString);
+    return pyLong;
+}
+
+/**
+ * The nb_int slot of java.lang.Number types. Python: int(obj)
+ */
+static PyObject* JObj_nb_int(JPy_JObj* self)
+{
+    JNIEnv* jenv;
+    int kind;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    kind = JObj_GetNumberKind(jenv, self);
+    if (kind < 0) {
+        return NULL;
+    } else if (kind == JObj_NUMBER_BIG_INTEGER) {
+        return JObj_BigIntegerToPyLong(jenv, self->objectRef);
+    } else if (kind == JObj_NUMBER_BIG_DECIMAL) {
+        // Truncates towards zero like int(decimal.Decimal), without losing precision
+        PyObject* pyLong;
+        jobject bigIntegerRef = (*jenv)->CallObjectMethod(jenv, self->objectRef, JPy_BigDecimal_ToBigInteger_MID);
+        JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+        pyLong = JObj_BigIntegerToPyLong(jenv, bigIntegerRef);
+        (*jenv)->DeleteLocalRef(jenv, bigIntegerRef);
+        return pyLong;
+    } else if (kind == JObj_NUMBER_FLOATING) {
+        jdouble value = (*jenv)->CallDoubleMethod(jenv, self->objectRef, JPy_Number_DoubleValue_MID);
+        JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+        return PyLong_FromDouble(value);
+    } else {
+        jlong value = (*jenv)->CallLongMethod(jenv, self->objectRef, JPy_Number_LongValue_MID);
+        JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+        return PyLong_FromLongLong(value);
+    }
+}
+
+/**
+ * The nb_index slot of java.lang.Number types. Only integral numbers can be used as indexes. Python: operator.index(obj)
+ */
+static PyObject* JObj_nb_index(JPy_JObj* self)
+{
+    JNIEnv* jenv;
+    int kind;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    kind = JObj_GetNumberKind(jenv, self);
+    if (kind < 0) {
+        return NULL;
+    } else if (kind == JObj_NUMBER_BIG_INTEGER) {
+        return JObj_BigIntegerToPyLong(jenv, self->objectRef);
+    } else if (kind == JObj_NUMBER_INTEGRAL) {
+        jlong value = (*jenv)->CallLongMethod(jenv, self->objectRef, JPy_Number_LongValue_MID);
+        JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+        return PyLong_FromLongLong(value);
+    } else {
+        PyErr_Format(PyExc_TypeError, "'%s' object cannot be interpreted as an integer", Py_TYPE(self)->tp_name);
+        return NULL;
+    }
+}
+
+/**
+ * The nb_float slot of java.lang.Number types. Python: float(obj)
+ */
+static PyObject* JObj_nb_float(JPy_JObj* self)
+{
+    JNIEnv* jenv;
+    jdouble value;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    value = (*jenv)->CallDoubleMethod(jenv, self->objectRef, JPy_Number_DoubleValue_MID);
+    JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+    return PyFloat_FromDouble(value);
+}
+
+/**
+ * Returns the value of a java.lang.Boolean, or -1 on error.
+ */
+static int JObj_GetBooleanValue(JPy_JObj* self)
+{
+    JNIEnv* jenv;
+    jboolean value;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, -1)
+
+    value = (*jenv)->CallBooleanMethod(jenv, self->objectRef, JPy_Boolean_BooleanValue_MID);
+    JPy_ON_JAVA_EXCEPTION_RETURN(-1);
+    return value != JNI_FALSE;
+}
+
+/**
+ * The nb_int and nb_index slots of java.lang.Boolean. Python: int(obj)
+ */
+static PyObject* JObj_Boolean_nb_int(JPy_JObj* self)
+{
+    int value;
+
+    value = JObj_GetBooleanValue(self);
+    if (value < 0) {
+        return NULL;
+    }
+    return PyLong_FromLong(value);
+}
+
+/**
+ * The JObj type's tp_as_number slot.
+ * Implements the <number> interface for java.lang.Number and its subclasses, and for java.lang.Boolean.
+ * The structures are initialised by JObj_InitNumberMethods(), because their layout differs between Python 2 and 3.
+ */
+static PyNumberMethods JObj_as_number;
+static PyNumberMethods JObj_as_number_boolean;
+
+static void JObj_InitNumberMethods(void)
+{
+    JObj_as_number.nb_int = (unaryfunc) JObj_nb_int;
+    JObj_as_number.nb_float = (unaryfunc) JObj_nb_float;
+    JObj_as_number.nb_index = (unaryfunc) JObj_nb_index;
+    JObj_as_number_boolean.nb_int = (unaryfunc) JObj_Boolean_nb_int;
+    JObj_as_number_boolean.nb_index = (unaryfunc) JObj_Boolean_nb_int;
+    // There is no nb_bool slot, so that all wrapped objects remain true, e.g. in 'if obj:' tests for None
+#if !defined(JPY_COMPAT_33P)
+    JObj_as_number.nb_long = (unaryfunc) JObj_nb_int;
+    JObj_as_number_boolean.nb_long = (unaryfunc) JObj_Boolean_nb_int;
+#endif
+}
+
+
 int JType_InitSlots(JPy_JType* type)
 {
     PyTypeObject* typeObj;
@@ -742,6 +1029,21 @@ int JType_InitSlots(JPy_JType* type)
         typeObj->tp_as_sequence = &JObj_as_sequence;
     }
 
+    // If this type is java.lang.Number, one of its subclasses, or java.lang.Boolean, add support for the <number> protocol
+    if (!isArray && !type->isPrimitive) {
+        JNIEnv* jenv = JPy_GetJNIEnv();
+        if (jenv != NULL && JPy_Number_JClass != NULL && JPy_Boolean_JClass != NULL) {
+            if (JObj_as_number.nb_int == NULL) {
+                JObj_InitNumberMethods();
+            }
+            if ((*jenv)->IsAssignableFrom(jenv, type->classRef, JPy_Number_JClass)) {
+                typeObj->tp_as_number = &JObj_as_number;
+            } else if ((*jenv)->IsSameObject(jenv, type->classRef, JPy_Boolean_JClass)) {
+                typeObj->tp_as_number = &JObj_as_number_boolean;
+            }
+        }
+    }
+
     if (isPrimitiveArray) {
         const char* componentTypeName = type->componentType->javaName;
         if (strcmp(componentTypeName, "boolean") == 0) {
@@ -34,9 +34,22 @@ typedef struct JPy_JObj
 {
     PyObject_HEAD
     jobject objectRef;
+    // The cached Java hash code, or -1 if not cached, see JObj_hash().
+    Py_ssize_t hash;
 }
 JPy_JObj;
 
+/**
+ * In free-threaded builds, the cached hash code may be set by one thread while other threads read it.
+ */
+#ifdef JPY_FREE_THREADED
+#define JObj_GET_HASH(OBJ)        _Py_atomic_load_ssize_relaxed(&(OBJ)->hash)
+#define JObj_SET_HASH(OBJ, VALUE) _Py_atomic_store_ssize_relaxed(&(OBJ)->hash, (VALUE))
+#else
+#define JObj_GET_HASH(OBJ)        ((OBJ)->hash)
+#define JObj_SET_HASH(OBJ, VALUE) ((OBJ)->hash = (VALUE))
+#endif
+
 
 int JObj_Check(PyObject* arg);
 
@@ -23,12 +23,16 @@
 #include "jpy_jfield.h"
 #include "jpy_jmethod.h"
 #include "jpy_jobj.h"
+#include "jpy_jarray.h"
 #include "jpy_conv.h"
+#include "jpy_trace.h"
 #include "jpy_compat.h"
 
 
 JPy_JType* JType_New(JNIEnv* jenv, jclass classRef, jboolean resolve);
 int JType_ResolveType(JNIEnv* jenv, JPy_JType* type);
+static JPy_JType* JType_GetRegisteredType(JNIEnv* jenv, jclass classRef, PyObject* typeKey, jboolean resolve);
+static jboolean JType_IsHashCachedByDefault(JNIEnv* jenv, JPy_JType* type);
 int JType_InitComponentType(JNIEnv* jenv, JPy_JType* type, jboolean resolve);
 int JType_InitSuperType(JNIEnv* jenv, JPy_JType* type, jboolean resolve);
 int JType_ProcessClassConstructors(JNIEnv* jenv, JPy_JType* type);
@@ -37,12 +41,15 @@ int JType_ProcessClassMethods(JNIEnv* jenv, JPy_JType* type);
 int JType_AddMethod(JPy_JType* type, JPy_JMethod* method);
 JPy_ReturnDescriptor* JType_CreateReturnDescriptor(JNIEnv* jenv, jclass returnType);
 JPy_ParamDescriptor* JType_CreateParamDescriptors(JNIEnv* jenv, int paramCount, jarray paramTypes);
-void JType_InitParamDescriptorFunctions(JPy_ParamDescriptor* paramDescriptor, jboolean isLastVarArg);
-void JType_InitMethodParamDescriptorFunctions(JPy_JType* type, JPy_JMethod* method);
+void JType_InitParamDescriptorFunctions(JNIEnv* jenv, JPy_ParamDescriptor* paramDescriptor, jboolean isLastVarArg);
+void JType_InitMethodParamDescriptorFunctions(JNIEnv* jenv, JPy_JType* type, JPy_JMethod* method);
 int JType_ProcessField(JNIEnv* jenv, JPy_JType* declaringType, PyObject* fieldKey, const char* fieldName, jclass fieldClassRef, jboolean isStatic, jboolean isFinal, jfieldID fid);
 void JType_DisposeLocalObjectRefArg(JNIEnv* jenv, jvalue* value, void* data);
 void JType_DisposeReadOnlyBufferArg(JNIEnv* jenv, jvalue* value, void* data);
 void JType_DisposeWritableBufferArg(JNIEnv* jenv, jvalue* value, void* data);
+void JType_DisposePooledReadOnlyBufferArg(JNIEnv* jenv, jvalue* value, void* data);
+void JType_DisposePooledWritableBufferArg(JNIEnv* jenv, jvalue* value, void* data);
+static void JType_DisposeBufferArgArray(JNIEnv* jenv, jarray jArray, jboolean isPooled);
 
 
 static int JType_MatchVarArgPyArgAsFPType(const JPy_ParamDescriptor *paramDescriptor, PyObject *pyArg, int idx,
@@ -133,9 +140,7 @@ JPy_JType* JType_GetTypeForName(JNIEnv* jenv, const char* typeName, jboolean res
 JPy_JType* JType_GetType(JNIEnv* jenv, jclass classRef, jboolean resolve)
 {
     PyObject* typeKey;
-    PyObject* typeValue;
     JPy_JType* type;
-    jboolean found;
 
     if (JPy_Types == NULL) {
         PyErr_SetString(PyExc_RuntimeError, "jpy internal error: module 'jpy' not initialized");
@@ -147,6 +152,40 @@ JPy_JType* JType_GetType(JNIEnv* jenv, jclass classRef, jboolean resolve)
         return NULL;
     }
 
+#ifdef JPY_FREE_THREADED
+    {
+        PyObject* typeValue;
+        // Look up resolved types without locking. Types are removed from JPy_Types only if their
+        // registration fails, which is before they can be resolved.
+        if (PyDict_GetItemRef(JPy_Types, typeKey, &typeValue) > 0) {
+            if (JType_Check(typeValue) && JType_IS_RESOLVED((JPy_JType*) typeValue)) {
+                Py_DECREF(typeKey);
+                return (JPy_JType*) typeValue;
+            }
+            Py_DECREF(typeValue);
+        }
+        PyErr_Clear();
+    }
+#endif
+
+    // Registering and resolving a type must not interleave with other threads doing the same
+    JPy_BEGIN_GLOBAL_LOCK
+    type = JType_GetRegisteredType(jenv, classRef, typeKey, resolve);
+    JPy_END_GLOBAL_LOCK
+
+    return type;
+}
+
+/**
+ * Looks up the type for the given typeKey in JPy_Types, registers a new type if not found, and resolves it if
+ * requested. The reference to typeKey is stolen. Must be called while holding the global lock.
+ */
+static JPy_JType* JType_GetRegisteredType(JNIEnv* jenv, jclass classRef, PyObject* typeKey, jboolean resolve)
+{
+    PyObject* typeValue;
+    JPy_JType* type;
+    jboolean found;
+
     typeValue = PyDict_GetItem(JPy_Types, typeKey);
     if (typeValue == NULL) {
 
@@ -227,6 +266,40 @@ JPy_JType* JType_GetType(JNIEnv* jenv, jclass classRef, jboolean resolve)
     return type;
 }
 
+/**
+ * Names of immutable types whose instances cache their hash code by default, see jpy.cache_hash().
+ */
+static const char* JType_HashCachedTypeNames[] = {
+    "java.lang.String",
+    "java.lang.Boolean",
+    "java.lang.Character",
+    "java.lang.Byte",
+    "java.lang.Short",
+    "java.lang.Integer",
+    "java.lang.Long",
+    "java.lang.Float",
+    "java.lang.Double",
+    "java.math.BigInteger",
+    "java.math.BigDecimal",
+    NULL
+};
+
+static jboolean JType_IsHashCachedByDefault(JNIEnv* jenv, JPy_JType* type)
+{
+    const char** typeName;
+
+    if (type->isPrimitive || type->isInterface) {
+        return JNI_FALSE;
+    }
+    for (typeName = JType_HashCachedTypeNames; *typeName != NULL; typeName++) {
+        if (strcmp(type->javaName, *typeName) == 0) {
+            return JNI_TRUE;
+        }
+    }
+    // Enum constants use their identity hash code
+    return JPy_Enum_JClass != NULL && (*jenv)->IsAssignableFrom(jenv, type->classRef, JPy_Enum_JClass);
+}
+
 /**
  * Creates a type instance of the meta type 'JType_Type'.
  * Such type instances are used as types for Java Objects in Python.
@@ -247,7 +320,11 @@ JPy_JType* JType_New(JNIEnv* jenv, jclass classRef, jboolean resolve)
 
     type->classRef = NULL;
     type->isResolved = JNI_FALSE;
-    type->isResolving = JNI_FALSE;
+    type->isComparable = JNI_FALSE;
+    type->isHashCached = JNI_FALSE;
+    type->translation = NULL;
+    type->translationVersion = 0;
+    memset(type->assignableFrom, 0, sizeof(type->assignableFrom));
 
     type->javaName = JPy_GetTypeName(jenv, classRef);
     if (type->javaName == NULL) {
@@ -267,15 +344,103 @@ JPy_JType* JType_New(JNIEnv* jenv, jclass classRef, jboolean resolve)
         PyErr_NoMemory();
         return NULL;
     }
+    JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_CREATED);
 
     type->isPrimitive = (*jenv)->CallBooleanMethod(jenv, type->classRef, JPy_Class_IsPrimitive_MID);
     type->isInterface = (*jenv)->CallBooleanMethod(jenv, type->classRef, JPy_Class_IsInterface_MID);
+    type->isComparable = JPy_Comparable_JClass != NULL && (*jenv)->IsAssignableFrom(jenv, type->classRef, JPy_Comparable_JClass);
+    type->isHashCached = JType_IsHashCachedByDefault(jenv, type);
 
     JPy_DIAG_PRINT(JPy_DIAG_F_TYPE, "JType_New: javaName=\"%s\", resolve=%d, type=%p\n", type->javaName, resolve, type);
 
     return type;
 }
 
+jboolean JType_IsAssignableFrom(JNIEnv* jenv, JPy_JType* type, JPy_JType* sourceType)
+{
+    uintptr_t key;
+    uintptr_t entry;
+    size_t index;
+    size_t i;
+    jboolean isAssignable;
+
+    if (type == sourceType) {
+        return JNI_TRUE;
+    }
+
+    key = (uintptr_t) sourceType;
+    index = (size_t) (key >> 4);
+    for (i = 0; i < JType_ASSIGNABLE_FROM_SIZE; i++) {
+        entry = JType_GET_ASSIGNABLE_FROM(type, (index + i) & (JType_ASSIGNABLE_FROM_SIZE - 1));
+        if (entry == 0) {
+            break;
+        }
+        if ((entry & ~(uintptr_t) 1) == key) {
+            return (jboolean) (entry & 1);
+        }
+    }
+
+    isAssignable = (*jenv)->IsAssignableFrom(jenv, sourceType->classRef, type->classRef) ? JNI_TRUE : JNI_FALSE;
+
+    // If the memo is full, the result is simply not memoized
+    entry = key | (isAssignable ? 1 : 0);
+    for (; i < JType_ASSIGNABLE_FROM_SIZE; i++) {
+        uintptr_t expected = 0;
+        if (JType_CAS_ASSIGNABLE_FROM(type, (index + i) & (JType_ASSIGNABLE_FROM_SIZE - 1), &expected, entry)
+            || (expected & ~(uintptr_t) 1) == key) {
+            break;
+        }
+    }
+
+    return isAssignable;
+}
+
+PyObject* JType_GetTranslation(JPy_JType* type)
+{
+    PyObject* translation;
+    PyObject* oldTranslation;
+    long long version;
+
+    if (JPy_Type_Translations == NULL) {
+        return NULL;
+    }
+
+    version = JPy_ATOMIC_GET(&JPy_TypeTranslationsVersion);
+    if (version == 0) {
+        // The dictionary is not watched, but mostly empty
+        if (PyDict_Size(JPy_Type_Translations) == 0) {
+            return NULL;
+        }
+        return JPy_GetDictItemString(JPy_Type_Translations, type->javaName);
+    }
+
+    JPy_BEGIN_CRITICAL_SECTION(type)
+    if (type->translationVersion != version) {
+        // Holding the dictionary's lock, it cannot be modified between notifying its watcher and storing the item
+        JPy_BEGIN_CRITICAL_SECTION(JPy_Type_Translations)
+        version = JPy_ATOMIC_GET(&JPy_TypeTranslationsVersion);
+        translation = JPy_GetDictItemString(JPy_Type_Translations, type->javaName);
+        JPy_END_CRITICAL_SECTION
+        oldTranslation = type->translation;
+        type->translation = translation;
+        type->translationVersion = version;
+        Py_XDECREF(oldTranslation);
+    }
+    translation = type->translation;
+    Py_XINCREF(translation);
+    JPy_END_CRITICAL_SECTION
+
+    return translation;
+}
+
+/**
+ * Tests whether the value of OBJECT, declared as TYPE, can be read from the 'value' field FIELD of the JDK box
+ * class of BOX_TYPE instead of calling its getter. The box classes are final, so the instance test is an exact
+ * class test. Instances of other Number classes, e.g. passed for a primitive 'int' parameter, use the getter.
+ */
+#define JType_IS_BOX_OBJECT(OBJECT, TYPE, BOX_TYPE, FIELD) \
+    ((FIELD) != NULL && ((TYPE) == (BOX_TYPE) || (*jenv)->IsInstanceOf(jenv, (OBJECT), (BOX_TYPE)->classRef)))
+
 PyObject* JType_ConvertJavaToPythonObject(JNIEnv* jenv, JPy_JType* type, jobject objectRef)
 {
     if (objectRef == NULL) {
@@ -285,28 +450,58 @@ PyObject* JType_ConvertJavaToPythonObject(JNIEnv* jenv, JPy_JType* type, jobject
     if (type->componentType == NULL) {
         // Scalar type, not an array, try to convert to Python equivalent
         if (type == JPy_JBooleanObj || type == JPy_JBoolean) {
-            jboolean value = (*jenv)->CallBooleanMethod(jenv, objectRef, JPy_Boolean_BooleanValue_MID);
-            JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            jboolean value;
+            if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JBooleanObj, JPy_Boolean_Value_FID)) {
+                value = (*jenv)->GetBooleanField(jenv, objectRef, JPy_Boolean_Value_FID);
+            } else {
+                value = (*jenv)->CallBooleanMethod(jenv, objectRef, JPy_Boolean_BooleanValue_MID);
+                JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            }
             return JPy_FROM_JBOOLEAN(value);
         } else if (type == JPy_JCharacterObj || type == JPy_JChar) {
-            jchar value = (*jenv)->CallCharMethod(jenv, objectRef, JPy_Character_CharValue_MID);
-            JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            jchar value;
+            if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JCharacterObj, JPy_Character_Value_FID)) {
+                value = (*jenv)->GetCharField(jenv, objectRef, JPy_Character_Value_FID);
+            } else {
+                value = (*jenv)->CallCharMethod(jenv, objectRef, JPy_Character_CharValue_MID);
+                JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            }
             return JPy_FROM_JCHAR(value);
         } else if (type == JPy_JByteObj || type == JPy_JShortObj || type == JPy_JIntegerObj || type == JPy_JShort || type == JPy_JInt) {
-            jint value = (*jenv)->CallIntMethod(jenv, objectRef, JPy_Number_IntValue_MID);
-            JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            jint value;
+            if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JIntegerObj, JPy_Integer_Value_FID)) {
+                value = (*jenv)->GetIntField(jenv, objectRef, JPy_Integer_Value_FID);
+            } else if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JShortObj, JPy_Short_Value_FID)) {
+                value = (*jenv)->GetShortField(jenv, objectRef, JPy_Short_Value_FID);
+            } else if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JByteObj, JPy_Byte_Value_FID)) {
+                value = (*jenv)->GetByteField(jenv, objectRef, JPy_Byte_Value_FID);
+            } else {
+                value = (*jenv)->CallIntMethod(jenv, objectRef, JPy_Number_IntValue_MID);
+                JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            }
             return JPy_FROM_JINT(value);
         } else if (type == JPy_JLongObj || type == JPy_JLong) {
-            jlong value = (*jenv)->CallLongMethod(jenv, objectRef, JPy_Number_LongValue_MID);
-            JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            jlong value;
+            if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JLongObj, JPy_Long_Value_FID)) {
+                value = (*jenv)->GetLongField(jenv, objectRef, JPy_Long_Value_FID);
+            } else {
+                value = (*jenv)->CallLongMethod(jenv, objectRef, JPy_Number_LongValue_MID);
+                JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            }
             return JPy_FROM_JLONG(value);
         } else if (type == JPy_JFloatObj || type == JPy_JDoubleObj || type == JPy_JFloat || type == JPy_JDouble) {
-            jdouble value = (*jenv)->CallDoubleMethod(jenv, objectRef, JPy_Number_DoubleValue_MID);
-            JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            jdouble value;
+            if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JDoubleObj, JPy_Double_Value_FID)) {
+                value = (*jenv)->GetDoubleField(jenv, objectRef, JPy_Double_Value_FID);
+            } else if (JType_IS_BOX_OBJECT(objectRef, type, JPy_JFloatObj, JPy_Float_Value_FID)) {
+                value = (*jenv)->GetFloatField(jenv, objectRef, JPy_Float_Value_FID);
+            } else {
+                value = (*jenv)->CallDoubleMethod(jenv, objectRef, JPy_Number_DoubleValue_MID);
+                JPy_ON_JAVA_EXCEPTION_RETURN(NULL);
+            }
             return JPy_FROM_JDOUBLE(value);
         } else if (type == JPy_JPyObject || type == JPy_JPyModule) {
-            jlong value = (*jenv)->CallLongMethod(jenv, objectRef, JPy_PyObject_GetPointer_MID);
-            return (PyObject*) value;
+            return JPy_GetPyObjectPointer(jenv, objectRef);
         } else if (type == JPy_JString) {
             return JPy_FromJString(jenv, objectRef);
         } else if (type == JPy_JObject) {
@@ -349,6 +544,95 @@ int JType_CreateJavaObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jclas
     return 0;
 }
 
+/**
+ * Boxes a primitive value by calling the static valueOf() method of its wrapper class, as autoboxing in Java does.
+ */
+static int JType_CreateJavaBoxObject(JNIEnv* jenv, jclass classRef, jmethodID valueOfMID, jvalue value, jobject* objectRef)
+{
+    *objectRef = (*jenv)->CallStaticObjectMethodA(jenv, classRef, valueOfMID, &value);
+    JPy_ON_JAVA_EXCEPTION_RETURN(-1);
+    if (*objectRef == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Global references to boxed values created on first use, so that boxing common values only creates a new local
+ * reference instead of calling valueOf(). Like the JDK's own caches, they make boxes of equal values identical.
+ */
+#define JType_BOX_CACHE_MIN (-128)
+#define JType_BOX_CACHE_MAX 1023
+#define JType_BOX_CACHE_SIZE (JType_BOX_CACHE_MAX - JType_BOX_CACHE_MIN + 1)
+
+static jobject JType_BooleanCache[2];
+static jobject JType_IntegerCache[JType_BOX_CACHE_SIZE];
+static jobject JType_LongCache[JType_BOX_CACHE_SIZE];
+
+#ifdef JPY_FREE_THREADED
+#define JType_GET_CACHED_BOX(SLOT)                  ((jobject) _Py_atomic_load_ptr_acquire(SLOT))
+#define JType_CAS_CACHED_BOX(SLOT, EXPECTED, VALUE) _Py_atomic_compare_exchange_ptr((SLOT), (EXPECTED), (VALUE))
+#else
+#define JType_GET_CACHED_BOX(SLOT)                  (*(SLOT))
+#define JType_CAS_CACHED_BOX(SLOT, EXPECTED, VALUE) ((void) (EXPECTED), *(SLOT) = (VALUE), 1)
+#endif
+
+static int JType_CreateCachedJavaBoxObject(JNIEnv* jenv, jobject* slot, jclass classRef, jmethodID valueOfMID, jvalue value, jobject* objectRef)
+{
+    jobject boxRef;
+    jobject expected;
+
+    boxRef = JType_GET_CACHED_BOX(slot);
+    if (boxRef == NULL) {
+        if (JType_CreateJavaBoxObject(jenv, classRef, valueOfMID, value, objectRef) < 0) {
+            return -1;
+        }
+        boxRef = (*jenv)->NewGlobalRef(jenv, *objectRef);
+        if (boxRef == NULL) {
+            // Not cached, but still a valid result
+            return 0;
+        }
+        JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_CREATED);
+        expected = NULL;
+        if (!JType_CAS_CACHED_BOX(slot, &expected, boxRef)) {
+            // Another thread has been faster
+            (*jenv)->DeleteGlobalRef(jenv, boxRef);
+            JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
+        }
+        return 0;
+    }
+
+    // Callers own the result as a local reference
+    *objectRef = (*jenv)->NewLocalRef(jenv, boxRef);
+    if (*objectRef == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+static void JType_ClearBoxCache(JNIEnv* jenv, jobject* cache, int size)
+{
+    int i;
+    for (i = 0; i < size; i++) {
+        if (cache[i] != NULL) {
+            if (jenv != NULL) {
+                (*jenv)->DeleteGlobalRef(jenv, cache[i]);
+                JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
+            }
+            cache[i] = NULL;
+        }
+    }
+}
+
+void JType_ClearBoxCaches(JNIEnv* jenv)
+{
+    JType_ClearBoxCache(jenv, JType_BooleanCache, 2);
+    JType_ClearBoxCache(jenv, JType_IntegerCache, JType_BOX_CACHE_SIZE);
+    JType_ClearBoxCache(jenv, JType_LongCache, JType_BOX_CACHE_SIZE);
+}
+
 int JType_CreateJavaBooleanObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
 {
     jvalue value;
@@ -357,7 +641,7 @@ int JType_CreateJavaBooleanObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Boolean_JClass, JPy_Boolean_Init_MID, value, objectRef);
+    return JType_CreateCachedJavaBoxObject(jenv, &JType_BooleanCache[value.z ? 1 : 0], JPy_Boolean_JClass, JPy_Boolean_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaCharacterObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -368,7 +652,7 @@ int JType_CreateJavaCharacterObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyA
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Character_JClass, JPy_Character_Init_MID, value, objectRef);
+    return JType_CreateJavaBoxObject(jenv, JPy_Character_JClass, JPy_Character_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaByteObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -379,7 +663,7 @@ int JType_CreateJavaByteObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, j
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Byte_JClass, JPy_Byte_Init_MID, value, objectRef);
+    return JType_CreateJavaBoxObject(jenv, JPy_Byte_JClass, JPy_Byte_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaShortObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -390,7 +674,7 @@ int JType_CreateJavaShortObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg,
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Short_JClass, JPy_Short_Init_MID, value, objectRef);
+    return JType_CreateJavaBoxObject(jenv, JPy_Short_JClass, JPy_Short_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaIntegerObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -401,7 +685,10 @@ int JType_CreateJavaIntegerObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Integer_JClass, JPy_Integer_Init_MID, value, objectRef);
+    if (value.i >= JType_BOX_CACHE_MIN && value.i <= JType_BOX_CACHE_MAX) {
+        return JType_CreateCachedJavaBoxObject(jenv, &JType_IntegerCache[value.i - JType_BOX_CACHE_MIN], JPy_Integer_JClass, JPy_Integer_ValueOf_MID, value, objectRef);
+    }
+    return JType_CreateJavaBoxObject(jenv, JPy_Integer_JClass, JPy_Integer_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaLongObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -412,7 +699,10 @@ int JType_CreateJavaLongObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, j
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Long_JClass, JPy_Long_Init_MID, value, objectRef);
+    if (value.j >= JType_BOX_CACHE_MIN && value.j <= JType_BOX_CACHE_MAX) {
+        return JType_CreateCachedJavaBoxObject(jenv, &JType_LongCache[value.j - JType_BOX_CACHE_MIN], JPy_Long_JClass, JPy_Long_ValueOf_MID, value, objectRef);
+    }
+    return JType_CreateJavaBoxObject(jenv, JPy_Long_JClass, JPy_Long_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaFloatObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -425,7 +715,7 @@ int JType_CreateJavaFloatObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg,
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Float_JClass, JPy_Float_Init_MID, value, objectRef);
+    return JType_CreateJavaBoxObject(jenv, JPy_Float_JClass, JPy_Float_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaDoubleObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -438,7 +728,7 @@ int JType_CreateJavaDoubleObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg,
     } else {
         return JType_PythonToJavaConversionError(type, pyArg);
     }
-    return JType_CreateJavaObject(jenv, type, pyArg, JPy_Double_JClass, JPy_Double_Init_MID, value, objectRef);
+    return JType_CreateJavaBoxObject(jenv, JPy_Double_JClass, JPy_Double_ValueOf_MID, value, objectRef);
 }
 
 int JType_CreateJavaPyObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg, jobject* objectRef)
@@ -455,6 +745,14 @@ int JType_CreateJavaArray(JNIEnv* jenv, JPy_JType* componentType, PyObject* pyAr
     jint index;
     PyObject* pyItem;
 
+    if (componentType->isPrimitive && pyArg != Py_None) {
+        // bytes, bytearray, array.array, NumPy arrays, etc. are copied or converted at once
+        int status = JArray_FromBuffer(jenv, componentType, pyArg, (jarray*) objectRef);
+        if (status != 0) {
+            return status < 0 ? -1 : 0;
+        }
+    }
+
     if (pyArg == Py_None) {
         itemCount = 0;
     } else if (PySequence_Check(pyArg)) {
@@ -716,13 +1014,27 @@ int JType_CreateJavaArray(JNIEnv* jenv, JPy_JType* componentType, PyObject* pyAr
             JPy_HandleJavaException(jenv);
             return -1;
         }
+        // Item conversions create new local references (e.g. boxed primitives, strings, nested arrays).
+        // Release them chunk-wise, so that large sequences don't overflow the local reference table.
+        if (JPy_PushLocalFrame(jenv) < 0) {
+            (*jenv)->DeleteLocalRef(jenv, arrayRef);
+            JPy_HandleJavaException(jenv);
+            return -1;
+        }
         for (index = 0; index < itemCount; index++) {
+            if (JPy_RenewLocalFrame(jenv, index) < 0) {
+                (*jenv)->DeleteLocalRef(jenv, arrayRef);
+                JPy_HandleJavaException(jenv);
+                return -1;
+            }
             pyItem = PySequence_GetItem(pyArg, index);
             if (pyItem == NULL) {
+                (*jenv)->PopLocalFrame(jenv, NULL);
                 (*jenv)->DeleteLocalRef(jenv, arrayRef);
                 return -1;
             }
             if (JType_ConvertPythonToJavaObject(jenv, componentType, pyItem, &jItem, allowObjectWrapping) < 0) {
+                (*jenv)->PopLocalFrame(jenv, NULL);
                 (*jenv)->DeleteLocalRef(jenv, arrayRef);
                 Py_DECREF(pyItem);
                 return -1;
@@ -730,12 +1042,13 @@ int JType_CreateJavaArray(JNIEnv* jenv, JPy_JType* componentType, PyObject* pyAr
             Py_DECREF(pyItem);
             (*jenv)->SetObjectArrayElement(jenv, arrayRef, index, jItem);
             if ((*jenv)->ExceptionCheck(jenv)) {
-                (*jenv)->DeleteLocalRef(jenv, arrayRef);
-                (*jenv)->DeleteLocalRef(jenv, jItem);
                 JPy_HandleJavaException(jenv);
+                (*jenv)->PopLocalFrame(jenv, NULL);
+                (*jenv)->DeleteLocalRef(jenv, arrayRef);
                 return -1;
             }
         }
+        (*jenv)->PopLocalFrame(jenv, NULL);
     } else {
         PyErr_Format(PyExc_ValueError, "illegal Java array component type %s", componentType->javaName);
         return -1;
@@ -784,17 +1097,17 @@ int JType_ConvertPythonToJavaObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyA
         return JType_CreateJavaDoubleObject(jenv, type, pyArg, objectRef);
     } else if (type == JPy_JPyObject) {
         return JType_CreateJavaPyObject(jenv, type, pyArg, objectRef);
-    } else if (JPy_IS_STR(pyArg) && (type == JPy_JString || type == JPy_JObject || ((*jenv)->IsAssignableFrom(jenv, JPy_JString->classRef, type->classRef)))) {
+    } else if (JPy_IS_STR(pyArg) && (type == JPy_JString || type == JPy_JObject || JType_IsAssignableFrom(jenv, type, JPy_JString))) {
         return JPy_AsJString(jenv, pyArg, objectRef);
-    } else if (PyBool_Check(pyArg) && (type == JPy_JObject || ((*jenv)->IsAssignableFrom(jenv, JPy_Boolean_JClass, type->classRef)))) {
+    } else if (PyBool_Check(pyArg) && (type == JPy_JObject || JType_IsAssignableFrom(jenv, type, JPy_JBooleanObj))) {
         return JType_CreateJavaBooleanObject(jenv, type, pyArg, objectRef);
-    } else if (JPy_IS_CLONG(pyArg) && (type == JPy_JObject || ((*jenv)->IsAssignableFrom(jenv, JPy_Integer_JClass, type->classRef)))) {
+    } else if (JPy_IS_CLONG(pyArg) && (type == JPy_JObject || JType_IsAssignableFrom(jenv, type, JPy_JIntegerObj))) {
         return JType_CreateJavaIntegerObject(jenv, type, pyArg, objectRef);
-    } else if (JPy_IS_CLONG(pyArg) && (type == JPy_JObject || ((*jenv)->IsAssignableFrom(jenv, JPy_Long_JClass, type->classRef)))) {
+    } else if (JPy_IS_CLONG(pyArg) && (type == JPy_JObject || JType_IsAssignableFrom(jenv, type, JPy_JLongObj))) {
         return JType_CreateJavaLongObject(jenv, type, pyArg, objectRef);
-    } else if (PyFloat_Check(pyArg) && (type == JPy_JObject || ((*jenv)->IsAssignableFrom(jenv, JPy_Double_JClass, type->classRef)))) {
+    } else if (PyFloat_Check(pyArg) && (type == JPy_JObject || JType_IsAssignableFrom(jenv, type, JPy_JDoubleObj))) {
         return JType_CreateJavaDoubleObject(jenv, type, pyArg, objectRef);
-    } else if (PyFloat_Check(pyArg) && (type == JPy_JObject || ((*jenv)->IsAssignableFrom(jenv, JPy_Float_JClass, type->classRef)))) {
+    } else if (PyFloat_Check(pyArg) && (type == JPy_JObject || JType_IsAssignableFrom(jenv, type, JPy_JFloatObj))) {
         return JType_CreateJavaFloatObject(jenv, type, pyArg, objectRef);
     } else if (type == JPy_JObject && allowObjectWrapping) {
         return JType_CreateJavaPyObject(jenv, JPy_JPyObject, pyArg, objectRef);
@@ -807,77 +1120,146 @@ int JType_ConvertPythonToJavaObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyA
 // The following functions deal with type creation, initialisation, and resolution.
 
 
+/**
+ * A type being resolved by the current thread. Its constructors, methods and fields are collected in
+ * 'typeDict' and only published into the type's __dict__ once they are all processed.
+ */
+typedef struct JType_Resolution
+{
+    JPy_JType* type;
+    PyObject* typeDict;
+    // The resolution of the type the current thread resolved before this one, e.g. a subtype.
+    struct JType_Resolution* previous;
+}
+JType_Resolution;
+
+static JPy_THREAD_LOCAL JType_Resolution* JType_CurrentResolution = NULL;
+
+static JType_Resolution* JType_FindResolution(JPy_JType* type)
+{
+    JType_Resolution* resolution;
+    for (resolution = JType_CurrentResolution; resolution != NULL; resolution = resolution->previous) {
+        if (resolution->type == type) {
+            return resolution;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Returns the dictionary collecting the attributes of the given type (borrowed ref): the one of its pending
+ * resolution if it is being resolved by the current thread, its __dict__ otherwise.
+ */
+static PyObject* JType_GetResolutionDict(JPy_JType* type)
+{
+    JType_Resolution* resolution = JType_FindResolution(type);
+    PyObject* typeDict = resolution != NULL ? resolution->typeDict : type->typeObj.tp_dict;
+    if (typeDict == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "jpy internal error: missing attribute '__dict__' in JType");
+    }
+    return typeDict;
+}
+
 /**
  * Fill the type __dict__ with our Java class constructors and methods.
  * Constructors will be available using the key named __jinit__.
  * Methods will be available using their method name.
+ *
+ * The Java class is introspected without holding the global lock, which could otherwise deadlock with a
+ * class initialisation running on another thread. Threads concurrently resolving the same type each collect
+ * its attributes, and the first one to finish publishes them. A thread asked to resolve a type it is
+ * already resolving returns immediately.
  */
 int JType_ResolveType(JNIEnv* jenv, JPy_JType* type)
 {
+    JType_Resolution resolution;
     PyTypeObject* typeObj;
+    long long traceStart;
+    int result;
 
-    if (type->isResolved || type->isResolving) {
+    if (JType_IS_RESOLVED(type) || JType_FindResolution(type) != NULL) {
         return 0;
     }
 
-    type->isResolving = JNI_TRUE;
-
     typeObj = (PyTypeObject*) type;
     if (typeObj->tp_base != NULL && JType_Check((PyObject*) typeObj->tp_base)) {
         JPy_JType* baseType = (JPy_JType*) typeObj->tp_base;
-        if (!baseType->isResolved) {
-            if (JType_ResolveType(jenv, baseType) < 0) {
-                type->isResolving = JNI_FALSE;
-                return -1;
-            }
+        if (JType_ResolveType(jenv, baseType) < 0) {
+            return -1;
         }
     }
 
-    //printf("JType_ResolveType 1\n");
-    if (JType_ProcessClassConstructors(jenv, type) < 0) {
-        type->isResolving = JNI_FALSE;
+    resolution.typeDict = PyDict_New();
+    if (resolution.typeDict == NULL) {
         return -1;
     }
+    resolution.type = type;
+    resolution.previous = JType_CurrentResolution;
+    JType_CurrentResolution = &resolution;
+
+    traceStart = JPy_TRACE_BEGIN();
+
+    //printf("JType_ResolveType 1\n");
+    result = JType_ProcessClassConstructors(jenv, type);
 
     //printf("JType_ResolveType 2\n");
-    if (JType_ProcessClassMethods(jenv, type) < 0) {
-        type->isResolving = JNI_FALSE;
-        return -1;
+    if (result >= 0) {
+        result = JType_ProcessClassMethods(jenv, type);
     }
 
     //printf("JType_ResolveType 3\n");
-    if (JType_ProcessClassFields(jenv, type) < 0) {
-        type->isResolving = JNI_FALSE;
-        return -1;
+    if (result >= 0) {
+        result = JType_ProcessClassFields(jenv, type);
     }
 
+    JType_CurrentResolution = resolution.previous;
+
     //printf("JType_ResolveType 4\n");
-    type->isResolving = JNI_FALSE;
-    type->isResolved = JNI_TRUE;
-    return 0;
+    if (result >= 0) {
+        JPy_BEGIN_GLOBAL_LOCK
+        if (!type->isResolved) {
+            // Attributes set before resolution, such as 'jclass', take precedence
+            result = PyDict_Merge(typeObj->tp_dict, resolution.typeDict, 0);
+            if (result >= 0) {
+                PyType_Modified(typeObj);
+                JType_SET_RESOLVED(type, JNI_TRUE);
+                JPy_STAT_INC(JPy_STAT_TYPES_RESOLVED);
+            }
+        }
+        JPy_END_GLOBAL_LOCK
+    }
+
+    Py_DECREF(resolution.typeDict);
+    if (result >= 0) {
+        JPy_TRACE_END(traceStart, JPy_TRACE_TYPE_RESOLUTION, type, 0);
+    }
+    return result < 0 ? -1 : 0;
 }
 
 jboolean JType_AcceptMethod(JPy_JType* declaringClass, JPy_JMethod* method)
 {
     PyObject* callable;
     PyObject* callableResult;
+    jboolean accept = JNI_TRUE;
 
     //printf("JType_AcceptMethod: javaName='%s'\n", overloadedMethod->declaringClass->javaName);
 
-    callable = PyDict_GetItemString(JPy_Type_Callbacks, declaringClass->javaName);
+    callable = JPy_GetDictItemString(JPy_Type_Callbacks, declaringClass->javaName);
     if (callable != NULL) {
         if (PyCallable_Check(callable)) {
             callableResult = PyObject_CallFunction(callable, "OO", declaringClass, method);
             if (callableResult == Py_None || callableResult == Py_False) {
-                return JNI_FALSE;
+                accept = JNI_FALSE;
             } else if (callableResult == NULL) {
                 JPy_DIAG_PRINT(JPy_DIAG_F_TYPE, "JType_AcceptMethod: warning: failed to invoke callback on method addition\n");
                 // Ignore this problem and continue
             }
+            Py_XDECREF(callableResult);
         }
+        Py_DECREF(callable);
     }
 
-    return JNI_TRUE;
+    return accept;
 }
 
 
@@ -921,7 +1303,7 @@ int JType_ProcessMethod(JNIEnv* jenv, JPy_JType* type, PyObject* methodKey, cons
     }
 
     if (JType_AcceptMethod(type, method)) {
-        JType_InitMethodParamDescriptorFunctions(type, method);
+        JType_InitMethodParamDescriptorFunctions(jenv, type, method);
         JType_AddMethod(type, method);
     } else {
         JMethod_Del(method);
@@ -1092,7 +1474,19 @@ int JType_ProcessClassMethods(JNIEnv* jenv, JPy_JType* type)
 
     JPy_DIAG_PRINT(JPy_DIAG_F_TYPE, "JType_ProcessClassMethods: methodCount=%d\n", methodCount);
 
+    // Processing a method creates local references we don't see here, e.g. for its parameter classes.
+    if (JPy_PushLocalFrame(jenv) < 0) {
+        (*jenv)->DeleteLocalRef(jenv, methods);
+        JPy_HandleJavaException(jenv);
+        return -1;
+    }
+
     for (i = 0; i < methodCount; i++) {
+        if (JPy_RenewLocalFrame(jenv, i) < 0) {
+            (*jenv)->DeleteLocalRef(jenv, methods);
+            JPy_HandleJavaException(jenv);
+            return -1;
+        }
         method = (*jenv)->GetObjectArrayElement(jenv, methods, i);
         modifiers = (*jenv)->CallIntMethod(jenv, method, JPy_Method_GetModifiers_MID);
         // see http://docs.oracle.com/javase/6/docs/api/constant-values.html#java.lang.reflect.Modifier.PUBLIC
@@ -1118,6 +1512,7 @@ int JType_ProcessClassMethods(JNIEnv* jenv, JPy_JType* type)
         }
         (*jenv)->DeleteLocalRef(jenv, method);
     }
+    (*jenv)->PopLocalFrame(jenv, NULL);
     (*jenv)->DeleteLocalRef(jenv, methods);
     return 0;
 }
@@ -1131,9 +1526,8 @@ int JType_AddField(JPy_JType* declaringClass, JPy_JField* field)
 {
     PyObject* typeDict;
 
-    typeDict = declaringClass->typeObj.tp_dict;
+    typeDict = JType_GetResolutionDict(declaringClass);
     if (typeDict == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "jpy internal error: missing attribute '__dict__' in JType");
         return -1;
     }
 
@@ -1160,9 +1554,8 @@ int JType_AddFieldAttribute(JNIEnv* jenv, JPy_JType* declaringClass, PyObject* f
     PyObject* typeDict;
     PyObject* fieldValue;
 
-    typeDict = declaringClass->typeObj.tp_dict;
+    typeDict = JType_GetResolutionDict(declaringClass);
     if (typeDict == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "jpy internal error: missing attribute '__dict__' in JType");
         return -1;
     }
 
@@ -1241,11 +1634,11 @@ int JType_ProcessField(JNIEnv* jenv, JPy_JType* declaringClass, PyObject* fieldK
 }
 
 
-void JType_InitMethodParamDescriptorFunctions(JPy_JType* type, JPy_JMethod* method)
+void JType_InitMethodParamDescriptorFunctions(JNIEnv* jenv, JPy_JType* type, JPy_JMethod* method)
 {
     int index;
     for (index = 0; index < method->paramCount; index++) {
-        JType_InitParamDescriptorFunctions(method->paramDescriptors + index, index == method->paramCount - 1 && method->isVarArgs);
+        JType_InitParamDescriptorFunctions(jenv, method->paramDescriptors + index, index == method->paramCount - 1 && method->isVarArgs);
     }
 }
 
@@ -1255,9 +1648,8 @@ int JType_AddMethod(JPy_JType* type, JPy_JMethod* method)
     PyObject* methodValue;
     JPy_JOverloadedMethod* overloadedMethod;
 
-    typeDict = type->typeObj.tp_dict;
+    typeDict = JType_GetResolutionDict(type);
     if (typeDict == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "jpy internal error: missing attribute '__dict__' in JType");
         return -1;
     }
 
@@ -1369,6 +1761,8 @@ JPy_ParamDescriptor* JType_CreateParamDescriptors(JNIEnv* jenv, int paramCount,
         paramDescriptor->isMutable = 0;
         paramDescriptor->isOutput = 0;
         paramDescriptor->isReturn = 0;
+        paramDescriptor->isPooled = 0;
+        paramDescriptor->argKinds = JPy_ARG_KIND_ANY;
         paramDescriptor->MatchPyArg = NULL;
         paramDescriptor->MatchVarArgPyArg = NULL;
         paramDescriptor->ConvertPyArg = NULL;
@@ -1709,6 +2103,93 @@ int JType_MatchVarArgPyArgAsFPType(const JPy_ParamDescriptor *paramDescriptor, P
     return minMatch;
 }
 
+static JPy_THREAD_LOCAL JPy_CallScratch* JType_CurrentCallScratch = NULL;
+
+void JType_BeginCallScratch(JPy_CallScratch* scratch)
+{
+    scratch->previous = JType_CurrentCallScratch;
+    scratch->bufferCount = 0;
+    JType_CurrentCallScratch = scratch;
+}
+
+void JType_EndCallScratch(JPy_CallScratch* scratch)
+{
+    int i;
+    for (i = 0; i < scratch->bufferCount; i++) {
+        PyBuffer_Release(scratch->buffers[i]);
+        PyMem_Del(scratch->buffers[i]);
+    }
+    scratch->bufferCount = 0;
+    JType_CurrentCallScratch = scratch->previous;
+}
+
+/**
+ * Returns the PyBUF_FORMAT view of pyArg kept in the current call scratch context, acquiring it if not yet kept.
+ * Returns NULL without an error set if there is no current context or it is full, and NULL with an error set
+ * if the buffer could not be acquired.
+ */
+static Py_buffer* JType_GetCallScratchBuffer(PyObject* pyArg)
+{
+    JPy_CallScratch* scratch = JType_CurrentCallScratch;
+    Py_buffer* pyBuffer;
+    int i;
+
+    if (scratch == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < scratch->bufferCount; i++) {
+        if (scratch->bufferArgs[i] == pyArg) {
+            return scratch->buffers[i];
+        }
+    }
+    if (scratch->bufferCount == JPy_CALL_SCRATCH_BUFFER_COUNT) {
+        return NULL;
+    }
+
+    pyBuffer = PyMem_New(Py_buffer, 1);
+    if (pyBuffer == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    if (PyObject_GetBuffer(pyArg, pyBuffer, PyBUF_FORMAT) < 0) {
+        PyMem_Del(pyBuffer);
+        return NULL;
+    }
+    JPy_STAT_INC(JPy_STAT_BUFFER_ACQUISITIONS);
+    scratch->bufferArgs[scratch->bufferCount] = pyArg;
+    scratch->buffers[scratch->bufferCount] = pyBuffer;
+    scratch->bufferCount++;
+    return pyBuffer;
+}
+
+/**
+ * Removes the view of pyArg from the current call scratch context and passes its ownership to the caller.
+ * Returns NULL if there is no such view or, if a writable view is required, the kept view is read-only.
+ */
+static Py_buffer* JType_TakeCallScratchBuffer(PyObject* pyArg, jboolean writable)
+{
+    JPy_CallScratch* scratch = JType_CurrentCallScratch;
+    Py_buffer* pyBuffer;
+    int i;
+
+    if (scratch == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < scratch->bufferCount; i++) {
+        if (scratch->bufferArgs[i] == pyArg) {
+            pyBuffer = scratch->buffers[i];
+            if (writable && pyBuffer->readonly) {
+                return NULL;
+            }
+            scratch->bufferCount--;
+            scratch->bufferArgs[i] = scratch->bufferArgs[scratch->bufferCount];
+            scratch->buffers[i] = scratch->buffers[scratch->bufferCount];
+            return pyBuffer;
+        }
+    }
+    return NULL;
+}
+
 int JType_ConvertVarArgPyArgToJObjectArg(JNIEnv* jenv, JPy_ParamDescriptor* paramDescriptor, PyObject* pyArgOrig, int offset, jvalue* value, JPy_ArgDisposer* disposer)
 {
     Py_ssize_t size = PyTuple_Size(pyArgOrig);
@@ -1821,6 +2302,7 @@ int JType_ConvertVarArgPyArgToJObjectArg(JNIEnv* jenv, JPy_ParamDescriptor* para
                 JPy_DIAG_PRINT(JPy_DIAG_F_EXEC|JPy_DIAG_F_MEM, "JType_ConvertPyArgToJObjectArg: moving Python buffer into Java array: pyBuffer->buf=%p, pyBuffer->len=%d\n", pyBuffer->buf, pyBuffer->len);
                 memcpy(arrayItems, pyBuffer->buf, itemCount * itemSize);
                 (*jenv)->ReleasePrimitiveArrayCritical(jenv, jArray, arrayItems, 0);
+                JPy_STAT_ADD(JPy_STAT_BUFFER_BYTES_COPIED, itemCount * itemSize);
             }
 
             value->l = jArray;
@@ -1864,7 +2346,8 @@ int JType_MatchPyArgAsJObject(JNIEnv* jenv, JPy_JType* paramType, PyObject* pyAr
         }
 
         argValue = (JPy_JObj*) pyArg;
-        if ((*jenv)->IsInstanceOf(jenv, argValue->objectRef, paramType->classRef)) {
+        // The object is an instance of its declared type, so that IsInstanceOf() is only needed if that doesn't suffice
+        if (JType_IsAssignableFrom(jenv, paramType, argType) || (*jenv)->IsInstanceOf(jenv, argValue->objectRef, paramType->classRef)) {
             argComponentType = argType->componentType;
             if (argComponentType == paramComponentType) {
                 // pyArg is an instance of parameter type, and they both have the same component types (which may be null)
@@ -1872,7 +2355,7 @@ int JType_MatchPyArgAsJObject(JNIEnv* jenv, JPy_JType* paramType, PyObject* pyAr
             }
             if (argComponentType != NULL && paramComponentType != NULL) {
                 // Determines whether an object of clazz1 can be safely cast to clazz2.
-                if ((*jenv)->IsAssignableFrom(jenv, argComponentType->classRef, paramComponentType->classRef)) {
+                if (JType_IsAssignableFrom(jenv, paramComponentType, argComponentType)) {
                     // pyArg is an instance of parameter array type, and component types are compatible
                     return 80;
                 }
@@ -1891,85 +2374,97 @@ int JType_MatchPyArgAsJObject(JNIEnv* jenv, JPy_JType* paramType, PyObject* pyAr
         // The parameter type is an array type
 
         if (paramComponentType->isPrimitive && PyObject_CheckBuffer(pyArg)) {
-            Py_buffer view;
+            Py_buffer localView;
+            Py_buffer* pyBuffer;
 
-            // The parameter type is a primitive array type, pyArg is a Python buffer object
+            // The parameter type is a primitive array type, pyArg is a Python buffer object.
+            // Keep the view in the current call's scratch context, so that converting pyArg won't acquire it again.
 
-            if (PyObject_GetBuffer(pyArg, &view, PyBUF_FORMAT) == 0) {
+            pyBuffer = JType_GetCallScratchBuffer(pyArg);
+            if (pyBuffer == NULL && !PyErr_Occurred()) {
+                if (PyObject_GetBuffer(pyArg, &localView, PyBUF_FORMAT) == 0) {
+                    JPy_STAT_INC(JPy_STAT_BUFFER_ACQUISITIONS);
+                    pyBuffer = &localView;
+                }
+            }
+
+            if (pyBuffer != NULL) {
                 JPy_JType* type;
                 int matchValue;
 
-                //printf("JType_AssessToJObject: buffer len=%d, itemsize=%d, format=%s\n", view.len, view.itemsize, view.format);
+                //printf("JType_AssessToJObject: buffer len=%d, itemsize=%d, format=%s\n", pyBuffer->len, pyBuffer->itemsize, pyBuffer->format);
 
                 type = paramComponentType;
                 matchValue = 0;
-                if (view.format != NULL) {
-                    char format = *view.format;
+                if (pyBuffer->format != NULL) {
+                    char format = *pyBuffer->format;
                     if (type == JPy_JBoolean) {
                         matchValue = format == 'b' || format == 'B' ? 100
-                                   : view.itemsize == 1 ? 10
+                                   : pyBuffer->itemsize == 1 ? 10
                                    : 0;
                     } else if (type == JPy_JByte) {
                         matchValue = format == 'b' ? 100
                                    : format == 'B' ? 90
-                                   : view.itemsize == 1 ? 10
+                                   : pyBuffer->itemsize == 1 ? 10
                                    : 0;
                     } else if (type == JPy_JChar) {
                         matchValue = format == 'u' ? 100
                                    : format == 'H' ? 90
                                    : format == 'h' ? 80
-                                   : view.itemsize == 2 ? 10
+                                   : pyBuffer->itemsize == 2 ? 10
                                    : 0;
                     } else if (type == JPy_JShort) {
                         matchValue = format == 'h' ? 100
                                    : format == 'H' ? 90
-                                   : view.itemsize == 2 ? 10
+                                   : pyBuffer->itemsize == 2 ? 10
                                    : 0;
                     } else if (type == JPy_JInt) {
                         matchValue = format == 'i' || format == 'l' ? 100
                                    : format == 'I' || format == 'L' ? 90
-                                   : view.itemsize == 4 ? 10
+                                   : pyBuffer->itemsize == 4 ? 10
                                    : 0;
                     } else if (type == JPy_JLong) {
                         matchValue = format == 'q' ? 100
                                    : format == 'Q' ? 90
-                                   : view.itemsize == 8 ? 10
+                                   : pyBuffer->itemsize == 8 ? 10
                                    : 0;
                     } else if (type == JPy_JFloat) {
                         matchValue = format == 'f' ? 100
-                                   : view.itemsize == 4 ? 10
+                                   : pyBuffer->itemsize == 4 ? 10
                                    : 0;
                     } else if (type == JPy_JDouble) {
                         matchValue = format == 'd' ? 100
-                                   : view.itemsize == 8 ? 10
+                                   : pyBuffer->itemsize == 8 ? 10
                                    : 0;
                     }
                 } else {
                     if (type == JPy_JBoolean) {
-                        matchValue = view.itemsize == 1 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 1 ? 10 : 0;
                     } else if (type == JPy_JByte) {
-                        matchValue = view.itemsize == 1 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 1 ? 10 : 0;
                     } else if (type == JPy_JChar) {
-                        matchValue = view.itemsize == 2 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 2 ? 10 : 0;
                     } else if (type == JPy_JShort) {
-                        matchValue = view.itemsize == 2 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 2 ? 10 : 0;
                     } else if (type == JPy_JInt) {
-                        matchValue = view.itemsize == 4 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 4 ? 10 : 0;
                     } else if (type == JPy_JLong) {
-                        matchValue = view.itemsize == 8 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 8 ? 10 : 0;
                     } else if (type == JPy_JFloat) {
-                        matchValue = view.itemsize == 4 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 4 ? 10 : 0;
                     } else if (type == JPy_JDouble) {
-                        matchValue = view.itemsize == 8 ? 10 : 0;
+                        matchValue = pyBuffer->itemsize == 8 ? 10 : 0;
                     }
                 }
 
-                PyBuffer_Release(&view);
+                if (pyBuffer == &localView) {
+                    PyBuffer_Release(&localView);
+                }
                 return matchValue;
             }
         } else if (PySequence_Check(pyArg)) {
             // if we know the type of the array is a string, we should preferentially match it
-            if ((*jenv)->IsAssignableFrom(jenv, paramComponentType->classRef, JPy_String_JClass)) {
+            if (JType_IsAssignableFrom(jenv, JPy_JString, paramComponentType)) {
                 // it's a string array
                 Py_ssize_t len = PySequence_Length(pyArg);
                 Py_ssize_t ii;
@@ -2017,28 +2512,28 @@ int JType_MatchPyArgAsJObject(JNIEnv* jenv, JPy_JType* paramType, PyObject* pyAr
         }
     } else {
         if (JPy_IS_STR(pyArg)) {
-            if ((*jenv)->IsAssignableFrom(jenv, JPy_JString->classRef, paramType->classRef)) {
+            if (JType_IsAssignableFrom(jenv, paramType, JPy_JString)) {
                 return 80;
             }
         }
         else if (PyBool_Check(pyArg)) {
-            if ((*jenv)->IsAssignableFrom(jenv, JPy_Boolean_JClass, paramType->classRef)) {
+            if (JType_IsAssignableFrom(jenv, paramType, JPy_JBooleanObj)) {
                 return 80;
             }
         }
         else if (JPy_IS_CLONG(pyArg)) {
-            if ((*jenv)->IsAssignableFrom(jenv, JPy_Integer_JClass, paramType->classRef)) {
+            if (JType_IsAssignableFrom(jenv, paramType, JPy_JIntegerObj)) {
                 return 80;
             }
-            else if ((*jenv)->IsAssignableFrom(jenv, JPy_Long_JClass, paramType->classRef)) {
+            else if (JType_IsAssignableFrom(jenv, paramType, JPy_JLongObj)) {
                 return 80;
             }
         }
         else if (PyFloat_Check(pyArg)) {
-            if ((*jenv)->IsAssignableFrom(jenv, JPy_Double_JClass, paramType->classRef)) {
+            if (JType_IsAssignableFrom(jenv, paramType, JPy_JDoubleObj)) {
                 return 80;
             }
-            else if ((*jenv)->IsAssignableFrom(jenv, JPy_Float_JClass, paramType->classRef)) {
+            else if (JType_IsAssignableFrom(jenv, paramType, JPy_JFloatObj)) {
                 return 80;
             }
         }
@@ -2047,6 +2542,86 @@ int JType_MatchPyArgAsJObject(JNIEnv* jenv, JPy_JType* paramType, PyObject* pyAr
     return 0;
 }
 
+int JType_GetArgKind(PyObject* pyArg)
+{
+    if (pyArg == Py_None) {
+        return JPy_ARG_KIND_NONE;
+    } else if (JObj_Check(pyArg)) {
+        return JPy_ARG_KIND_JOBJ;
+    } else if (PyBool_Check(pyArg)) {
+        return JPy_ARG_KIND_BOOL;
+    } else if (JPy_IS_CLONG_EXACT(pyArg)) {
+        return JPy_ARG_KIND_INT;
+    } else if (PyFloat_CheckExact(pyArg)) {
+        return JPy_ARG_KIND_FLOAT;
+    } else if (JPy_IS_STR_EXACT(pyArg)) {
+        return JPy_ARG_KIND_STR;
+    }
+    return JPy_ARG_KIND_OTHER;
+}
+
+/**
+ * Computes the kinds of Python arguments the parameter's MatchPyArg function may accept, so that overload resolution
+ * can skip methods without calling it. The result must be a superset of what the match functions above accept.
+ */
+static unsigned char JType_GetParamArgKinds(JNIEnv* jenv, JPy_ParamDescriptor* paramDescriptor)
+{
+    JPy_JType* paramType = paramDescriptor->type;
+    JPy_MatchPyArg matchPyArg = paramDescriptor->MatchPyArg;
+    unsigned char argKinds;
+
+    if (matchPyArg == JType_MatchPyArgAsJBooleanParam
+        || matchPyArg == JType_MatchPyArgAsJByteParam
+        || matchPyArg == JType_MatchPyArgAsJCharParam
+        || matchPyArg == JType_MatchPyArgAsJShortParam
+        || matchPyArg == JType_MatchPyArgAsJIntParam
+        || matchPyArg == JType_MatchPyArgAsJLongParam) {
+        return JPy_ARG_KIND_BOOL | JPy_ARG_KIND_INT | JPy_ARG_KIND_OTHER;
+    } else if (matchPyArg == JType_MatchPyArgAsJFloatParam
+               || matchPyArg == JType_MatchPyArgAsJDoubleParam) {
+        // Java objects may implement the number protocol
+        return JPy_ARG_KIND_ANY & ~(JPy_ARG_KIND_NONE | JPy_ARG_KIND_STR);
+    } else if (matchPyArg == JType_MatchPyArgAsJStringParam) {
+        return JPy_ARG_KIND_NONE | JPy_ARG_KIND_STR | JPy_ARG_KIND_OTHER;
+    } else if (matchPyArg != JType_MatchPyArgAsJObjectParam) {
+        return JPy_ARG_KIND_ANY;
+    }
+
+    argKinds = JPy_ARG_KIND_NONE | JPy_ARG_KIND_JOBJ | JPy_ARG_KIND_OTHER;
+    if (paramType->componentType != NULL) {
+        // Strings are sequences
+        argKinds |= JPy_ARG_KIND_STR;
+    } else if (paramType == JPy_JObject) {
+        argKinds = JPy_ARG_KIND_ANY;
+    } else if (paramType == JPy_JBooleanObj
+               || paramType == JPy_JCharacterObj
+               || paramType == JPy_JByteObj
+               || paramType == JPy_JShortObj
+               || paramType == JPy_JIntegerObj
+               || paramType == JPy_JLongObj) {
+        argKinds |= JPy_ARG_KIND_BOOL | JPy_ARG_KIND_INT;
+    } else if (paramType == JPy_JFloatObj
+               || paramType == JPy_JDoubleObj) {
+        argKinds |= JPy_ARG_KIND_BOOL | JPy_ARG_KIND_INT | JPy_ARG_KIND_FLOAT;
+    } else {
+        if (JType_IsAssignableFrom(jenv, paramType, JPy_JString)) {
+            argKinds |= JPy_ARG_KIND_STR;
+        }
+        if (JType_IsAssignableFrom(jenv, paramType, JPy_JBooleanObj)) {
+            argKinds |= JPy_ARG_KIND_BOOL;
+        }
+        if (JType_IsAssignableFrom(jenv, paramType, JPy_JIntegerObj)
+            || JType_IsAssignableFrom(jenv, paramType, JPy_JLongObj)) {
+            argKinds |= JPy_ARG_KIND_INT;
+        }
+        if (JType_IsAssignableFrom(jenv, paramType, JPy_JDoubleObj)
+            || JType_IsAssignableFrom(jenv, paramType, JPy_JFloatObj)) {
+            argKinds |= JPy_ARG_KIND_FLOAT;
+        }
+    }
+    return argKinds;
+}
+
 int JType_ConvertPyArgToJObjectArg(JNIEnv* jenv, JPy_ParamDescriptor* paramDescriptor, PyObject* pyArg, jvalue* value, JPy_ArgDisposer* disposer)
 {
     if (pyArg == Py_None) {
@@ -2075,16 +2650,21 @@ int JType_ConvertPyArgToJObjectArg(JNIEnv* jenv, JPy_ParamDescriptor* paramDescr
             void* arrayItems;
             jint itemSize;
 
-            pyBuffer = PyMem_New(Py_buffer, 1);
+            // Take over the view acquired while matching pyArg, if any
+            pyBuffer = JType_TakeCallScratchBuffer(pyArg, paramDescriptor->isMutable);
             if (pyBuffer == NULL) {
-                PyErr_NoMemory();
-                return -1;
-            }
+                pyBuffer = PyMem_New(Py_buffer, 1);
+                if (pyBuffer == NULL) {
+                    PyErr_NoMemory();
+                    return -1;
+                }
 
-            flags = paramDescriptor->isMutable ? PyBUF_WRITABLE : PyBUF_SIMPLE;
-            if (PyObject_GetBuffer(pyArg, pyBuffer, flags) < 0) {
-                PyMem_Del(pyBuffer);
-                return -1;
+                flags = paramDescriptor->isMutable ? PyBUF_WRITABLE : PyBUF_SIMPLE;
+                if (PyObject_GetBuffer(pyArg, pyBuffer, flags) < 0) {
+                    PyMem_Del(pyBuffer);
+                    return -1;
+                }
+                JPy_STAT_INC(JPy_STAT_BUFFER_ACQUISITIONS);
             }
 
             itemCount = pyBuffer->len / pyBuffer->itemsize;
@@ -2096,28 +2676,20 @@ int JType_ConvertPyArgToJObjectArg(JNIEnv* jenv, JPy_ParamDescriptor* paramDescr
             }
 
             if (paramComponentType == JPy_JBoolean) {
-                jArray = (*jenv)->NewBooleanArray(jenv, itemCount);
                 itemSize = sizeof(jboolean);
             } else if (paramComponentType == JPy_JByte) {
-                jArray = (*jenv)->NewByteArray(jenv, itemCount);
                 itemSize = sizeof(jbyte);
             } else if (paramComponentType == JPy_JChar) {
-                jArray = (*jenv)->NewCharArray(jenv, itemCount);
                 itemSize = sizeof(jchar);
             } else if (paramComponentType == JPy_JShort) {
-                jArray = (*jenv)->NewShortArray(jenv, itemCount);
                 itemSize = sizeof(jshort);
             } else if (paramComponentType == JPy_JInt) {
-                jArray = (*jenv)->NewIntArray(jenv, itemCount);
                 itemSize = sizeof(jint);
             } else if (paramComponentType == JPy_JLong) {
-                jArray = (*jenv)->NewLongArray(jenv, itemCount);
                 itemSize = sizeof(jlong);
             } else if (paramComponentType == JPy_JFloat) {
-                jArray = (*jenv)->NewFloatArray(jenv, itemCount);
                 itemSize = sizeof(jfloat);
             } else if (paramComponentType == JPy_JDouble) {
-                jArray = (*jenv)->NewDoubleArray(jenv, itemCount);
                 itemSize = sizeof(jdouble);
             } else {
                 PyBuffer_Release(pyBuffer);
@@ -2138,10 +2710,17 @@ int JType_ConvertPyArgToJObjectArg(JNIEnv* jenv, JPy_ParamDescriptor* paramDescr
                 return -1;
             }
 
+            if (paramDescriptor->isPooled) {
+                jArray = JArray_TakeScratchArray(jenv, paramComponentType, (jint) itemCount);
+            } else {
+                jArray = JArray_NewPrimitive(jenv, paramComponentType, (jint) itemCount);
+            }
             if (jArray == NULL) {
                 PyBuffer_Release(pyBuffer);
                 PyMem_Del(pyBuffer);
-                PyErr_NoMemory();
+                if (!PyErr_Occurred()) {
+                    PyErr_NoMemory();
+                }
                 return -1;
             }
 
@@ -2150,17 +2729,23 @@ int JType_ConvertPyArgToJObjectArg(JNIEnv* jenv, JPy_ParamDescriptor* paramDescr
                 if (arrayItems == NULL) {
                     PyBuffer_Release(pyBuffer);
                     PyMem_Del(pyBuffer);
+                    JType_DisposeBufferArgArray(jenv, jArray, paramDescriptor->isPooled);
                     PyErr_NoMemory();
                     return -1;
                 }
                 JPy_DIAG_PRINT(JPy_DIAG_F_EXEC|JPy_DIAG_F_MEM, "JType_ConvertPyArgToJObjectArg: moving Python buffer into Java array: pyBuffer->buf=%p, pyBuffer->len=%d\n", pyBuffer->buf, pyBuffer->len);
                 memcpy(arrayItems, pyBuffer->buf, itemCount * itemSize);
                 (*jenv)->ReleasePrimitiveArrayCritical(jenv, jArray, arrayItems, 0);
+                JPy_STAT_ADD(JPy_STAT_BUFFER_BYTES_COPIED, itemCount * itemSize);
             }
 
             value->l = jArray;
             disposer->data = pyBuffer;
-            disposer->DisposeArg = paramDescriptor->isMutable ? JType_DisposeWritableBufferArg : JType_DisposeReadOnlyBufferArg;
+            if (paramDescriptor->isPooled) {
+                disposer->DisposeArg = paramDescriptor->isMutable ? JType_DisposePooledWritableBufferArg : JType_DisposePooledReadOnlyBufferArg;
+            } else {
+                disposer->DisposeArg = paramDescriptor->isMutable ? JType_DisposeWritableBufferArg : JType_DisposeReadOnlyBufferArg;
+            }
         } else {
             jobject objectRef;
             if (JType_ConvertPythonToJavaObject(jenv, paramType, pyArg, &objectRef, JNI_FALSE) < 0) {
@@ -2184,26 +2769,19 @@ void JType_DisposeLocalObjectRefArg(JNIEnv* jenv, jvalue* value, void* data)
     }
 }
 
-void JType_DisposeReadOnlyBufferArg(JNIEnv* jenv, jvalue* value, void* data)
+/**
+ * Deletes the Java array a buffer argument was passed in, or gives it back to the thread's scratch pool.
+ */
+static void JType_DisposeBufferArgArray(JNIEnv* jenv, jarray jArray, jboolean isPooled)
 {
-    Py_buffer* pyBuffer;
-    jarray jArray;
-
-    pyBuffer = (Py_buffer*) data;
-    jArray = (jarray) value->l;
-
-    JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "JType_DisposeReadOnlyBufferArg: pyBuffer=%p, jArray=%p\n", pyBuffer, jArray);
-
-    if (pyBuffer != NULL) {
-        PyBuffer_Release(pyBuffer);
-        PyMem_Del(pyBuffer);
-    }
-    if (jArray != NULL) {
+    if (isPooled) {
+        JArray_ReleaseScratchArray(jenv, jArray);
+    } else {
         (*jenv)->DeleteLocalRef(jenv, jArray);
     }
 }
 
-void JType_DisposeWritableBufferArg(JNIEnv* jenv, jvalue* value, void* data)
+static void JType_DisposeBufferArg(JNIEnv* jenv, jvalue* value, void* data, jboolean isWritable, jboolean isPooled)
 {
     Py_buffer* pyBuffer;
     jarray jArray;
@@ -2212,28 +2790,48 @@ void JType_DisposeWritableBufferArg(JNIEnv* jenv, jvalue* value, void* data)
     pyBuffer = (Py_buffer*) data;
     jArray = (jarray) value->l;
 
-    JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "JType_DisposeWritableBufferArg: pyBuffer=%p, jArray=%p\n", pyBuffer, jArray);
+    JPy_DIAG_PRINT(JPy_DIAG_F_MEM, "JType_DisposeBufferArg: pyBuffer=%p, jArray=%p, isWritable=%d, isPooled=%d\n", pyBuffer, jArray, isWritable, isPooled);
 
-    if (pyBuffer != NULL && jArray != NULL) {
+    if (isWritable && pyBuffer != NULL && jArray != NULL) {
         // Copy modified array content back into buffer view
         arrayItems = (*jenv)->GetPrimitiveArrayCritical(jenv, jArray, NULL);
         if (arrayItems != NULL) {
-            JPy_DIAG_PRINT(JPy_DIAG_F_EXEC|JPy_DIAG_F_MEM, "JType_DisposeWritableBufferArg: moving Java array into Python buffer: pyBuffer->buf=%p, pyBuffer->len=%d\n", pyBuffer->buf, pyBuffer->len);
+            JPy_DIAG_PRINT(JPy_DIAG_F_EXEC|JPy_DIAG_F_MEM, "JType_DisposeBufferArg: moving Java array into Python buffer: pyBuffer->buf=%p, pyBuffer->len=%d\n", pyBuffer->buf, pyBuffer->len);
             memcpy(pyBuffer->buf, arrayItems, pyBuffer->len);
             (*jenv)->ReleasePrimitiveArrayCritical(jenv, jArray, arrayItems, 0);
+            JPy_STAT_ADD(JPy_STAT_BUFFER_BYTES_COPIED, pyBuffer->len);
         }
-        (*jenv)->DeleteLocalRef(jenv, jArray);
-        PyBuffer_Release(pyBuffer);
-        PyMem_Del(pyBuffer);
-    } else if (pyBuffer != NULL) {
+    }
+    if (pyBuffer != NULL) {
         PyBuffer_Release(pyBuffer);
         PyMem_Del(pyBuffer);
-    } else if (jArray != NULL) {
-        (*jenv)->DeleteLocalRef(jenv, jArray);
     }
+    if (jArray != NULL) {
+        JType_DisposeBufferArgArray(jenv, jArray, isPooled);
+    }
+}
+
+void JType_DisposeReadOnlyBufferArg(JNIEnv* jenv, jvalue* value, void* data)
+{
+    JType_DisposeBufferArg(jenv, value, data, JNI_FALSE, JNI_FALSE);
 }
 
-void JType_InitParamDescriptorFunctions(JPy_ParamDescriptor* paramDescriptor, jboolean isLastVarArg)
+void JType_DisposeWritableBufferArg(JNIEnv* jenv, jvalue* value, void* data)
+{
+    JType_DisposeBufferArg(jenv, value, data, JNI_TRUE, JNI_FALSE);
+}
+
+void JType_DisposePooledReadOnlyBufferArg(JNIEnv* jenv, jvalue* value, void* data)
+{
+    JType_DisposeBufferArg(jenv, value, data, JNI_FALSE, JNI_TRUE);
+}
+
+void JType_DisposePooledWritableBufferArg(JNIEnv* jenv, jvalue* value, void* data)
+{
+    JType_DisposeBufferArg(jenv, value, data, JNI_TRUE, JNI_TRUE);
+}
+
+void JType_InitParamDescriptorFunctions(JNIEnv* jenv, JPy_ParamDescriptor* paramDescriptor, jboolean isLastVarArg)
 {
     JPy_JType* paramType = paramDescriptor->type;
 
@@ -2274,6 +2872,7 @@ void JType_InitParamDescriptorFunctions(JPy_ParamDescriptor* paramDescriptor, jb
         paramDescriptor->MatchPyArg = JType_MatchPyArgAsJObjectParam;
         paramDescriptor->ConvertPyArg = JType_ConvertPyArgToJObjectArg;
     }
+    paramDescriptor->argKinds = JType_GetParamArgKinds(jenv, paramDescriptor);
     if (isLastVarArg) {
         paramDescriptor->ConvertVarArgPyArg = JType_ConvertVarArgPyArgToJObjectArg;
 
@@ -2350,6 +2949,7 @@ void JType_dealloc(JPy_JType* self)
 
     if (jenv != NULL && self->classRef != NULL) {
         (*jenv)->DeleteGlobalRef(jenv, self->classRef);
+        JPy_STAT_INC(JPy_STAT_GLOBAL_REFS_DELETED);
         self->classRef = NULL;
     }
 
@@ -2359,6 +2959,9 @@ void JType_dealloc(JPy_JType* self)
     Py_XDECREF(self->componentType);
     self->componentType = NULL;
 
+    Py_XDECREF(self->translation);
+    self->translation = NULL;
+
     Py_TYPE(self)->tp_free((PyObject*) self);
 }
 
@@ -2369,7 +2972,8 @@ PyObject* JType_getattro(JPy_JType* self, PyObject* name)
 {
     //printf("JType_getattro: %s.%s\n", Py_TYPE(self)->tp_name, JPy_AS_UTF8(name));
 
-    if (!self->isResolved && !self->isResolving) {
+    // JType_ResolveType() returns immediately if this type is being resolved by the current thread
+    if (!JType_IS_RESOLVED(self)) {
         JNIEnv* jenv;
         JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL);
         JType_ResolveType(jenv, self);
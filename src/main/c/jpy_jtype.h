@@ -27,6 +27,11 @@ extern "C" {
 
 #include "jpy_compat.h"
 
+/**
+ * Number of entries of the assignability memo of a JType, must be a power of two.
+ */
+#define JType_ASSIGNABLE_FROM_SIZE 16
+
 /**
  * The Python type 'JType' representing a Java type.
  */
@@ -48,13 +53,47 @@ typedef struct JPy_JType
     char isPrimitive;
     // If TRUE, 'classRef' refers to a Java interface type.
     char isInterface;
-    // If TRUE, the type is currently being resolved.
-    char isResolving;
     // If TRUE, all the class constructors and methods have already been resolved.
+    // Use JType_IS_RESOLVED and JType_SET_RESOLVED to access it outside of JPy_BEGIN_GLOBAL_LOCK blocks.
     char isResolved;
+    // If TRUE, 'classRef' refers to a type implementing java.lang.Comparable.
+    char isComparable;
+    // If TRUE, instances cache their Java hash code, see jpy.cache_hash().
+    // Use JType_IS_HASH_CACHED and JType_SET_HASH_CACHED to access it.
+    char isHashCached;
+    // The callable registered for this type in 'jpy.type_translations' (new reference), or NULL.
+    // Only valid if 'translationVersion' equals JPy_TypeTranslationsVersion, see JType_GetTranslation().
+    PyObject* translation;
+    long long translationVersion;
+    // Open-addressing memo of JType_IsAssignableFrom(). Each non-zero entry is the address of a source type,
+    // with the lowest bit set if it is assignable to this type. Entries are only added, never changed.
+    uintptr_t assignableFrom[JType_ASSIGNABLE_FROM_SIZE];
 }
 JPy_JType;
 
+/**
+ * In free-threaded builds, other threads may test 'isResolved' without holding the global lock.
+ * Setting it is a release operation and testing it an acquire operation, so that threads seeing
+ * a resolved type also see its completely initialised members. 'isHashCached' may be changed
+ * by jpy.cache_hash() at any time.
+ */
+#ifdef JPY_FREE_THREADED
+#define JType_GET_ASSIGNABLE_FROM(TYPE, I)                _Py_atomic_load_uintptr_relaxed(&(TYPE)->assignableFrom[I])
+#define JType_CAS_ASSIGNABLE_FROM(TYPE, I, EXPECTED, VALUE) _Py_atomic_compare_exchange_uintptr(&(TYPE)->assignableFrom[I], (EXPECTED), (VALUE))
+#define JType_IS_RESOLVED(TYPE)         _Py_atomic_load_uint8((uint8_t*) &(TYPE)->isResolved)
+#define JType_SET_RESOLVED(TYPE, VALUE) _Py_atomic_store_uint8((uint8_t*) &(TYPE)->isResolved, (uint8_t) (VALUE))
+#define JType_IS_HASH_CACHED(TYPE)         _Py_atomic_load_uint8_relaxed((uint8_t*) &(TYPE)->isHashCached)
+#define JType_SET_HASH_CACHED(TYPE, VALUE) _Py_atomic_store_uint8_relaxed((uint8_t*) &(TYPE)->isHashCached, (uint8_t) (VALUE))
+#else
+#define JType_GET_ASSIGNABLE_FROM(TYPE, I)                ((TYPE)->assignableFrom[I])
+#define JType_CAS_ASSIGNABLE_FROM(TYPE, I, EXPECTED, VALUE) \
+    ((TYPE)->assignableFrom[I] == *(EXPECTED) ? ((TYPE)->assignableFrom[I] = (VALUE), 1) : (*(EXPECTED) = (TYPE)->assignableFrom[I], 0))
+#define JType_IS_RESOLVED(TYPE)         ((TYPE)->isResolved)
+#define JType_SET_RESOLVED(TYPE, VALUE) ((TYPE)->isResolved = (VALUE))
+#define JType_IS_HASH_CACHED(TYPE)         ((TYPE)->isHashCached)
+#define JType_SET_HASH_CACHED(TYPE, VALUE) ((TYPE)->isHashCached = (VALUE))
+#endif
+
 /**
  * The 'JType' singleton.
  */
@@ -99,6 +138,19 @@ typedef struct JPy_ReturnDescriptor
 }
 JPy_ReturnDescriptor;
 
+/**
+ * Kinds of Python arguments as returned by JType_GetArgKind. Instances of subclasses of bool, int, float
+ * and str are of kind JPy_ARG_KIND_OTHER.
+ */
+#define JPy_ARG_KIND_NONE   0x01
+#define JPy_ARG_KIND_BOOL   0x02
+#define JPy_ARG_KIND_INT    0x04
+#define JPy_ARG_KIND_FLOAT  0x08
+#define JPy_ARG_KIND_STR    0x10
+#define JPy_ARG_KIND_JOBJ   0x20
+#define JPy_ARG_KIND_OTHER  0x40
+#define JPy_ARG_KIND_ANY    0x7f
+
 /**
  * Method parameter descriptor.
  */
@@ -108,6 +160,10 @@ typedef struct JPy_ParamDescriptor
     jboolean isMutable;
     jboolean isOutput;
     jboolean isReturn;
+    // Whether a Python buffer argument may be passed in a Java array from the calling thread's scratch pool
+    jboolean isPooled;
+    // Bit mask of the JPy_ARG_KIND_* values MatchPyArg may return a non-zero match value for.
+    unsigned char argKinds;
     JPy_MatchPyArg MatchPyArg;
     JPy_MatchVarArgPyArg MatchVarArgPyArg;
     JPy_ConvertPyArg ConvertPyArg;
@@ -115,6 +171,34 @@ typedef struct JPy_ParamDescriptor
 }
 JPy_ParamDescriptor;
 
+#define JPy_CALL_SCRATCH_BUFFER_COUNT 4
+
+/**
+ * Scratch context of a single Java method call, living on the stack of the calling function.
+ * Buffer views acquired while matching the arguments against the overloads are kept here, so that
+ * converting the arguments reuses them instead of acquiring the buffers again.
+ */
+typedef struct JPy_CallScratch
+{
+    struct JPy_CallScratch* previous;
+    int bufferCount;
+    // The arguments whose views are kept, borrowed references
+    PyObject* bufferArgs[JPy_CALL_SCRATCH_BUFFER_COUNT];
+    Py_buffer* buffers[JPy_CALL_SCRATCH_BUFFER_COUNT];
+}
+JPy_CallScratch;
+
+/**
+ * Makes scratch the current thread's call scratch context until JType_EndCallScratch() is called.
+ */
+void JType_BeginCallScratch(JPy_CallScratch* scratch);
+
+/**
+ * Releases the buffer views which have not been taken over by argument conversion and restores
+ * the previous call scratch context.
+ */
+void JType_EndCallScratch(JPy_CallScratch* scratch);
+
 
 int JType_Check(PyObject* obj);
 
@@ -122,6 +206,23 @@ JPy_JType* JType_GetTypeForObject(JNIEnv* jenv, jobject objectRef);
 JPy_JType* JType_GetTypeForName(JNIEnv* jenv, const char* typeName, jboolean resolve);
 JPy_JType* JType_GetType(JNIEnv* jenv, jclass classRef, jboolean resolve);
 
+/**
+ * Returns whether sourceType can be cast to type, like IsAssignableFrom(jenv, sourceType->classRef, type->classRef).
+ * The result is memoized on type, so that it is a memory load after the first call.
+ */
+jboolean JType_IsAssignableFrom(JNIEnv* jenv, JPy_JType* type, JPy_JType* sourceType);
+
+/**
+ * Returns the JPy_ARG_KIND_* value of the given Python argument.
+ */
+int JType_GetArgKind(PyObject* pyArg);
+
+/**
+ * Returns the callable registered for the given type in 'jpy.type_translations' (new reference),
+ * or NULL without an error set if there is none.
+ */
+PyObject* JType_GetTranslation(JPy_JType* type);
+
 PyObject* JType_ConvertJavaToPythonObject(JNIEnv* jenv, JPy_JType* type, jobject objectRef);
 int       JType_ConvertPythonToJavaObject(JNIEnv* jenv, JPy_JType* type, PyObject* arg, jobject* objectRef, jboolean allowObjectWrapping);
 
@@ -129,6 +230,12 @@ PyObject* JType_GetOverloadedMethod(JNIEnv* jenv, JPy_JType* type, PyObject* met
 
 int JType_MatchPyArgAsJObject(JNIEnv* jenv, JPy_JType* type, PyObject* pyArg);
 
+/**
+ * Deletes the global references to the boxed Boolean, Integer and Long values cached by JType_ConvertPythonToJavaObject().
+ * 'jenv' may be NULL if the JVM is already gone.
+ */
+void JType_ClearBoxCaches(JNIEnv* jenv);
+
 int JType_CreateJavaArray(JNIEnv* jenv, JPy_JType* componentType, PyObject* pyArg, jobject* objectRef, jboolean allowObjectWrapping);
 
 // Non-API. Defined in jpy_jobj.c
@@ -24,7 +24,10 @@
 #include "jpy_jmethod.h"
 #include "jpy_jfield.h"
 #include "jpy_jobj.h"
+#include "jpy_jarray.h"
 #include "jpy_conv.h"
+#include "jpy_trace.h"
+#include "jpy_columns.h"
 #include "jpy_compat.h"
 
 
@@ -38,6 +41,11 @@ PyObject* JPy_destroy_jvm(PyObject* self, PyObject* args);
 PyObject* JPy_get_type(PyObject* self, PyObject* args, PyObject* kwds);
 PyObject* JPy_cast(PyObject* self, PyObject* args);
 PyObject* JPy_array(PyObject* self, PyObject* args);
+PyObject* JPy_cache_hash(PyObject* self, PyObject* args, PyObject* kwds);
+PyObject* JPy_to_numpy(PyObject* self, PyObject* args, PyObject* kwds);
+PyObject* JPy_from_numpy(PyObject* self, PyObject* args, PyObject* kwds);
+PyObject* JPy_convert(PyObject* self, PyObject* args, PyObject* kwds);
+PyObject* JPy_columns(PyObject* self, PyObject* args, PyObject* kwds);
 
 
 static PyMethodDef JPy_Functions[] = {
@@ -63,6 +71,32 @@ static PyMethodDef JPy_Functions[] = {
                     "array(name, init) - Return a new Java array of given Java type (type name or type object) and initializer (array length or sequence). "
                     "Possible primitive types are 'boolean', 'byte', 'char', 'short', 'int', 'long', 'float', and 'double'."},
 
+    {"cache_hash",  (PyCFunction) JPy_cache_hash, METH_VARARGS|METH_KEYWORDS,
+                    "cache_hash(type, enabled=True) - Let instances of the given Java type (type name or type object) cache their hash code. "
+                    "Only use it for types whose hash codes never change. Enabled by default for String, the boxed primitive types, "
+                    "BigInteger, BigDecimal, and enum types."},
+
+    {"to_numpy",    (PyCFunction) JPy_to_numpy, METH_VARARGS|METH_KEYWORDS,
+                    "to_numpy(jarray, copy=True) - Return a NumPy array holding the items of the given Java primitive array, copied at once. "
+                    "If copy is False, the NumPy array is a view of the Java array's buffer."},
+
+    {"from_numpy",  (PyCFunction) JPy_from_numpy, METH_VARARGS|METH_KEYWORDS,
+                    "from_numpy(ndarray, type=None) - Return a new Java primitive array holding the items of the given NumPy array "
+                    "or other buffer, copied at once. The Java element type (type name or type object) defaults to the one matching "
+                    "the array's dtype. Arrays of other dtypes are converted item by item."},
+
+    {"convert",     (PyCFunction) JPy_convert, METH_VARARGS|METH_KEYWORDS,
+                    "convert(obj, depth=-1) - Convert the given Java object into native Python objects in a single pass: "
+                    "Maps into dicts, Sets into sets, other Collections and arrays into lists, Strings and boxed values into "
+                    "str, bool, int, and float. Containers nested deeper than depth are returned as Java objects, a negative "
+                    "depth means unlimited depth. Other objects are returned as they are."},
+
+    {"columns",     (PyCFunction) JPy_columns, METH_VARARGS|METH_KEYWORDS,
+                    "columns(collection, names, type=None) - Extract the named properties of all elements of the given Java "
+                    "Collection or object array into a dict mapping each name to a column. Each name is resolved once to a public "
+                    "field or getter of the element type (type name or type object), which defaults to the class of the first "
+                    "element. Columns of primitive properties are memoryviews of contiguous buffers, all others are lists."},
+
     {NULL, NULL, 0, NULL} /*Sentinel*/
 };
 
@@ -91,6 +125,17 @@ PyObject* JPy_Types = NULL;
 PyObject* JPy_Type_Callbacks = NULL;
 PyObject* JPy_Type_Translations = NULL;
 PyObject* JException_Type = NULL;
+long long JPy_TypeTranslationsVersion = 0;
+
+#if PY_VERSION_HEX >= 0x030C0000
+static int JPy_TypeTranslationsWatcherId = -1;
+
+static int JPy_OnTypeTranslationsChanged(PyDict_WatchEvent event, PyObject* dict, PyObject* key, PyObject* newValue)
+{
+    JPy_ATOMIC_ADD(&JPy_TypeTranslationsVersion, 1);
+    return 0;
+}
+#endif
 
 // A global reference to a Java VM singleton.
 JavaVM* JPy_JVM = NULL;
@@ -131,6 +176,8 @@ JPy_JType* JPy_JStackTraceElement = NULL;
 // java.lang.Comparable
 jclass JPy_Comparable_JClass = NULL;
 jmethodID JPy_Comparable_CompareTo_MID = NULL;
+// java.lang.Enum
+jclass JPy_Enum_JClass = NULL;
 
 // java.lang.Object
 jclass JPy_Object_JClass = NULL;
@@ -176,6 +223,22 @@ jmethodID JPy_Map_put_MID = NULL;
 jmethodID JPy_Map_clear_MID = NULL;
 jmethodID JPy_Map_Entry_getKey_MID = NULL;
 jmethodID JPy_Map_Entry_getValue_MID = NULL;
+// java.util.Collection
+jclass JPy_Collection_JClass = NULL;
+jmethodID JPy_Collection_ToArray_MID = NULL;
+jmethodID JPy_Collection_Add_MID = NULL;
+jmethodID JPy_Collection_Size_MID = NULL;
+// java.util.List, java.util.RandomAccess
+jclass JPy_List_JClass = NULL;
+jmethodID JPy_List_SubList_MID = NULL;
+jclass JPy_RandomAccess_JClass = NULL;
+// java.util.HashMap, java.util.ArrayList, java.util.HashSet
+jclass JPy_HashMap_JClass = NULL;
+jmethodID JPy_HashMap_Init_MID = NULL;
+jclass JPy_ArrayList_JClass = NULL;
+jmethodID JPy_ArrayList_Init_MID = NULL;
+jclass JPy_HashSet_JClass = NULL;
+jmethodID JPy_HashSet_Init_MID = NULL;
 // java.util.Set
 jclass JPy_Set_JClass = NULL;
 jmethodID JPy_Set_Iterator_MID = NULL;
@@ -193,30 +256,38 @@ jclass JPy_StopIteration_JClass = NULL;
 
 // java.lang.Boolean
 jclass JPy_Boolean_JClass = NULL;
-jmethodID JPy_Boolean_Init_MID = NULL;
+jmethodID JPy_Boolean_ValueOf_MID = NULL;
+jfieldID JPy_Boolean_Value_FID = NULL;
 jmethodID JPy_Boolean_BooleanValue_MID = NULL;
 
 jclass JPy_Character_JClass = NULL;
-jmethodID JPy_Character_Init_MID;
+jmethodID JPy_Character_ValueOf_MID = NULL;
+jfieldID JPy_Character_Value_FID = NULL;
 jmethodID JPy_Character_CharValue_MID = NULL;
 
 jclass JPy_Byte_JClass = NULL;
-jmethodID JPy_Byte_Init_MID = NULL;
+jmethodID JPy_Byte_ValueOf_MID = NULL;
+jfieldID JPy_Byte_Value_FID = NULL;
 
 jclass JPy_Short_JClass = NULL;
-jmethodID JPy_Short_Init_MID = NULL;
+jmethodID JPy_Short_ValueOf_MID = NULL;
+jfieldID JPy_Short_Value_FID = NULL;
 
 jclass JPy_Integer_JClass = NULL;
-jmethodID JPy_Integer_Init_MID = NULL;
+jmethodID JPy_Integer_ValueOf_MID = NULL;
+jfieldID JPy_Integer_Value_FID = NULL;
 
 jclass JPy_Long_JClass = NULL;
-jmethodID JPy_Long_Init_MID = NULL;
+jmethodID JPy_Long_ValueOf_MID = NULL;
+jfieldID JPy_Long_Value_FID = NULL;
 
 jclass JPy_Float_JClass = NULL;
-jmethodID JPy_Float_Init_MID = NULL;
+jmethodID JPy_Float_ValueOf_MID = NULL;
+jfieldID JPy_Float_Value_FID = NULL;
 
 jclass JPy_Double_JClass = NULL;
-jmethodID JPy_Double_Init_MID = NULL;
+jmethodID JPy_Double_ValueOf_MID = NULL;
+jfieldID JPy_Double_Value_FID = NULL;
 
 // java.lang.Number
 jclass JPy_Number_JClass = NULL;
@@ -224,12 +295,17 @@ jmethodID JPy_Number_IntValue_MID = NULL;
 jmethodID JPy_Number_LongValue_MID = NULL;
 jmethodID JPy_Number_DoubleValue_MID = NULL;
 
+// java.math.BigDecimal
+jclass JPy_BigDecimal_JClass = NULL;
+jmethodID JPy_BigDecimal_ToBigInteger_MID = NULL;
+
 jclass JPy_Void_JClass = NULL;
 jclass JPy_String_JClass = NULL;
 jclass JPy_PyObject_JClass = NULL;
 jclass JPy_PyDictWrapper_JClass = NULL;
 
 jmethodID JPy_PyObject_GetPointer_MID = NULL;
+jfieldID JPy_PyObject_Pointer_FID = NULL;
 jmethodID JPy_PyObject_Init_MID = NULL;
 jmethodID JPy_PyModule_Init_MID = NULL;
 
@@ -303,6 +379,12 @@ PyMODINIT_FUNC JPY_MODULE_INIT_FUNC(void)
     if (JPy_Module == NULL) {
         JPY_RETURN(NULL);
     }
+#if defined(JPY_FREE_THREADED)
+    // Tell free-threaded interpreters not to re-enable the GIL when importing jpy
+    if (PyUnstable_Module_SetGIL(JPy_Module, Py_MOD_GIL_NOT_USED) < 0) {
+        JPY_RETURN(NULL);
+    }
+#endif
 #elif defined(JPY_COMPAT_27)
     JPy_Module = Py_InitModule3(JPY_MODULE_NAME, JPy_Functions, JPY_MODULE_DOC);
     if (JPy_Module == NULL) {
@@ -368,6 +450,18 @@ PyMODINIT_FUNC JPY_MODULE_INIT_FUNC(void)
     Py_INCREF(JPy_Type_Translations);
     PyModule_AddObject(JPy_Module, JPy_MODULE_ATTR_NAME_TYPE_TRANSLATIONS, JPy_Type_Translations);
 
+#if PY_VERSION_HEX >= 0x030C0000
+    // Types cache their translation callable until the dictionary is modified
+    JPy_TypeTranslationsWatcherId = PyDict_AddWatcher(JPy_OnTypeTranslationsChanged);
+    if (JPy_TypeTranslationsWatcherId >= 0 && PyDict_Watch(JPy_TypeTranslationsWatcherId, JPy_Type_Translations) == 0) {
+        JPy_ATOMIC_ADD(&JPy_TypeTranslationsVersion, 1);
+    } else {
+        // The number of dictionary watchers is limited, translations will be looked up every time
+        PyErr_Clear();
+        JPy_TypeTranslationsVersion = 0;
+    }
+#endif
+
     /////////////////////////////////////////////////////////////////////////
 
     if (PyType_Ready(&Diag_Type) < 0) {
@@ -568,7 +662,7 @@ PyObject* JPy_cast(PyObject* self, PyObject* args)
         return NULL;
     }
 
-    inst = (*jenv)->IsInstanceOf(jenv, ((JPy_JObj*) obj)->objectRef, type->classRef);
+    inst = JType_IsAssignableFrom(jenv, type, (JPy_JType*) Py_TYPE(obj)) || (*jenv)->IsInstanceOf(jenv, ((JPy_JObj*) obj)->objectRef, type->classRef);
     if (inst) {
         return (PyObject*) JObj_FromType(jenv, (JPy_JType*) objType, ((JPy_JObj*) obj)->objectRef);
     } else {
@@ -576,6 +670,193 @@ PyObject* JPy_cast(PyObject* self, PyObject* args)
     }
 }
 
+PyObject* JPy_cache_hash(PyObject* self, PyObject* args, PyObject* kwds)
+{
+    JNIEnv* jenv;
+    static char* keywords[] = {"type", "enabled", NULL};
+    PyObject* objType;
+    JPy_JType* type;
+    int enabled;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    enabled = 1; // True
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|i:cache_hash", keywords, &objType, &enabled)) {
+        return NULL;
+    }
+
+    if (JPy_IS_STR(objType)) {
+        const char* typeName = JPy_AS_UTF8(objType);
+        type = JType_GetTypeForName(jenv, typeName, JNI_FALSE);
+        if (type == NULL) {
+            return NULL;
+        }
+    } else if (JType_Check(objType)) {
+        type = (JPy_JType*) objType;
+        Py_INCREF(type);
+    } else {
+        PyErr_SetString(PyExc_ValueError, "cache_hash: argument 1 (type) must be a Java type name or Java type object");
+        return NULL;
+    }
+
+    // Objects which have already cached their hash code keep it
+    JType_SET_HASH_CACHED(type, enabled != 0);
+    Py_DECREF(type);
+
+    return Py_BuildValue("");
+}
+
+PyObject* JPy_to_numpy(PyObject* self, PyObject* args, PyObject* kwds)
+{
+    JNIEnv* jenv;
+    static char* keywords[] = {"jarray", "copy", NULL};
+    PyObject* obj;
+    int copy;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    copy = 1; // True
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|i:to_numpy", keywords, &obj, &copy)) {
+        return NULL;
+    }
+
+    if (!JObj_Check(obj)) {
+        PyErr_SetString(PyExc_ValueError, "to_numpy: argument 1 (jarray) must be a Java primitive array");
+        return NULL;
+    }
+
+    return JArray_ToNumPy(jenv, (JPy_JArray*) obj, copy);
+}
+
+PyObject* JPy_from_numpy(PyObject* self, PyObject* args, PyObject* kwds)
+{
+    JNIEnv* jenv;
+    static char* keywords[] = {"ndarray", "type", NULL};
+    PyObject* objInit;
+    PyObject* objType;
+    JPy_JType* componentType;
+    jarray arrayRef;
+    PyObject* result;
+    int status;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    objType = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O:from_numpy", keywords, &objInit, &objType)) {
+        return NULL;
+    }
+
+    if (objType == Py_None) {
+        componentType = NULL;
+    } else if (JPy_IS_STR(objType)) {
+        componentType = JType_GetTypeForName(jenv, JPy_AS_UTF8(objType), JNI_FALSE);
+        if (componentType == NULL) {
+            return NULL;
+        }
+    } else if (JType_Check(objType)) {
+        componentType = (JPy_JType*) objType;
+        Py_INCREF(componentType);
+    } else {
+        PyErr_SetString(PyExc_ValueError, "from_numpy: argument 2 (type) must be a type name or Java type object");
+        return NULL;
+    }
+
+    if (componentType != NULL && (!componentType->isPrimitive || componentType == JPy_JVoid)) {
+        PyErr_Format(PyExc_ValueError, "from_numpy: argument 2 (type) must be a primitive type, got '%s'", componentType->javaName);
+        Py_DECREF(componentType);
+        return NULL;
+    }
+
+    if (componentType == NULL) {
+        status = JArray_FromBuffer(jenv, NULL, objInit, &arrayRef);
+        if (status == 0) {
+            PyErr_Format(PyExc_ValueError, "from_numpy: cannot derive a Java primitive type from a '%s', argument 2 (type) must be given", Py_TYPE(objInit)->tp_name);
+            status = -1;
+        }
+    } else {
+        // Tries JArray_FromBuffer() first, then converts item by item, e.g. for float64 to int
+        status = JType_CreateJavaArray(jenv, componentType, objInit, &arrayRef, JNI_FALSE);
+    }
+    Py_XDECREF(componentType);
+    if (status < 0) {
+        return NULL;
+    }
+
+    result = JObj_New(jenv, arrayRef);
+    (*jenv)->DeleteLocalRef(jenv, arrayRef);
+    return result;
+}
+
+PyObject* JPy_convert(PyObject* self, PyObject* args, PyObject* kwds)
+{
+    JNIEnv* jenv;
+    static char* keywords[] = {"obj", "depth", NULL};
+    PyObject* obj;
+    int depth;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    depth = -1; // Unlimited
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|i:convert", keywords, &obj, &depth)) {
+        return NULL;
+    }
+
+    if (!JObj_Check(obj)) {
+        Py_INCREF(obj);
+        return obj;
+    }
+
+    return JPy_FromJObjectDeep(jenv, ((JPy_JObj*) obj)->objectRef, depth);
+}
+
+PyObject* JPy_columns(PyObject* self, PyObject* args, PyObject* kwds)
+{
+    JNIEnv* jenv;
+    static char* keywords[] = {"collection", "names", "type", NULL};
+    PyObject* objCollection;
+    PyObject* objNames;
+    PyObject* objType;
+    JPy_JType* type;
+    PyObject* result;
+
+    JPy_GET_JNI_ENV_OR_RETURN(jenv, NULL)
+
+    objType = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O:columns", keywords, &objCollection, &objNames, &objType)) {
+        return NULL;
+    }
+
+    if (!JObj_Check(objCollection)) {
+        PyErr_SetString(PyExc_ValueError, "columns: argument 1 (collection) must be a Java Collection or object array");
+        return NULL;
+    }
+
+    if (objType == Py_None) {
+        type = NULL;
+    } else if (JPy_IS_STR(objType)) {
+        type = JType_GetTypeForName(jenv, JPy_AS_UTF8(objType), JNI_FALSE);
+        if (type == NULL) {
+            return NULL;
+        }
+    } else if (JType_Check(objType)) {
+        type = (JPy_JType*) objType;
+        Py_INCREF(type);
+    } else {
+        PyErr_SetString(PyExc_ValueError, "columns: argument 3 (type) must be a type name or Java type object");
+        return NULL;
+    }
+
+    if (type != NULL && (type->isPrimitive || type->componentType != NULL)) {
+        PyErr_Format(PyExc_ValueError, "columns: argument 3 (type) must be a class or interface type, got '%s'", type->javaName);
+        Py_DECREF(type);
+        return NULL;
+    }
+
+    result = JPy_GetColumns(jenv, ((JPy_JObj*) objCollection)->objectRef, objNames, type);
+    Py_XDECREF(type);
+    return result;
+}
+
 PyObject* JPy_array(PyObject* self, PyObject* args)
 {
     JNIEnv* jenv;
@@ -677,7 +958,7 @@ JPy_JType* JPy_GetNonObjectJType(JNIEnv* jenv, jclass classRef)
         return NULL;
     }
 
-    type->isResolved = JNI_TRUE; // Primitive types are always resolved.
+    JType_SET_RESOLVED(type, JNI_TRUE); // Primitive types are always resolved.
     Py_INCREF((PyObject*) type);
 
     return type;
@@ -715,6 +996,32 @@ jmethodID JPy_GetMethod(JNIEnv* jenv, jclass classRef, const char* name, const c
     return methodID;
 }
 
+jmethodID JPy_GetStaticMethod(JNIEnv* jenv, jclass classRef, const char* name, const char* sig)
+{
+    jmethodID methodID;
+    methodID = (*jenv)->GetStaticMethodID(jenv, classRef, name, sig);
+    if (methodID == NULL) {
+        PyErr_Format(PyExc_RuntimeError, "jpy: internal error: static method not found: %s%s", name, sig);
+        return NULL;
+    }
+    return methodID;
+}
+
+
+/**
+ * Gets a (possibly private) instance field which is read directly instead of calling its getter.
+ * Returns NULL without an error set if there is no such field, callers then fall back to the getter.
+ */
+static jfieldID JPy_GetOptionalField(JNIEnv* jenv, jclass classRef, const char* name, const char* sig)
+{
+    jfieldID fieldID;
+    fieldID = (*jenv)->GetFieldID(jenv, classRef, name, sig);
+    if (fieldID == NULL) {
+        (*jenv)->ExceptionClear(jenv);
+        JPy_DIAG_PRINT(JPy_DIAG_F_TYPE, "JPy_GetOptionalField: field not found: %s %s, using getter instead\n", name, sig);
+    }
+    return fieldID;
+}
 
 
 #define DEFINE_CLASS(C, N) \
@@ -731,6 +1038,13 @@ jmethodID JPy_GetMethod(JNIEnv* jenv, jclass classRef, const char* name, const c
     }
 
 
+#define DEFINE_STATIC_METHOD(M, C, N, S) \
+    M = JPy_GetStaticMethod(jenv, C, N, S); \
+    if (M == NULL) { \
+        return -1; \
+    }
+
+
 #define DEFINE_NON_OBJECT_TYPE(T, C) \
     T = JPy_GetNonObjectJType(jenv, C); \
     if (T == NULL) { \
@@ -759,6 +1073,8 @@ int initGlobalPyObjectVars(JNIEnv* jenv)
     } else {
         JPy_PyObject_JClass = JPy_JPyObject->classRef;
         DEFINE_METHOD(JPy_PyObject_GetPointer_MID, JPy_PyObject_JClass, "getPointer", "()J");
+        // getPointer() is final and just returns this field
+        JPy_PyObject_Pointer_FID = JPy_GetOptionalField(jenv, JPy_PyObject_JClass, "pointer", "J");
         DEFINE_METHOD(JPy_PyObject_Init_MID, JPy_PyObject_JClass, "<init>", "(J)V");
     }
 
@@ -807,6 +1123,8 @@ int JPy_InitGlobalVars(JNIEnv* jenv)
     DEFINE_CLASS(JPy_Comparable_JClass, "java/lang/Comparable");
     DEFINE_METHOD(JPy_Comparable_CompareTo_MID, JPy_Comparable_JClass, "compareTo", "(Ljava/lang/Object;)I");
 
+    DEFINE_CLASS(JPy_Enum_JClass, "java/lang/Enum");
+
     DEFINE_CLASS(JPy_Object_JClass, "java/lang/Object");
     DEFINE_METHOD(JPy_Object_ToString_MID, JPy_Object_JClass, "toString", "()Ljava/lang/String;");
     DEFINE_METHOD(JPy_Object_HashCode_MID, JPy_Object_JClass, "hashCode", "()I");
@@ -847,6 +1165,22 @@ int JPy_InitGlobalVars(JNIEnv* jenv)
     DEFINE_METHOD(JPy_Map_Entry_getKey_MID, JPy_Map_Entry_JClass, "getKey", "()Ljava/lang/Object;");
     DEFINE_METHOD(JPy_Map_Entry_getValue_MID, JPy_Map_Entry_JClass, "getValue", "()Ljava/lang/Object;");
 
+    // java.util.Collection
+    DEFINE_CLASS(JPy_Collection_JClass, "java/util/Collection");
+    DEFINE_METHOD(JPy_Collection_ToArray_MID, JPy_Collection_JClass, "toArray", "()[Ljava/lang/Object;");
+    DEFINE_METHOD(JPy_Collection_Add_MID, JPy_Collection_JClass, "add", "(Ljava/lang/Object;)Z");
+    DEFINE_METHOD(JPy_Collection_Size_MID, JPy_Collection_JClass, "size", "()I");
+
+    DEFINE_CLASS(JPy_List_JClass, "java/util/List");
+    DEFINE_METHOD(JPy_List_SubList_MID, JPy_List_JClass, "subList", "(II)Ljava/util/List;");
+    DEFINE_CLASS(JPy_RandomAccess_JClass, "java/util/RandomAccess");
+
+    DEFINE_CLASS(JPy_HashMap_JClass, "java/util/HashMap");
+    DEFINE_METHOD(JPy_HashMap_Init_MID, JPy_HashMap_JClass, "<init>", "(I)V");
+    DEFINE_CLASS(JPy_ArrayList_JClass, "java/util/ArrayList");
+    DEFINE_METHOD(JPy_ArrayList_Init_MID, JPy_ArrayList_JClass, "<init>", "(I)V");
+    DEFINE_CLASS(JPy_HashSet_JClass, "java/util/HashSet");
+    DEFINE_METHOD(JPy_HashSet_Init_MID, JPy_HashSet_JClass, "<init>", "(I)V");
 
     // java.util.Set
     DEFINE_CLASS(JPy_Set_JClass, "java/util/Set");
@@ -862,36 +1196,47 @@ int JPy_InitGlobalVars(JNIEnv* jenv)
     DEFINE_CLASS(JPy_UnsupportedOperationException_JClass, "java/lang/UnsupportedOperationException");
 
     DEFINE_CLASS(JPy_Boolean_JClass, "java/lang/Boolean");
-    DEFINE_METHOD(JPy_Boolean_Init_MID, JPy_Boolean_JClass, "<init>", "(Z)V");
+    DEFINE_STATIC_METHOD(JPy_Boolean_ValueOf_MID, JPy_Boolean_JClass, "valueOf", "(Z)Ljava/lang/Boolean;");
+    JPy_Boolean_Value_FID = JPy_GetOptionalField(jenv, JPy_Boolean_JClass, "value", "Z");
     DEFINE_METHOD(JPy_Boolean_BooleanValue_MID, JPy_Boolean_JClass, "booleanValue", "()Z");
 
     DEFINE_CLASS(JPy_Character_JClass, "java/lang/Character");
-    DEFINE_METHOD(JPy_Character_Init_MID, JPy_Character_JClass, "<init>", "(C)V");
+    DEFINE_STATIC_METHOD(JPy_Character_ValueOf_MID, JPy_Character_JClass, "valueOf", "(C)Ljava/lang/Character;");
+    JPy_Character_Value_FID = JPy_GetOptionalField(jenv, JPy_Character_JClass, "value", "C");
     DEFINE_METHOD(JPy_Character_CharValue_MID, JPy_Character_JClass, "charValue", "()C");
 
     DEFINE_CLASS(JPy_Byte_JClass, "java/lang/Byte");
-    DEFINE_METHOD(JPy_Byte_Init_MID, JPy_Byte_JClass, "<init>", "(B)V");
+    DEFINE_STATIC_METHOD(JPy_Byte_ValueOf_MID, JPy_Byte_JClass, "valueOf", "(B)Ljava/lang/Byte;");
+    JPy_Byte_Value_FID = JPy_GetOptionalField(jenv, JPy_Byte_JClass, "value", "B");
 
     DEFINE_CLASS(JPy_Short_JClass, "java/lang/Short");
-    DEFINE_METHOD(JPy_Short_Init_MID, JPy_Short_JClass, "<init>", "(S)V");
+    DEFINE_STATIC_METHOD(JPy_Short_ValueOf_MID, JPy_Short_JClass, "valueOf", "(S)Ljava/lang/Short;");
+    JPy_Short_Value_FID = JPy_GetOptionalField(jenv, JPy_Short_JClass, "value", "S");
 
     DEFINE_CLASS(JPy_Integer_JClass, "java/lang/Integer");
-    DEFINE_METHOD(JPy_Integer_Init_MID, JPy_Integer_JClass, "<init>", "(I)V");
+    DEFINE_STATIC_METHOD(JPy_Integer_ValueOf_MID, JPy_Integer_JClass, "valueOf", "(I)Ljava/lang/Integer;");
+    JPy_Integer_Value_FID = JPy_GetOptionalField(jenv, JPy_Integer_JClass, "value", "I");
 
     DEFINE_CLASS(JPy_Long_JClass, "java/lang/Long");
-    DEFINE_METHOD(JPy_Long_Init_MID, JPy_Long_JClass, "<init>", "(J)V");
+    DEFINE_STATIC_METHOD(JPy_Long_ValueOf_MID, JPy_Long_JClass, "valueOf", "(J)Ljava/lang/Long;");
+    JPy_Long_Value_FID = JPy_GetOptionalField(jenv, JPy_Long_JClass, "value", "J");
 
     DEFINE_CLASS(JPy_Float_JClass, "java/lang/Float");
-    DEFINE_METHOD(JPy_Float_Init_MID, JPy_Float_JClass, "<init>", "(F)V");
+    DEFINE_STATIC_METHOD(JPy_Float_ValueOf_MID, JPy_Float_JClass, "valueOf", "(F)Ljava/lang/Float;");
+    JPy_Float_Value_FID = JPy_GetOptionalField(jenv, JPy_Float_JClass, "value", "F");
 
     DEFINE_CLASS(JPy_Double_JClass, "java/lang/Double");
-    DEFINE_METHOD(JPy_Double_Init_MID, JPy_Double_JClass, "<init>", "(D)V");
+    DEFINE_STATIC_METHOD(JPy_Double_ValueOf_MID, JPy_Double_JClass, "valueOf", "(D)Ljava/lang/Double;");
+    JPy_Double_Value_FID = JPy_GetOptionalField(jenv, JPy_Double_JClass, "value", "D");
 
     DEFINE_CLASS(JPy_Number_JClass, "java/lang/Number");
     DEFINE_METHOD(JPy_Number_IntValue_MID, JPy_Number_JClass, "intValue", "()I");
     DEFINE_METHOD(JPy_Number_LongValue_MID , JPy_Number_JClass, "longValue", "()J");
     DEFINE_METHOD(JPy_Number_DoubleValue_MID, JPy_Number_JClass, "doubleValue", "()D");
 
+    DEFINE_CLASS(JPy_BigDecimal_JClass, "java/math/BigDecimal");
+    DEFINE_METHOD(JPy_BigDecimal_ToBigInteger_MID, JPy_BigDecimal_JClass, "toBigInteger", "()Ljava/math/BigInteger;");
+
     DEFINE_CLASS(JPy_Void_JClass, "java/lang/Void");
 
     DEFINE_CLASS(JPy_String_JClass, "java/lang/String");
@@ -942,8 +1287,12 @@ int JPy_InitGlobalVars(JNIEnv* jenv)
 
 void JPy_ClearGlobalVars(JNIEnv* jenv)
 {
+    JType_ClearBoxCaches(jenv);
+    JArray_ClearScratchPools(jenv);
+
     if (jenv != NULL) {
         (*jenv)->DeleteGlobalRef(jenv, JPy_Comparable_JClass);
+        (*jenv)->DeleteGlobalRef(jenv, JPy_Enum_JClass);
         (*jenv)->DeleteGlobalRef(jenv, JPy_Object_JClass);
         (*jenv)->DeleteGlobalRef(jenv, JPy_Class_JClass);
         (*jenv)->DeleteGlobalRef(jenv, JPy_Constructor_JClass);
@@ -959,11 +1308,13 @@ void JPy_ClearGlobalVars(JNIEnv* jenv)
         (*jenv)->DeleteGlobalRef(jenv, JPy_Float_JClass);
         (*jenv)->DeleteGlobalRef(jenv, JPy_Double_JClass);
         (*jenv)->DeleteGlobalRef(jenv, JPy_Number_JClass);
+        (*jenv)->DeleteGlobalRef(jenv, JPy_BigDecimal_JClass);
         (*jenv)->DeleteGlobalRef(jenv, JPy_Void_JClass);
         (*jenv)->DeleteGlobalRef(jenv, JPy_String_JClass);
     }
 
     JPy_Comparable_JClass = NULL;
+    JPy_Enum_JClass = NULL;
     JPy_Object_JClass = NULL;
     JPy_Class_JClass = NULL;
     JPy_Constructor_JClass = NULL;
@@ -979,6 +1330,7 @@ void JPy_ClearGlobalVars(JNIEnv* jenv)
     JPy_Float_JClass = NULL;
     JPy_Double_JClass = NULL;
     JPy_Number_JClass = NULL;
+    JPy_BigDecimal_JClass = NULL;
     JPy_Void_JClass = NULL;
     JPy_String_JClass = NULL;
 
@@ -1003,20 +1355,30 @@ void JPy_ClearGlobalVars(JNIEnv* jenv)
     JPy_Field_GetName_MID = NULL;
     JPy_Field_GetModifiers_MID = NULL;
     JPy_Field_GetType_MID = NULL;
-    JPy_Boolean_Init_MID = NULL;
+    JPy_Boolean_ValueOf_MID = NULL;
+    JPy_Boolean_Value_FID = NULL;
     JPy_Boolean_BooleanValue_MID = NULL;
-    JPy_Character_Init_MID = NULL;
+    JPy_Character_ValueOf_MID = NULL;
+    JPy_Character_Value_FID = NULL;
     JPy_Character_CharValue_MID = NULL;
-    JPy_Byte_Init_MID = NULL;
-    JPy_Short_Init_MID = NULL;
-    JPy_Integer_Init_MID = NULL;
-    JPy_Long_Init_MID = NULL;
-    JPy_Float_Init_MID = NULL;
-    JPy_Double_Init_MID = NULL;
+    JPy_Byte_ValueOf_MID = NULL;
+    JPy_Byte_Value_FID = NULL;
+    JPy_Short_ValueOf_MID = NULL;
+    JPy_Short_Value_FID = NULL;
+    JPy_Integer_ValueOf_MID = NULL;
+    JPy_Integer_Value_FID = NULL;
+    JPy_Long_ValueOf_MID = NULL;
+    JPy_Long_Value_FID = NULL;
+    JPy_Float_ValueOf_MID = NULL;
+    JPy_Float_Value_FID = NULL;
+    JPy_Double_ValueOf_MID = NULL;
+    JPy_Double_Value_FID = NULL;
     JPy_Number_IntValue_MID = NULL;
     JPy_Number_LongValue_MID = NULL;
     JPy_Number_DoubleValue_MID = NULL;
+    JPy_BigDecimal_ToBigInteger_MID = NULL;
     JPy_PyObject_GetPointer_MID = NULL;
+    JPy_PyObject_Pointer_FID = NULL;
 
     Py_XDECREF(JPy_JBoolean);
     Py_XDECREF(JPy_JChar);
@@ -1073,6 +1435,9 @@ void JPy_HandleJavaException(JNIEnv* jenv)
         jstring message;
         int allocError = 0;
 
+        JPy_STAT_INC(JPy_STAT_JAVA_EXCEPTIONS);
+        JPy_TRACE_EVENT(JPy_TRACE_JAVA_EXCEPTION, NULL, 0);
+
         if (JPy_DiagFlags != 0) {
             (*jenv)->ExceptionDescribe(jenv);
         }
@@ -1250,11 +1615,44 @@ void JPy_HandleJavaException(JNIEnv* jenv)
     }
 }
 
+int JPy_PushLocalFrame(JNIEnv* jenv)
+{
+    if ((*jenv)->PushLocalFrame(jenv, JPy_LOCAL_FRAME_CAPACITY) < 0) {
+        JPy_DIAG_PRINT(JPy_DIAG_F_MEM + JPy_DIAG_F_ERR, "JPy_PushLocalFrame: error: failed to push local reference frame of capacity %d\n", JPy_LOCAL_FRAME_CAPACITY);
+        return -1;
+    }
+    return 0;
+}
+
+int JPy_RenewLocalFrame(JNIEnv* jenv, jint index)
+{
+    if (index == 0 || index % JPy_LOCAL_FRAME_CHUNK_SIZE != 0) {
+        return 0;
+    }
+    (*jenv)->PopLocalFrame(jenv, NULL);
+    return JPy_PushLocalFrame(jenv);
+}
+
+PyObject* JPy_GetPyObjectPointer(JNIEnv* jenv, jobject pyObjectRef)
+{
+    if (JPy_PyObject_Pointer_FID != NULL) {
+        return (PyObject*) (*jenv)->GetLongField(jenv, pyObjectRef, JPy_PyObject_Pointer_FID);
+    }
+    return (PyObject*) (*jenv)->CallLongMethod(jenv, pyObjectRef, JPy_PyObject_GetPointer_MID);
+}
+
 void JPy_free(void* unused)
 {
     JPy_DIAG_PRINT(JPy_DIAG_F_ALL, "JPy_free: freeing module data...\n");
     JPy_ClearGlobalVars(NULL);
 
+#if PY_VERSION_HEX >= 0x030C0000
+    if (JPy_TypeTranslationsWatcherId >= 0) {
+        PyDict_ClearWatcher(JPy_TypeTranslationsWatcherId);
+        JPy_TypeTranslationsWatcherId = -1;
+    }
+#endif
+
     JPy_Module = NULL;
     JPy_Types = NULL;
     JPy_Type_Callbacks = NULL;
@@ -38,6 +38,13 @@ extern PyObject* JPy_Type_Callbacks;
 extern PyObject* JPy_Type_Translations;
 extern PyObject* JException_Type;
 
+/**
+ * Incremented whenever the 'jpy.type_translations' dictionary is modified, so that types can cache their
+ * translation callable. Remains 0 if the dictionary cannot be watched (Python < 3.12), then JType_GetTranslation()
+ * looks up the dictionary every time.
+ */
+extern long long JPy_TypeTranslationsVersion;
+
 extern JavaVM* JPy_JVM;
 extern jboolean JPy_MustDestroyJVM;
 
@@ -94,6 +101,40 @@ void JPy_HandleJavaException(JNIEnv* jenv);
     }
 
 
+/**
+ * Number of loop iterations after which bulk conversions (arrays, maps, reflected class members)
+ * release all JNI local references created so far by popping and re-pushing their local reference frame.
+ */
+#define JPy_LOCAL_FRAME_CHUNK_SIZE 256
+
+/**
+ * Capacity of a local reference frame pushed by JPy_PushLocalFrame. A single loop iteration
+ * may create a few local references, e.g. a map entry, its key and its value.
+ */
+#define JPy_LOCAL_FRAME_CAPACITY (4 * JPy_LOCAL_FRAME_CHUNK_SIZE)
+
+/**
+ * Pushes a new JNI local reference frame of capacity JPy_LOCAL_FRAME_CAPACITY.
+ * Returns 0 on success. Otherwise -1 is returned and a Java OutOfMemoryError is pending.
+ */
+int JPy_PushLocalFrame(JNIEnv* jenv);
+
+/**
+ * Must be called at the beginning of loop iteration INDEX of a bulk conversion within a frame
+ * pushed by JPy_PushLocalFrame. Every JPy_LOCAL_FRAME_CHUNK_SIZE iterations the current frame is
+ * popped, which frees all local references created in it, and a new frame is pushed.
+ * Returns 0 on success. Otherwise -1 is returned, a Java OutOfMemoryError is pending and
+ * there is no frame left that must be popped by the caller.
+ */
+int JPy_RenewLocalFrame(JNIEnv* jenv, jint index);
+
+/**
+ * Gets the Python object wrapped by the given org.jpy.PyObject instance (a borrowed reference).
+ * The object's 'pointer' field is read directly, so that no Java method needs to be called.
+ */
+PyObject* JPy_GetPyObjectPointer(JNIEnv* jenv, jobject pyObjectRef);
+
+
 struct JPy_JType;
 
 extern struct JPy_JType* JPy_JBoolean;
@@ -122,6 +163,8 @@ extern struct JPy_JType* JPy_JPyModule;
 // java.lang.Comparable
 extern jclass JPy_Comparable_JClass;
 extern jmethodID JPy_Comparable_CompareTo_MID;
+// java.lang.Enum
+extern jclass JPy_Enum_JClass;
 // java.lang.Object
 extern jclass JPy_Object_JClass;
 extern jmethodID JPy_Object_ToString_MID;
@@ -161,6 +204,22 @@ extern jmethodID JPy_Map_put_MID;
 extern jmethodID JPy_Map_clear_MID;
 extern jmethodID JPy_Map_Entry_getKey_MID;
 extern jmethodID JPy_Map_Entry_getValue_MID;
+// java.util.Collection
+extern jclass JPy_Collection_JClass;
+extern jmethodID JPy_Collection_ToArray_MID;
+extern jmethodID JPy_Collection_Add_MID;
+extern jmethodID JPy_Collection_Size_MID;
+// java.util.List, java.util.RandomAccess
+extern jclass JPy_List_JClass;
+extern jmethodID JPy_List_SubList_MID;
+extern jclass JPy_RandomAccess_JClass;
+// java.util.HashMap, java.util.ArrayList, java.util.HashSet
+extern jclass JPy_HashMap_JClass;
+extern jmethodID JPy_HashMap_Init_MID;
+extern jclass JPy_ArrayList_JClass;
+extern jmethodID JPy_ArrayList_Init_MID;
+extern jclass JPy_HashSet_JClass;
+extern jmethodID JPy_HashSet_Init_MID;
 // java.util.Set
 extern jclass JPy_Set_JClass;
 extern jmethodID JPy_Set_Iterator_MID;
@@ -177,41 +236,53 @@ extern jclass JPy_KeyError_JClass;
 extern jclass JPy_StopIteration_JClass;
 
 extern jclass JPy_Boolean_JClass;
-extern jmethodID JPy_Boolean_Init_MID;
+extern jmethodID JPy_Boolean_ValueOf_MID;
+extern jfieldID JPy_Boolean_Value_FID;
 extern jmethodID JPy_Boolean_BooleanValue_MID;
 
 extern jclass JPy_Character_JClass;
-extern jmethodID JPy_Character_Init_MID;
+extern jmethodID JPy_Character_ValueOf_MID;
+extern jfieldID JPy_Character_Value_FID;
 extern jmethodID JPy_Character_CharValue_MID;
 
 extern jclass JPy_Byte_JClass;
-extern jmethodID JPy_Byte_Init_MID;
+extern jmethodID JPy_Byte_ValueOf_MID;
+extern jfieldID JPy_Byte_Value_FID;
 
 extern jclass JPy_Short_JClass;
-extern jmethodID JPy_Short_Init_MID;
+extern jmethodID JPy_Short_ValueOf_MID;
+extern jfieldID JPy_Short_Value_FID;
 
 extern jclass JPy_Integer_JClass;
-extern jmethodID JPy_Integer_Init_MID;
+extern jmethodID JPy_Integer_ValueOf_MID;
+extern jfieldID JPy_Integer_Value_FID;
 
 extern jclass JPy_Long_JClass;
-extern jmethodID JPy_Long_Init_MID;
+extern jmethodID JPy_Long_ValueOf_MID;
+extern jfieldID JPy_Long_Value_FID;
 
 extern jclass JPy_Float_JClass;
-extern jmethodID JPy_Float_Init_MID;
+extern jmethodID JPy_Float_ValueOf_MID;
+extern jfieldID JPy_Float_Value_FID;
 
 extern jclass JPy_Double_JClass;
-extern jmethodID JPy_Double_Init_MID;
+extern jmethodID JPy_Double_ValueOf_MID;
+extern jfieldID JPy_Double_Value_FID;
 
 extern jclass JPy_Number_JClass;
 extern jmethodID JPy_Number_IntValue_MID;
 extern jmethodID JPy_Number_LongValue_MID;
 extern jmethodID JPy_Number_DoubleValue_MID;
 
+extern jclass JPy_BigDecimal_JClass;
+extern jmethodID JPy_BigDecimal_ToBigInteger_MID;
+
 extern jclass JPy_String_JClass;
 extern jclass JPy_Void_JClass;
 
 extern jclass JPy_PyObject_JClass;
 extern jmethodID JPy_PyObject_GetPointer_MID;
+extern jfieldID JPy_PyObject_Pointer_FID;
 extern jmethodID JPy_PyObject_Init_MID;
 
 extern jclass JPy_PyDictWrapper_JClass;
@@ -0,0 +1,403 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jpy_prof.h"
+#include "jpy_diag.h"
+#include "jpy_compat.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+int JPy_ProfilingEnabled = 0;
+
+// Maps callable names to PyCapsules holding a JPy_CallProfile.
+static PyObject* JPy_Profiles = NULL;
+
+static const char* JPy_PhaseNames[JPy_PROF_PHASE_COUNT] = {
+    "args",
+    "call",
+    "result",
+};
+
+
+long long JPy_GetNanos(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (long long) ((double) counter.QuadPart * 1.0e9 / (double) frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long) ts.tv_sec * 1000000000LL + (long long) ts.tv_nsec;
+#endif
+}
+
+
+static int JPy_Log2(unsigned long long value)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#else
+    int n = 0;
+    while (value >>= 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+static int JPy_GetBucketIndex(long long value)
+{
+    int magnitude;
+    int index;
+
+    if (value < JPy_PROF_SUB_BUCKET_COUNT) {
+        return value < 0 ? 0 : (int) value;
+    }
+    magnitude = JPy_Log2((unsigned long long) value) - JPy_PROF_SUB_BUCKET_BITS;
+    index = (magnitude + 1) * JPy_PROF_SUB_BUCKET_COUNT + (int) ((value >> magnitude) & (JPy_PROF_SUB_BUCKET_COUNT - 1));
+    return index < JPy_PROF_BUCKET_COUNT ? index : JPy_PROF_BUCKET_COUNT - 1;
+}
+
+/**
+ * Returns the highest value that is recorded into the bucket with the given index.
+ */
+static long long JPy_GetBucketUpperBound(int index)
+{
+    int magnitude;
+    int subIndex;
+
+    if (index < JPy_PROF_SUB_BUCKET_COUNT) {
+        return index;
+    }
+    magnitude = index / JPy_PROF_SUB_BUCKET_COUNT - 1;
+    subIndex = index % JPy_PROF_SUB_BUCKET_COUNT;
+    return ((long long) (JPy_PROF_SUB_BUCKET_COUNT + subIndex + 1) << magnitude) - 1;
+}
+
+static void JPy_RecordValue(JPy_Histogram* histogram, long long value)
+{
+    if (value < 0) {
+        value = 0;
+    }
+#ifdef JPY_FREE_THREADED
+    // Without a GIL, several threads may record calls of the same callable at the same time.
+    // A lost update of the maximum is tolerated.
+    JPy_ATOMIC_ADD(&histogram->count, 1);
+    JPy_ATOMIC_ADD(&histogram->sum, value);
+    JPy_ATOMIC_ADD(&histogram->buckets[JPy_GetBucketIndex(value)], 1);
+#else
+    histogram->count++;
+    histogram->sum += value;
+    histogram->buckets[JPy_GetBucketIndex(value)]++;
+#endif
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+}
+
+/**
+ * Returns the value at the given percentile (0 < p <= 100) with the histogram's precision.
+ */
+static long long JPy_GetPercentile(JPy_Histogram* histogram, double p)
+{
+    long long rank;
+    long long n;
+    int i;
+
+    if (histogram->count == 0) {
+        return 0;
+    }
+    rank = (long long) (p / 100.0 * (double) histogram->count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    n = 0;
+    for (i = 0; i < JPy_PROF_BUCKET_COUNT; i++) {
+        n += histogram->buckets[i];
+        if (n >= rank) {
+            long long value = JPy_GetBucketUpperBound(i);
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+static long long JPy_GetTotalTime(JPy_CallProfile* profile)
+{
+    return profile->phases[JPy_PROF_PHASE_ARGS].sum
+         + profile->phases[JPy_PROF_PHASE_CALL].sum
+         + profile->phases[JPy_PROF_PHASE_RESULT].sum;
+}
+
+
+static void JPy_DestroyCallProfile(PyObject* capsule)
+{
+    JPy_CallProfile* profile = (JPy_CallProfile*) PyCapsule_GetPointer(capsule, NULL);
+    if (profile != NULL) {
+        PyMem_Free(profile->name);
+        PyMem_Free(profile);
+    }
+}
+
+static JPy_CallProfile* JPy_GetCallProfileLocked(char kind, const char* name);
+
+JPy_CallProfile* JPy_GetCallProfile(char kind, const char* name)
+{
+    JPy_CallProfile* profile;
+
+    JPy_BEGIN_GLOBAL_LOCK
+    profile = JPy_GetCallProfileLocked(kind, name);
+    JPy_END_GLOBAL_LOCK
+
+    return profile;
+}
+
+static JPy_CallProfile* JPy_GetCallProfileLocked(char kind, const char* name)
+{
+    JPy_CallProfile* profile;
+    PyObject* capsule;
+    size_t nameLength;
+
+    if (JPy_Profiles == NULL) {
+        JPy_Profiles = PyDict_New();
+        if (JPy_Profiles == NULL) {
+            return NULL;
+        }
+    }
+
+    capsule = PyDict_GetItemString(JPy_Profiles, name);
+    if (capsule != NULL) {
+        return (JPy_CallProfile*) PyCapsule_GetPointer(capsule, NULL);
+    }
+
+    profile = PyMem_Malloc(sizeof (JPy_CallProfile));
+    if (profile == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    memset(profile, 0, sizeof (JPy_CallProfile));
+    profile->kind = kind;
+    nameLength = strlen(name);
+    profile->name = PyMem_Malloc(nameLength + 1);
+    if (profile->name == NULL) {
+        PyMem_Free(profile);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    memcpy(profile->name, name, nameLength + 1);
+
+    capsule = PyCapsule_New(profile, NULL, JPy_DestroyCallProfile);
+    if (capsule == NULL) {
+        PyMem_Free(profile->name);
+        PyMem_Free(profile);
+        return NULL;
+    }
+    if (PyDict_SetItemString(JPy_Profiles, name, capsule) < 0) {
+        Py_DECREF(capsule);
+        return NULL;
+    }
+    Py_DECREF(capsule);
+
+    return profile;
+}
+
+void JPy_RecordCall(JPy_CallProfile* profile, long long t0, long long t1, long long t2, long long t3)
+{
+    JPy_RecordValue(&profile->phases[JPy_PROF_PHASE_ARGS], t1 - t0);
+    JPy_RecordValue(&profile->phases[JPy_PROF_PHASE_CALL], t2 - t1);
+    JPy_RecordValue(&profile->phases[JPy_PROF_PHASE_RESULT], t3 - t2);
+}
+
+void JPy_ResetProfiles(void)
+{
+    PyObject* key;
+    PyObject* capsule;
+    Py_ssize_t pos;
+    JPy_CallProfile* profile;
+
+    if (JPy_Profiles == NULL) {
+        return;
+    }
+
+    // Profiles are only cleared, not removed, because JPy_JMethod instances keep pointers to them.
+    pos = 0;
+    while (PyDict_Next(JPy_Profiles, &pos, &key, &capsule)) {
+        profile = (JPy_CallProfile*) PyCapsule_GetPointer(capsule, NULL);
+        memset(profile->phases, 0, sizeof (profile->phases));
+    }
+}
+
+static int JPy_CompareProfiles(const void* p1, const void* p2)
+{
+    long long t1 = JPy_GetTotalTime(*(JPy_CallProfile**) p1);
+    long long t2 = JPy_GetTotalTime(*(JPy_CallProfile**) p2);
+    return t1 < t2 ? 1 : (t1 > t2 ? -1 : 0);
+}
+
+/**
+ * Returns a new, PyMem_Malloc'ed array of the n profiles with the highest total time,
+ * sorted in descending order. The actual number of profiles is returned in count.
+ */
+static JPy_CallProfile** JPy_GetTopProfiles(int n, int* count)
+{
+    JPy_CallProfile** profiles;
+    PyObject* key;
+    PyObject* capsule;
+    Py_ssize_t pos;
+    Py_ssize_t size;
+    int i;
+
+    size = JPy_Profiles != NULL ? PyDict_Size(JPy_Profiles) : 0;
+    profiles = PyMem_Malloc((size > 0 ? size : 1) * sizeof (JPy_CallProfile*));
+    if (profiles == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    i = 0;
+    pos = 0;
+    while (size > 0 && PyDict_Next(JPy_Profiles, &pos, &key, &capsule)) {
+        JPy_CallProfile* profile = (JPy_CallProfile*) PyCapsule_GetPointer(capsule, NULL);
+        if (profile->phases[JPy_PROF_PHASE_CALL].count > 0) {
+            profiles[i++] = profile;
+        }
+    }
+
+    qsort(profiles, i, sizeof (JPy_CallProfile*), JPy_CompareProfiles);
+
+    *count = n >= 0 && n < i ? n : i;
+    return profiles;
+}
+
+static PyObject* JPy_HistogramToDict(JPy_Histogram* histogram)
+{
+    return Py_BuildValue("{s:L,s:L,s:L,s:L,s:L,s:L}",
+                         "mean_ns", histogram->count > 0 ? histogram->sum / histogram->count : 0LL,
+                         "p50_ns", JPy_GetPercentile(histogram, 50.0),
+                         "p90_ns", JPy_GetPercentile(histogram, 90.0),
+                         "p99_ns", JPy_GetPercentile(histogram, 99.0),
+                         "max_ns", histogram->max,
+                         "total_ns", histogram->sum);
+}
+
+PyObject* JPy_GetProfileReport(int n)
+{
+    JPy_CallProfile** profiles;
+    PyObject* report;
+    PyObject* item;
+    PyObject* phase;
+    int count;
+    int i;
+    int j;
+
+    profiles = JPy_GetTopProfiles(n, &count);
+    if (profiles == NULL) {
+        return NULL;
+    }
+
+    report = PyList_New(count);
+    if (report == NULL) {
+        PyMem_Free(profiles);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++) {
+        JPy_CallProfile* profile = profiles[i];
+        item = Py_BuildValue("{s:s,s:s,s:L,s:L}",
+                             "name", profile->name,
+                             "kind", profile->kind == JPy_PROF_KIND_JAVA ? "java" : "python",
+                             "count", profile->phases[JPy_PROF_PHASE_CALL].count,
+                             "total_ns", JPy_GetTotalTime(profile));
+        if (item == NULL) {
+            goto error;
+        }
+        // item reference stolen here
+        PyList_SET_ITEM(report, i, item);
+        for (j = 0; j < JPy_PROF_PHASE_COUNT; j++) {
+            phase = JPy_HistogramToDict(&profile->phases[j]);
+            if (phase == NULL || PyDict_SetItemString(item, JPy_PhaseNames[j], phase) < 0) {
+                Py_XDECREF(phase);
+                goto error;
+            }
+            Py_DECREF(phase);
+        }
+    }
+
+    PyMem_Free(profiles);
+    return report;
+
+error:
+    PyMem_Free(profiles);
+    Py_DECREF(report);
+    return NULL;
+}
+
+#define JPy_PROF_LINE_SIZE 512
+
+char* JPy_FormatProfileReport(int n)
+{
+    JPy_CallProfile** profiles;
+    char* text;
+    size_t length;
+    int count;
+    int i;
+
+    profiles = JPy_GetTopProfiles(n, &count);
+    if (profiles == NULL) {
+        return NULL;
+    }
+
+    text = PyMem_Malloc((count + 1) * JPy_PROF_LINE_SIZE);
+    if (text == NULL) {
+        PyMem_Free(profiles);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    // All times in microseconds
+    length = PyOS_snprintf(text, JPy_PROF_LINE_SIZE,
+                           "%-6s %10s %12s %10s %10s %10s %10s %10s %10s  %s\n",
+                           "kind", "count", "total_us",
+                           "args_p50", "args_p99", "call_p50", "call_p99", "result_p50", "result_p99",
+                           "name");
+    for (i = 0; i < count; i++) {
+        JPy_CallProfile* profile = profiles[i];
+        length += PyOS_snprintf(text + length, JPy_PROF_LINE_SIZE,
+                                "%-6s %10lld %12.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f  %.200s\n",
+                                profile->kind == JPy_PROF_KIND_JAVA ? "java" : "python",
+                                profile->phases[JPy_PROF_PHASE_CALL].count,
+                                JPy_GetTotalTime(profile) / 1000.0,
+                                JPy_GetPercentile(&profile->phases[JPy_PROF_PHASE_ARGS], 50.0) / 1000.0,
+                                JPy_GetPercentile(&profile->phases[JPy_PROF_PHASE_ARGS], 99.0) / 1000.0,
+                                JPy_GetPercentile(&profile->phases[JPy_PROF_PHASE_CALL], 50.0) / 1000.0,
+                                JPy_GetPercentile(&profile->phases[JPy_PROF_PHASE_CALL], 99.0) / 1000.0,
+                                JPy_GetPercentile(&profile->phases[JPy_PROF_PHASE_RESULT], 50.0) / 1000.0,
+                                JPy_GetPercentile(&profile->phases[JPy_PROF_PHASE_RESULT], 99.0) / 1000.0,
+                                profile->name);
+    }
+
+    PyMem_Free(profiles);
+    return text;
+}
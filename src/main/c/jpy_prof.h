@@ -0,0 +1,120 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JPY_PROF_H
+#define JPY_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "jpy_compat.h"
+
+/**
+ * Optional call profiling. If enabled, the latency of every Python->Java method call (JPy_JMethod)
+ * and of every Java->Python call (PyLib_CallAndReturnObject) is recorded into per-callable
+ * histograms, split into the three phases argument conversion, the actual call and result conversion.
+ *
+ * All functions declared here must be called while holding the GIL.
+ */
+
+#define JPy_PROF_PHASE_ARGS     0
+#define JPy_PROF_PHASE_CALL     1
+#define JPy_PROF_PHASE_RESULT   2
+#define JPy_PROF_PHASE_COUNT    3
+
+#define JPy_PROF_KIND_JAVA      'J'
+#define JPy_PROF_KIND_PYTHON    'P'
+
+/**
+ * Histograms use HDR-style log-linear buckets: values below JPy_PROF_SUB_BUCKET_COUNT nanoseconds
+ * have their own bucket, every further power of two is split into JPy_PROF_SUB_BUCKET_COUNT linear
+ * sub-buckets. This keeps the relative error below 1/JPy_PROF_SUB_BUCKET_COUNT.
+ * Durations longer than 2^(JPy_PROF_MAX_MAGNITUDE + JPy_PROF_SUB_BUCKET_BITS) ns (~2.5 hours)
+ * are recorded in the last bucket.
+ */
+#define JPy_PROF_SUB_BUCKET_BITS    3
+#define JPy_PROF_SUB_BUCKET_COUNT   (1 << JPy_PROF_SUB_BUCKET_BITS)
+#define JPy_PROF_MAX_MAGNITUDE      40
+#define JPy_PROF_BUCKET_COUNT       ((JPy_PROF_MAX_MAGNITUDE + 1) * JPy_PROF_SUB_BUCKET_COUNT)
+
+typedef struct JPy_Histogram
+{
+    // Number of recorded values.
+    long long count;
+    // Sum of all recorded values in nanoseconds.
+    long long sum;
+    // Maximum recorded value in nanoseconds.
+    long long max;
+    // Value counts per bucket.
+    long long buckets[JPy_PROF_BUCKET_COUNT];
+}
+JPy_Histogram;
+
+typedef struct JPy_CallProfile
+{
+    // One of JPy_PROF_KIND_JAVA, JPy_PROF_KIND_PYTHON.
+    char kind;
+    // Name of the profiled callable, e.g. "java.lang.String#indexOf(java.lang.String,int)".
+    char* name;
+    // One histogram per JPy_PROF_PHASE_* constant.
+    JPy_Histogram phases[JPy_PROF_PHASE_COUNT];
+}
+JPy_CallProfile;
+
+/**
+ * Non-zero, if call profiling is enabled. Controlled by jpy.diag.profiling and PyLib.Diag.setProfiling().
+ */
+extern int JPy_ProfilingEnabled;
+
+/**
+ * Returns a monotonic timestamp in nanoseconds.
+ */
+long long JPy_GetNanos(void);
+
+/**
+ * Returns the profile registered for the given callable name, creates and registers a new one if it doesn't exist yet.
+ * Profiles live until the module is unloaded, so callers may cache the returned pointer.
+ * Returns NULL and sets a Python error if memory allocation fails.
+ */
+JPy_CallProfile* JPy_GetCallProfile(char kind, const char* name);
+
+/**
+ * Records a single call: args = t1 - t0, call = t2 - t1, result = t3 - t2.
+ */
+void JPy_RecordCall(JPy_CallProfile* profile, long long t0, long long t1, long long t2, long long t3);
+
+/**
+ * Clears all recorded values of all registered profiles.
+ */
+void JPy_ResetProfiles(void);
+
+/**
+ * Returns a new list of dictionaries describing the n profiles with the highest total time, in descending order.
+ */
+PyObject* JPy_GetProfileReport(int n);
+
+/**
+ * Returns a new, PyMem_Malloc'ed text table describing the n profiles with the highest total time.
+ * Returns NULL and sets a Python error if memory allocation fails.
+ */
+char* JPy_FormatProfileReport(int n);
+
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+#endif /* !JPY_PROF_H */
@@ -0,0 +1,506 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jpy_module.h"
+#include "jpy_diag.h"
+#include "jpy_jtype.h"
+#include "jpy_jmethod.h"
+#include "jpy_trace.h"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <signal.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if defined(_MSC_VER)
+    #define JPy_CAS_PTR(PTR, OLD, NEW) (InterlockedCompareExchangePointer((PVOID volatile*) (PTR), (NEW), (OLD)) == (OLD))
+    #define JPy_CAS_INT(PTR, OLD, NEW) (InterlockedCompareExchange((LONG volatile*) (PTR), (NEW), (OLD)) == (OLD))
+#else
+    #define JPy_CAS_PTR(PTR, OLD, NEW) __sync_bool_compare_and_swap((PTR), (OLD), (NEW))
+    #define JPy_CAS_INT(PTR, OLD, NEW) __sync_bool_compare_and_swap((PTR), (OLD), (NEW))
+#endif
+
+// Dump file format, see also jpytrace.py
+#define JPy_TRACE_FILE_MAGIC        "JPYTRACE"
+#define JPy_TRACE_FILE_VERSION      1
+#define JPy_TRACE_FILE_BYTE_ORDER   0x01020304
+#define JPy_TRACE_TAG_END           0
+#define JPy_TRACE_TAG_SYMBOL        1
+#define JPy_TRACE_TAG_THREAD        2
+
+/**
+ * The ring buffer of a single thread. Rings are never freed: when their thread terminates,
+ * they are released and later reused by new threads.
+ */
+typedef struct JPy_TraceRing
+{
+    // Next ring in the registry.
+    struct JPy_TraceRing* next;
+    // Non-zero while the ring is owned by a thread.
+    volatile long inUse;
+    // Trace-local thread identifier, assigned when a thread takes over the ring.
+    long long threadId;
+    // Total number of events recorded, the next event is written at index (count % JPy_TRACE_RING_CAPACITY).
+    long long count;
+    JPy_TraceEvent events[JPy_TRACE_RING_CAPACITY];
+}
+JPy_TraceRing;
+
+int JPy_TraceEnabled = 0;
+
+// Head of the list of all rings ever allocated.
+static JPy_TraceRing* volatile JPy_TraceRings = NULL;
+static long long JPy_TraceThreadCount = 0;
+// Maps interned Python callable names to themselves, the address of the value is used as trace event subject.
+static PyObject* JPy_TraceNames = NULL;
+
+
+#if defined(_WIN32)
+
+static DWORD JPy_TraceKey = FLS_OUT_OF_INDEXES;
+static INIT_ONCE JPy_TraceKeyOnce = INIT_ONCE_STATIC_INIT;
+
+static VOID WINAPI JPy_ReleaseTraceRing(PVOID ring)
+{
+    if (ring != NULL) {
+        ((JPy_TraceRing*) ring)->inUse = 0;
+    }
+}
+
+static BOOL CALLBACK JPy_CreateTraceKey(PINIT_ONCE initOnce, PVOID parameter, PVOID* context)
+{
+    JPy_TraceKey = FlsAlloc(JPy_ReleaseTraceRing);
+    return TRUE;
+}
+
+#define JPy_INIT_TRACE_KEY()        InitOnceExecuteOnce(&JPy_TraceKeyOnce, JPy_CreateTraceKey, NULL, NULL)
+#define JPy_TRACE_KEY_VALID()       (JPy_TraceKey != FLS_OUT_OF_INDEXES)
+#define JPy_GET_TRACE_RING()        ((JPy_TraceRing*) FlsGetValue(JPy_TraceKey))
+#define JPy_SET_TRACE_RING(RING)    FlsSetValue(JPy_TraceKey, (RING))
+
+#else
+
+static pthread_key_t JPy_TraceKey;
+static int JPy_TraceKeyValid = 0;
+static pthread_once_t JPy_TraceKeyOnce = PTHREAD_ONCE_INIT;
+
+static void JPy_ReleaseTraceRing(void* ring)
+{
+    if (ring != NULL) {
+        ((JPy_TraceRing*) ring)->inUse = 0;
+    }
+}
+
+static void JPy_CreateTraceKey(void)
+{
+    JPy_TraceKeyValid = pthread_key_create(&JPy_TraceKey, JPy_ReleaseTraceRing) == 0;
+}
+
+#define JPy_INIT_TRACE_KEY()        pthread_once(&JPy_TraceKeyOnce, JPy_CreateTraceKey)
+#define JPy_TRACE_KEY_VALID()       JPy_TraceKeyValid
+#define JPy_GET_TRACE_RING()        ((JPy_TraceRing*) pthread_getspecific(JPy_TraceKey))
+#define JPy_SET_TRACE_RING(RING)    pthread_setspecific(JPy_TraceKey, (RING))
+
+#endif
+
+
+void JPy_SetTracing(int enabled)
+{
+    if (enabled) {
+        JPy_INIT_TRACE_KEY();
+        enabled = JPy_TRACE_KEY_VALID();
+    }
+    JPy_TraceEnabled = enabled;
+}
+
+/**
+ * Returns the calling thread's ring, takes over a released one or allocates a new one on first use.
+ */
+static JPy_TraceRing* JPy_GetTraceRing(void)
+{
+    JPy_TraceRing* ring;
+    JPy_TraceRing* head;
+
+    ring = JPy_GET_TRACE_RING();
+    if (ring != NULL) {
+        return ring;
+    }
+
+    for (ring = JPy_TraceRings; ring != NULL; ring = ring->next) {
+        if (ring->inUse == 0 && JPy_CAS_INT(&ring->inUse, 0, 1)) {
+            break;
+        }
+    }
+
+    if (ring == NULL) {
+        // Note: we can't use PyMem_Malloc() here, the calling thread may not hold the GIL
+        ring = (JPy_TraceRing*) calloc(1, sizeof (JPy_TraceRing));
+        if (ring == NULL) {
+            return NULL;
+        }
+        ring->inUse = 1;
+        do {
+            head = JPy_TraceRings;
+            ring->next = head;
+        } while (!JPy_CAS_PTR(&JPy_TraceRings, head, ring));
+    }
+
+    ring->count = 0;
+    ring->threadId = JPy_ATOMIC_ADD(&JPy_TraceThreadCount, 1) + 1;
+    JPy_SET_TRACE_RING(ring);
+    return ring;
+}
+
+void JPy_TraceRecord(int eventId, const void* subject, int argCount, long long timestamp, long long duration)
+{
+    JPy_TraceRing* ring;
+    JPy_TraceEvent* event;
+
+    ring = JPy_GetTraceRing();
+    if (ring == NULL) {
+        return;
+    }
+
+    event = &ring->events[ring->count & (JPy_TRACE_RING_CAPACITY - 1)];
+    event->timestamp = timestamp;
+    event->duration = duration;
+    event->subject = (unsigned long long) (size_t) subject;
+    event->eventId = eventId;
+    event->argCount = argCount;
+
+    // Only the owning thread writes to the ring, the atomic increment publishes the event to dumping threads
+    JPy_ATOMIC_ADD(&ring->count, 1);
+}
+
+void JPy_TraceClear(void)
+{
+    JPy_TraceRing* ring;
+    for (ring = JPy_TraceRings; ring != NULL; ring = ring->next) {
+        ring->count = 0;
+    }
+}
+
+static const void* JPy_TraceInternNameLocked(const char* name);
+
+const void* JPy_TraceInternName(const char* name)
+{
+    const void* subject;
+
+    JPy_BEGIN_GLOBAL_LOCK
+    subject = JPy_TraceInternNameLocked(name);
+    JPy_END_GLOBAL_LOCK
+
+    return subject;
+}
+
+static const void* JPy_TraceInternNameLocked(const char* name)
+{
+    PyObject* pyName;
+    PyObject* pyInterned;
+
+    if (JPy_TraceNames == NULL) {
+        JPy_TraceNames = PyDict_New();
+        if (JPy_TraceNames == NULL) {
+            PyErr_Clear();
+            return NULL;
+        }
+    }
+
+    pyInterned = PyDict_GetItemString(JPy_TraceNames, name);
+    if (pyInterned != NULL) {
+        return pyInterned;
+    }
+
+    pyName = JPy_FROM_CSTR(name);
+    if (pyName == NULL || PyDict_SetItem(JPy_TraceNames, pyName, pyName) < 0) {
+        Py_XDECREF(pyName);
+        PyErr_Clear();
+        return NULL;
+    }
+    // The dictionary keeps pyName alive
+    Py_DECREF(pyName);
+    return pyName;
+}
+
+
+/**
+ * Output function used to write dump files: returns 0 on success, -1 on failure.
+ */
+typedef int (*JPy_TraceWriteFn)(void* target, const void* data, size_t size);
+
+static int JPy_TraceWriteHeader(JPy_TraceWriteFn writeFn, void* target)
+{
+    unsigned int header[4];
+
+    header[0] = JPy_TRACE_FILE_VERSION;
+    header[1] = JPy_TRACE_FILE_BYTE_ORDER;
+    header[2] = sizeof (JPy_TraceEvent);
+    header[3] = 0;
+
+    if (writeFn(target, JPy_TRACE_FILE_MAGIC, 8) < 0) {
+        return -1;
+    }
+    return writeFn(target, header, sizeof (header));
+}
+
+static int JPy_TraceWriteSymbol(JPy_TraceWriteFn writeFn, void* target, const void* subject, const char* name)
+{
+    unsigned int tag = JPy_TRACE_TAG_SYMBOL;
+    unsigned long long address = (unsigned long long) (size_t) subject;
+    unsigned int length = (unsigned int) strlen(name);
+
+    if (writeFn(target, &tag, sizeof (tag)) < 0
+        || writeFn(target, &address, sizeof (address)) < 0
+        || writeFn(target, &length, sizeof (length)) < 0) {
+        return -1;
+    }
+    return writeFn(target, name, length);
+}
+
+/**
+ * Writes the events of all rings and the end tag. Doesn't allocate any memory, so that it can be used from signal handlers.
+ * Returns the number of events written or -1 on failure.
+ */
+static long long JPy_TraceWriteRings(JPy_TraceWriteFn writeFn, void* target)
+{
+    JPy_TraceRing* ring;
+    unsigned int tag;
+    long long count;
+    long long first;
+    long long eventCount;
+    long long total;
+    int firstIndex;
+    int n1;
+
+    total = 0;
+    for (ring = JPy_TraceRings; ring != NULL; ring = ring->next) {
+        count = JPy_ATOMIC_GET(&ring->count);
+        if (count <= 0) {
+            continue;
+        }
+        eventCount = count < JPy_TRACE_RING_CAPACITY ? count : JPy_TRACE_RING_CAPACITY;
+        first = count - eventCount;
+        firstIndex = (int) (first & (JPy_TRACE_RING_CAPACITY - 1));
+        n1 = JPy_TRACE_RING_CAPACITY - firstIndex;
+        if (n1 > eventCount) {
+            n1 = (int) eventCount;
+        }
+
+        tag = JPy_TRACE_TAG_THREAD;
+        if (writeFn(target, &tag, sizeof (tag)) < 0
+            || writeFn(target, &ring->threadId, sizeof (ring->threadId)) < 0
+            || writeFn(target, &eventCount, sizeof (eventCount)) < 0
+            || writeFn(target, ring->events + firstIndex, n1 * sizeof (JPy_TraceEvent)) < 0
+            || writeFn(target, ring->events, (size_t) (eventCount - n1) * sizeof (JPy_TraceEvent)) < 0) {
+            return -1;
+        }
+        total += eventCount;
+    }
+
+    tag = JPy_TRACE_TAG_END;
+    if (writeFn(target, &tag, sizeof (tag)) < 0) {
+        return -1;
+    }
+    return total;
+}
+
+/**
+ * Writes the names of all known Java types, overloaded methods and methods as well as the interned Python names.
+ */
+static int JPy_TraceWriteSymbols(JPy_TraceWriteFn writeFn, void* target)
+{
+    PyObject* typeKey;
+    PyObject* typeValue;
+    PyObject* attrKey;
+    PyObject* attrValue;
+    Py_ssize_t typePos;
+    Py_ssize_t attrPos;
+    Py_ssize_t i;
+    char* name;
+    int status;
+
+    typePos = 0;
+    while (JPy_Types != NULL && PyDict_Next(JPy_Types, &typePos, &typeKey, &typeValue)) {
+        JPy_JType* type = (JPy_JType*) typeValue;
+        if (!JType_Check(typeValue)) {
+            continue;
+        }
+        if (JPy_TraceWriteSymbol(writeFn, target, type, type->javaName) < 0) {
+            return -1;
+        }
+        if (type->typeObj.tp_dict == NULL) {
+            continue;
+        }
+        attrPos = 0;
+        while (PyDict_Next(type->typeObj.tp_dict, &attrPos, &attrKey, &attrValue)) {
+            JPy_JOverloadedMethod* overloadedMethod;
+            if (!PyObject_TypeCheck(attrValue, &JOverloadedMethod_Type)) {
+                continue;
+            }
+            overloadedMethod = (JPy_JOverloadedMethod*) attrValue;
+            name = PyMem_Malloc(strlen(type->javaName) + strlen(JPy_AS_UTF8(overloadedMethod->name)) + 2);
+            if (name == NULL) {
+                return -1;
+            }
+            strcpy(name, type->javaName);
+            strcat(name, "#");
+            strcat(name, JPy_AS_UTF8(overloadedMethod->name));
+            status = JPy_TraceWriteSymbol(writeFn, target, overloadedMethod, name);
+            PyMem_Free(name);
+            if (status < 0) {
+                return -1;
+            }
+            for (i = 0; i < PyList_Size(overloadedMethod->methodList); i++) {
+                JPy_JMethod* method = (JPy_JMethod*) PyList_GetItem(overloadedMethod->methodList, i);
+                name = JMethod_GetSignatureName(method);
+                if (name == NULL) {
+                    return -1;
+                }
+                status = JPy_TraceWriteSymbol(writeFn, target, method, name);
+                PyMem_Free(name);
+                if (status < 0) {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    typePos = 0;
+    while (JPy_TraceNames != NULL && PyDict_Next(JPy_TraceNames, &typePos, &typeKey, &typeValue)) {
+        if (JPy_TraceWriteSymbol(writeFn, target, typeValue, JPy_AS_UTF8(typeValue)) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int JPy_TraceWriteToFile(void* target, const void* data, size_t size)
+{
+    return size == 0 || fwrite(data, 1, size, (FILE*) target) == size ? 0 : -1;
+}
+
+long long JPy_TraceDump(const char* path)
+{
+    FILE* file;
+    long long count;
+
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        PyErr_SetFromErrnoWithFilename(PyExc_IOError, path);
+        return -1;
+    }
+
+    count = -1;
+    if (JPy_TraceWriteHeader(JPy_TraceWriteToFile, file) == 0
+        && JPy_TraceWriteSymbols(JPy_TraceWriteToFile, file) == 0) {
+        count = JPy_TraceWriteRings(JPy_TraceWriteToFile, file);
+    }
+
+    if (fclose(file) != 0) {
+        count = -1;
+    }
+    if (count < 0 && !PyErr_Occurred()) {
+        PyErr_SetFromErrnoWithFilename(PyExc_IOError, path);
+    }
+    return count;
+}
+
+
+#if defined(_WIN32)
+
+int JPy_TraceSetCrashFile(const char* path)
+{
+    PyErr_SetString(PyExc_NotImplementedError, "trace dumps on crash are not supported on this platform");
+    return -1;
+}
+
+#else
+
+static char JPy_TraceCrashFile[1024];
+static struct sigaction JPy_TraceOldAbortAction;
+static int JPy_TraceCrashHandlerInstalled = 0;
+
+static int JPy_TraceWriteToFD(void* target, const void* data, size_t size)
+{
+    const char* bytes = (const char*) data;
+    ssize_t n;
+    while (size > 0) {
+        n = write(*(int*) target, bytes, size);
+        if (n <= 0) {
+            return -1;
+        }
+        bytes += n;
+        size -= (size_t) n;
+    }
+    return 0;
+}
+
+/**
+ * Only calls async-signal-safe functions. Note that we don't hook SIGSEGV, the JVM uses it internally.
+ */
+static void JPy_TraceOnAbort(int signal)
+{
+    int fd;
+
+    fd = open(JPy_TraceCrashFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        if (JPy_TraceWriteHeader(JPy_TraceWriteToFD, &fd) == 0) {
+            JPy_TraceWriteRings(JPy_TraceWriteToFD, &fd);
+        }
+        close(fd);
+    }
+
+    sigaction(SIGABRT, &JPy_TraceOldAbortAction, NULL);
+    raise(SIGABRT);
+}
+
+int JPy_TraceSetCrashFile(const char* path)
+{
+    struct sigaction action;
+
+    if (path == NULL) {
+        if (JPy_TraceCrashHandlerInstalled) {
+            sigaction(SIGABRT, &JPy_TraceOldAbortAction, NULL);
+            JPy_TraceCrashHandlerInstalled = 0;
+        }
+        return 0;
+    }
+
+    if (strlen(path) >= sizeof (JPy_TraceCrashFile)) {
+        PyErr_SetString(PyExc_ValueError, "trace crash file path is too long");
+        return -1;
+    }
+    strcpy(JPy_TraceCrashFile, path);
+
+    if (!JPy_TraceCrashHandlerInstalled) {
+        memset(&action, 0, sizeof (action));
+        action.sa_handler = JPy_TraceOnAbort;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGABRT, &action, &JPy_TraceOldAbortAction) != 0) {
+            PyErr_SetFromErrno(PyExc_OSError);
+            return -1;
+        }
+        JPy_TraceCrashHandlerInstalled = 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JPY_TRACE_H
+#define JPY_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "jpy_compat.h"
+#include "jpy_prof.h"
+
+/**
+ * Low-overhead event tracing. If enabled, every thread records binary trace events into its own
+ * ring buffer holding the last JPy_TRACE_RING_CAPACITY events. Recording neither takes locks nor
+ * requires the GIL. The rings are written to a file by JPy_TraceDump() and can be decoded
+ * by the 'jpytrace' Python module, which can also convert them into Chrome trace-event JSON.
+ */
+
+// Make sure the following constants are same as the EVENT_* constants in module jpytrace
+#define JPy_TRACE_JAVA_CALL             1
+#define JPy_TRACE_JAVA_NEW              2
+#define JPy_TRACE_OVERLOAD_RESOLUTION   3
+#define JPy_TRACE_PYTHON_CALL           4
+#define JPy_TRACE_JAVA_EXCEPTION        5
+#define JPy_TRACE_PYTHON_EXCEPTION      6
+#define JPy_TRACE_TYPE_RESOLUTION       7
+
+// Must be a power of two
+#define JPy_TRACE_RING_CAPACITY         8192
+
+/**
+ * A single trace event. The layout is part of the dump file format, see jpytrace.py.
+ */
+typedef struct JPy_TraceEvent
+{
+    // Start time in nanoseconds, see JPy_GetNanos().
+    long long timestamp;
+    // Duration in nanoseconds, 0 for instantaneous events.
+    long long duration;
+    // Address of the traced JPy_JMethod, JPy_JOverloadedMethod or JPy_JType, or of an interned
+    // Python callable name (see JPy_TraceInternName()). May be 0.
+    unsigned long long subject;
+    // One of the JPy_TRACE_* event identifiers.
+    int eventId;
+    // Number of call arguments, 0 if not applicable.
+    int argCount;
+}
+JPy_TraceEvent;
+
+/**
+ * Non-zero, if tracing is enabled. Controlled by jpy.diag.tracing and PyLib.Diag.setTracing().
+ */
+extern int JPy_TraceEnabled;
+
+/**
+ * Returns a start timestamp for a traced event, or 0 if tracing is disabled.
+ */
+#define JPy_TRACE_BEGIN() (JPy_TraceEnabled ? JPy_GetNanos() : 0)
+
+/**
+ * Records an event started at T0 (as obtained from JPy_TRACE_BEGIN()) and ending now.
+ */
+#define JPy_TRACE_END(T0, EVENT_ID, SUBJECT, ARG_COUNT) \
+    if ((T0) != 0) JPy_TraceRecord(EVENT_ID, SUBJECT, ARG_COUNT, T0, JPy_GetNanos() - (T0))
+
+/**
+ * Records an instantaneous event.
+ */
+#define JPy_TRACE_EVENT(EVENT_ID, SUBJECT, ARG_COUNT) \
+    if (JPy_TraceEnabled) JPy_TraceRecord(EVENT_ID, SUBJECT, ARG_COUNT, JPy_GetNanos(), 0)
+
+/**
+ * Enables or disables tracing. May be called from any thread.
+ */
+void JPy_SetTracing(int enabled);
+
+/**
+ * Appends an event to the calling thread's ring buffer. May be called from any thread.
+ */
+void JPy_TraceRecord(int eventId, const void* subject, int argCount, long long timestamp, long long duration);
+
+/**
+ * Returns a stable address for the given name that can be used as trace event subject.
+ * The name is written into the symbol table of trace dumps. Must be called while holding the GIL.
+ * Returns NULL (and clears the Python error) if the name cannot be interned.
+ */
+const void* JPy_TraceInternName(const char* name);
+
+/**
+ * Writes all ring buffers and a symbol table of all known Java types and methods to the given file.
+ * Must be called while holding the GIL.
+ * Returns the number of events written, or -1 and sets a Python error on failure.
+ */
+long long JPy_TraceDump(const char* path);
+
+/**
+ * Discards the events of all ring buffers.
+ */
+void JPy_TraceClear(void);
+
+/**
+ * Installs a SIGABRT handler that dumps all ring buffers (without symbol table) into the given file
+ * before the process terminates. A NULL path uninstalls the handler.
+ * Returns 0 on success, or -1 and sets a Python error on failure or if not supported on this platform.
+ */
+int JPy_TraceSetCrashFile(const char* path);
+
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+#endif /* !JPY_TRACE_H */
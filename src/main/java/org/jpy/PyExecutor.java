@@ -0,0 +1,237 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Objects;
+import java.util.concurrent.Callable;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.locks.LockSupport;
+
+import static org.jpy.PyLib.assertPythonRuns;
+
+/**
+ * Executes Python calls asynchronously on a dedicated worker thread.
+ * <p>
+ * When many Java threads call into Python, each of them has to acquire the GIL on every call, so that the
+ * threads queue up in front of the GIL. A {@code PyExecutor} instead lets the calling threads put their calls into
+ * a lock-free queue. Its worker thread takes the calls from the queue in batches of up to {@code maxBatchSize}
+ * and executes each batch while acquiring the GIL only once. The results are delivered by
+ * {@code CompletableFuture}s, which are completed after the worker has released the GIL again, so that
+ * dependent stages never run while the GIL is held.
+ * <p>
+ * Tasks submitted using {@link #submit(Callable)} may use any jpy API. The {@code PyLib} functions they call will
+ * find the GIL already held by the worker thread. Tasks should not block waiting for other threads that need the GIL.
+ * <p>
+ * An executor must be closed before the Python interpreter is stopped.
+ *
+ * @author Norman Fomferra
+ * @since 0.10
+ */
+public class PyExecutor implements AutoCloseable {
+
+    /**
+     * The default maximum number of calls executed per GIL acquisition.
+     */
+    public static final int DEFAULT_MAX_BATCH_SIZE = 64;
+
+    private static final AtomicInteger threadCounter = new AtomicInteger();
+
+    private final int maxBatchSize;
+    private final ConcurrentLinkedQueue<Task<?>> queue = new ConcurrentLinkedQueue<>();
+    private final Thread worker;
+    private volatile boolean idle;
+    private volatile boolean closed;
+
+    /**
+     * Creates an executor using the {@link #DEFAULT_MAX_BATCH_SIZE}.
+     */
+    public PyExecutor() {
+        this(DEFAULT_MAX_BATCH_SIZE);
+    }
+
+    /**
+     * Creates an executor and starts its worker thread.
+     *
+     * @param maxBatchSize The maximum number of calls executed per GIL acquisition.
+     */
+    public PyExecutor(int maxBatchSize) {
+        assertPythonRuns();
+        if (maxBatchSize <= 0) {
+            throw new IllegalArgumentException("maxBatchSize must be greater than zero");
+        }
+        this.maxBatchSize = maxBatchSize;
+        this.worker = new Thread(this::runWorker, "jpy-executor-" + threadCounter.incrementAndGet());
+        this.worker.setDaemon(true);
+        this.worker.start();
+    }
+
+    /**
+     * Calls a Python callable asynchronously.
+     *
+     * @param callable The Python callable.
+     * @param args     The arguments, converted as by {@link PyObject#call(String, Object...)}.
+     * @return The future result of the call.
+     */
+    public CompletableFuture<PyObject> submit(PyObject callable, Object... args) {
+        return submit(PyObject.class, callable, args);
+    }
+
+    /**
+     * Calls a Python callable asynchronously and converts its return value into the given Java type.
+     *
+     * @param returnType The Java type of the result.
+     * @param callable   The Python callable.
+     * @param args       The arguments, converted as by {@link PyObject#call(String, Object...)}.
+     * @param <T>        The Java type of the result.
+     * @return The future result of the call.
+     */
+    public <T> CompletableFuture<T> submit(Class<T> returnType, PyObject callable, Object... args) {
+        Objects.requireNonNull(returnType, "returnType must not be null");
+        Objects.requireNonNull(callable, "callable must not be null");
+        final Object[] callArgs = args != null ? args : new Object[0];
+        return submit(() -> PyLib.callAndReturnValue(callable.getPointer(), false, "__call__",
+                callArgs.length, callArgs, null, returnType));
+    }
+
+    /**
+     * Executes a task on the worker thread while holding the GIL.
+     *
+     * @param task The task, which may use any jpy API.
+     * @param <T>  The type of the task's result.
+     * @return The future result of the task.
+     * @throws RejectedExecutionException If the executor has been closed.
+     */
+    public <T> CompletableFuture<T> submit(Callable<T> task) {
+        Objects.requireNonNull(task, "task must not be null");
+        Task<T> queuedTask = new Task<>(task);
+        if (closed) {
+            throw new RejectedExecutionException("executor has been closed");
+        }
+        queue.offer(queuedTask);
+        if (closed && queue.remove(queuedTask)) {
+            // Closed concurrently and the worker may have already stopped
+            throw new RejectedExecutionException("executor has been closed");
+        }
+        if (idle) {
+            LockSupport.unpark(worker);
+        }
+        return queuedTask.future;
+    }
+
+    /**
+     * Executes the calls already submitted and stops the worker thread.
+     *
+     * @throws InterruptedException If interrupted while waiting for the worker thread.
+     */
+    @Override
+    public void close() throws InterruptedException {
+        closed = true;
+        LockSupport.unpark(worker);
+        if (Thread.currentThread() != worker) {
+            worker.join();
+        }
+    }
+
+    private void runWorker() {
+        long threadState = PyLib.attachThread();
+        try {
+            List<Task<?>> batch = new ArrayList<>(maxBatchSize);
+            while (true) {
+                Task<?> task = queue.poll();
+                if (task == null) {
+                    if (closed) {
+                        // Calls submitted concurrently with close() may still be queued
+                        task = queue.poll();
+                        if (task == null) {
+                            break;
+                        }
+                    } else {
+                        // submit() sees idle == true if it has queued a task after our poll()
+                        idle = true;
+                        if (queue.isEmpty() && !closed) {
+                            LockSupport.park(this);
+                        }
+                        idle = false;
+                        continue;
+                    }
+                }
+                do {
+                    batch.add(task);
+                } while (batch.size() < maxBatchSize && (task = queue.poll()) != null);
+                executeBatch(threadState, batch);
+                batch.clear();
+            }
+        } finally {
+            if (PyLib.isPythonRunning()) {
+                PyLib.detachThread(threadState);
+            }
+        }
+    }
+
+    private static void executeBatch(long threadState, List<Task<?>> batch) {
+        if (!PyLib.isPythonRunning()) {
+            RuntimeException e = new IllegalStateException("PyLib not initialized");
+            for (Task<?> task : batch) {
+                task.future.completeExceptionally(e);
+            }
+            return;
+        }
+        PyLib.acquireGIL(threadState);
+        try {
+            for (Task<?> task : batch) {
+                task.run();
+            }
+        } finally {
+            PyLib.releaseGIL(threadState);
+        }
+        for (Task<?> task : batch) {
+            task.complete();
+        }
+    }
+
+    private static final class Task<T> {
+        final Callable<T> callable;
+        final CompletableFuture<T> future = new CompletableFuture<>();
+        T result;
+        Throwable error;
+
+        Task(Callable<T> callable) {
+            this.callable = callable;
+        }
+
+        void run() {
+            try {
+                result = callable.call();
+            } catch (Throwable t) {
+                error = t;
+            }
+        }
+
+        void complete() {
+            if (error != null) {
+                future.completeExceptionally(error);
+            } else {
+                future.complete(result);
+            }
+        }
+    }
+}
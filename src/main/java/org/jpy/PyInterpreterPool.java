@@ -0,0 +1,270 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy;
+
+import java.util.Objects;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static org.jpy.PyLib.assertPythonRuns;
+
+/**
+ * A pool of Python sub-interpreters, each having its own GIL, which execute Python functions in parallel.
+ * Requires Python 3.12 or higher.
+ * <p>
+ * All Java threads calling into the main Python interpreter serialize on its GIL. A {@code PyInterpreterPool}
+ * instead creates {@code size} isolated sub-interpreters, each owned by a worker thread, and dispatches calls to
+ * whichever worker is free. This lets pure Python functions, e.g. scoring functions, use multiple cores.
+ * <p>
+ * The sub-interpreters share no Python objects with the main interpreter or with each other. Their
+ * {@code sys.path} is a copy of the main interpreter's one, and every sub-interpreter imports the called modules
+ * itself, so module globals are per sub-interpreter. Extension modules not supporting multiple interpreters,
+ * including {@code jpy} itself, cannot be imported into them. Therefore only plain values are passed:
+ * <ul>
+ * <li>arguments may be {@code null}, {@code Boolean}, {@code Number}, {@code Character}, {@code String}
+ * or {@code Object[]} of these, which is passed as a {@code list};</li>
+ * <li>results may be {@code None}, {@code bool}, {@code int}, {@code float}, {@code str}, or a {@code list} or
+ * {@code tuple} of these, which is returned as an {@code Object[]}.</li>
+ * </ul>
+ * <p>
+ * A pool must be closed before the Python interpreter is stopped.
+ *
+ * @author Norman Fomferra
+ * @since 0.10
+ */
+public class PyInterpreterPool implements AutoCloseable {
+
+    private static final AtomicInteger poolCounter = new AtomicInteger();
+
+    private static final Task<?> STOP = new Task<>(null, null, null, null);
+
+    private final LinkedBlockingQueue<Task<?>> queue = new LinkedBlockingQueue<>();
+    private final Thread[] workers;
+    private volatile boolean closed;
+
+    /**
+     * Creates a pool of sub-interpreters.
+     *
+     * @param size The number of sub-interpreters.
+     */
+    public PyInterpreterPool(int size) {
+        this(size, null);
+    }
+
+    /**
+     * Creates a pool of sub-interpreters and executes the given Python statements in the {@code __main__} module
+     * of each of them, e.g. to import modules or to define functions.
+     *
+     * @param size     The number of sub-interpreters.
+     * @param initCode Python statements executed by each sub-interpreter, may be {@code null}.
+     * @throws UnsupportedOperationException If Python is older than 3.12.
+     * @throws RuntimeException              If a sub-interpreter could not be created or {@code initCode} failed.
+     */
+    public PyInterpreterPool(int size, String initCode) {
+        assertPythonRuns();
+        if (size <= 0) {
+            throw new IllegalArgumentException("size must be greater than zero");
+        }
+        int poolIndex = poolCounter.incrementAndGet();
+        workers = new Thread[size];
+        CompletableFuture<?>[] started = new CompletableFuture<?>[size];
+        for (int i = 0; i < size; i++) {
+            CompletableFuture<Void> workerStarted = new CompletableFuture<>();
+            started[i] = workerStarted;
+            workers[i] = new Thread(() -> runWorker(initCode, workerStarted), "jpy-interpreter-" + poolIndex + "-" + i);
+            workers[i].setDaemon(true);
+            workers[i].start();
+        }
+        try {
+            CompletableFuture.allOf(started).join();
+        } catch (CompletionException e) {
+            try {
+                close();
+            } catch (InterruptedException ie) {
+                Thread.currentThread().interrupt();
+            }
+            if (e.getCause() instanceof RuntimeException) {
+                throw (RuntimeException) e.getCause();
+            }
+            throw e;
+        }
+    }
+
+    /**
+     * @return The number of sub-interpreters.
+     */
+    public int getSize() {
+        return workers.length;
+    }
+
+    /**
+     * Calls a function of a Python module in one of the sub-interpreters.
+     *
+     * @param moduleName   The module name, e.g. {@code "__main__"} for functions defined by the {@code initCode}.
+     * @param functionName The function name.
+     * @param args         The arguments.
+     * @return The future result of the call.
+     */
+    public CompletableFuture<Object> call(String moduleName, String functionName, Object... args) {
+        return call(Object.class, moduleName, functionName, args);
+    }
+
+    /**
+     * Calls a function of a Python module in one of the sub-interpreters and converts its result into the given type.
+     * Python {@code int} and {@code float} results may be converted into any primitive number type
+     * or its wrapper class.
+     *
+     * @param returnType   The Java type of the result.
+     * @param moduleName   The module name, e.g. {@code "__main__"} for functions defined by the {@code initCode}.
+     * @param functionName The function name.
+     * @param args         The arguments.
+     * @param <T>          The Java type of the result.
+     * @return The future result of the call.
+     * @throws RejectedExecutionException If the pool has been closed.
+     */
+    public <T> CompletableFuture<T> call(Class<T> returnType, String moduleName, String functionName, Object... args) {
+        Objects.requireNonNull(returnType, "returnType must not be null");
+        Objects.requireNonNull(moduleName, "moduleName must not be null");
+        Objects.requireNonNull(functionName, "functionName must not be null");
+        Task<T> task = new Task<>(returnType, moduleName, functionName, args != null ? args : new Object[0]);
+        if (closed) {
+            throw new RejectedExecutionException("pool has been closed");
+        }
+        queue.offer(task);
+        if (closed && queue.remove(task)) {
+            // Closed concurrently and the workers may have already stopped
+            throw new RejectedExecutionException("pool has been closed");
+        }
+        return task.future;
+    }
+
+    /**
+     * Executes the calls already submitted, stops the worker threads and destroys the sub-interpreters.
+     *
+     * @throws InterruptedException If interrupted while waiting for the worker threads.
+     */
+    @Override
+    public void close() throws InterruptedException {
+        if (!closed) {
+            closed = true;
+            for (int i = 0; i < workers.length; i++) {
+                queue.offer(STOP);
+            }
+        }
+        for (Thread worker : workers) {
+            if (worker != Thread.currentThread()) {
+                worker.join();
+            }
+        }
+        Task<?> task;
+        while ((task = queue.poll()) != null) {
+            if (task != STOP) {
+                task.future.completeExceptionally(new RejectedExecutionException("pool has been closed"));
+            }
+        }
+    }
+
+    private void runWorker(String initCode, CompletableFuture<Void> started) {
+        long threadState;
+        try {
+            threadState = PyLib.newSubInterpreter();
+        } catch (Throwable t) {
+            started.completeExceptionally(t);
+            return;
+        }
+        try {
+            if (initCode != null) {
+                try {
+                    PyLib.execInSubInterpreter(threadState, initCode);
+                } catch (Throwable t) {
+                    started.completeExceptionally(t);
+                    return;
+                }
+            }
+            started.complete(null);
+            while (true) {
+                Task<?> task;
+                try {
+                    task = queue.take();
+                } catch (InterruptedException e) {
+                    break;
+                }
+                if (task == STOP) {
+                    break;
+                }
+                task.run(threadState);
+            }
+        } finally {
+            if (PyLib.isPythonRunning()) {
+                PyLib.endSubInterpreter(threadState);
+            }
+        }
+    }
+
+    @SuppressWarnings("unchecked")
+    static <T> T convertResult(Object value, Class<T> type) {
+        if (value == null || type == Object.class || type.isInstance(value)) {
+            return (T) value;
+        }
+        if (value instanceof Number) {
+            Number number = (Number) value;
+            if (type == Integer.class || type == Integer.TYPE) {
+                return (T) Integer.valueOf(number.intValue());
+            } else if (type == Long.class || type == Long.TYPE) {
+                return (T) Long.valueOf(number.longValue());
+            } else if (type == Double.class || type == Double.TYPE) {
+                return (T) Double.valueOf(number.doubleValue());
+            } else if (type == Float.class || type == Float.TYPE) {
+                return (T) Float.valueOf(number.floatValue());
+            } else if (type == Short.class || type == Short.TYPE) {
+                return (T) Short.valueOf(number.shortValue());
+            } else if (type == Byte.class || type == Byte.TYPE) {
+                return (T) Byte.valueOf(number.byteValue());
+            }
+        } else if (value instanceof Boolean && type == Boolean.TYPE) {
+            return (T) value;
+        }
+        throw new ClassCastException("cannot convert a " + value.getClass().getName() + " into a " + type.getName());
+    }
+
+    private static final class Task<T> {
+        final Class<T> returnType;
+        final String moduleName;
+        final String functionName;
+        final Object[] args;
+        final CompletableFuture<T> future = new CompletableFuture<>();
+
+        Task(Class<T> returnType, String moduleName, String functionName, Object[] args) {
+            this.returnType = returnType;
+            this.moduleName = moduleName;
+            this.functionName = functionName;
+            this.args = args;
+        }
+
+        void run(long threadState) {
+            try {
+                Object result = PyLib.callInSubInterpreter(threadState, moduleName, functionName, args);
+                future.complete(convertResult(result, returnType));
+            } catch (Throwable t) {
+                future.completeExceptionally(t);
+            }
+        }
+    }
+}
@@ -120,6 +120,59 @@ public class PyLib {
          */
         public static final int F_ALL = 0xff;
 
+        /**
+         * Index of the number of Java method and constructor calls from Python in the array returned by {@link #getStats()}.
+         */
+        public static final int STAT_JAVA_CALLS = 0;
+        /**
+         * Index of the number of Java method overload resolutions.
+         */
+        public static final int STAT_OVERLOAD_RESOLUTIONS = 1;
+        /**
+         * Index of the number of overload resolutions that had to score more than one candidate method.
+         */
+        public static final int STAT_OVERLOAD_CACHE_MISSES = 2;
+        /**
+         * Index of the number of Java types resolved into Python types.
+         */
+        public static final int STAT_TYPES_RESOLVED = 3;
+        /**
+         * Index of the number of JNI global references created for Java objects and classes wrapped by Python objects.
+         */
+        public static final int STAT_GLOBAL_REFS_CREATED = 4;
+        /**
+         * Index of the number of JNI global references deleted.
+         */
+        public static final int STAT_GLOBAL_REFS_DELETED = 5;
+        /**
+         * Index of the number of GIL acquisitions by Java threads calling into Python.
+         */
+        public static final int STAT_GIL_ACQUISITIONS = 6;
+        /**
+         * Index of the number of Java primitive arrays exported as Python buffers.
+         */
+        public static final int STAT_BUFFER_EXPORTS = 7;
+        /**
+         * Index of the number of bytes copied between Python buffers and Java primitive arrays.
+         */
+        public static final int STAT_BUFFER_BYTES_COPIED = 8;
+        /**
+         * Index of the number of Java exceptions translated into Python errors.
+         */
+        public static final int STAT_JAVA_EXCEPTIONS = 9;
+        /**
+         * Index of the number of Python errors translated into Java exceptions.
+         */
+        public static final int STAT_PYTHON_EXCEPTIONS = 10;
+        /**
+         * Index of the number of Python buffers acquired for passing them to Java primitive array parameters.
+         */
+        public static final int STAT_BUFFER_ACQUISITIONS = 11;
+        /**
+         * Length of the array returned by {@link #getStats()}.
+         */
+        public static final int STAT_COUNT = 12;
+
         /**
          * @return the current diagnostic flags.
          */
@@ -132,6 +185,70 @@ public class PyLib {
          */
         public static native void setFlags(int flags);
 
+        /**
+         * Gets a snapshot of jpy's always-on runtime counters.
+         * The counters are the same as returned by {@code jpy.diag.stats()} in Python.
+         *
+         * @return an array of length {@link #STAT_COUNT}, indexed by the {@code STAT_*} constants.
+         */
+        public static native long[] getStats();
+
+        /**
+         * @return {@code true} if call profiling is enabled.
+         */
+        public static native boolean isProfiling();
+
+        /**
+         * Enables or disables call profiling. If enabled, latency histograms are recorded for every Java method
+         * called from Python and every Python callable called from Java, split into argument conversion,
+         * the call itself and result conversion. Same as setting {@code jpy.diag.profiling} in Python.
+         *
+         * @param enabled {@code true} to enable call profiling.
+         */
+        public static native void setProfiling(boolean enabled);
+
+        /**
+         * Clears all latency histograms recorded so far.
+         */
+        public static native void resetProfile();
+
+        /**
+         * Gets a text table describing the callables with the highest total time recorded while profiling
+         * was enabled. Latencies are given in microseconds.
+         *
+         * @param n the maximum number of callables to report, a negative value reports all of them.
+         * @return the report, one line per callable, preceded by a header line.
+         */
+        public static native String getProfileReport(int n);
+
+        /**
+         * @return {@code true} if event tracing is enabled.
+         */
+        public static native boolean isTracing();
+
+        /**
+         * Enables or disables event tracing. If enabled, every thread records Java and Python calls,
+         * overload resolutions, type resolutions and translated exceptions into its own ring buffer.
+         * Same as setting {@code jpy.diag.tracing} in Python.
+         *
+         * @param enabled {@code true} to enable event tracing.
+         */
+        public static native void setTracing(boolean enabled);
+
+        /**
+         * Discards all recorded trace events.
+         */
+        public static native void clearTrace();
+
+        /**
+         * Writes all recorded trace events into a binary file which can be decoded using the {@code jpytrace}
+         * Python module, e.g. {@code python jpytrace.py <file> --chrome <json-file>}.
+         *
+         * @param path the file path.
+         * @return the number of events written.
+         */
+        public static native long dumpTrace(String path);
+
         private Diag() {
         }
     }
@@ -289,6 +406,8 @@ public class PyLib {
 
     static native <T> T[] getObjectArrayValue(long pointer, Class<? extends T> itemType);
 
+    static native Object toJava(long pointer, Class<?> target);
+
     static native long importModule(String name);
 
     /**
@@ -395,6 +514,130 @@ public class PyLib {
                                            Class<?>[] paramTypes,
                                            Class<T> returnType);
 
+    /**
+     * Creates a handle for repeated calls of a Python callable using the {@code callHandle*} methods.
+     * The callable's name and the parameter types are converted only once. The handle keeps a reference
+     * to the Python object and must be released using {@link #releaseCallHandle(long)}.
+     *
+     * @param pointer    Identifies the Python object which contains the callable {@code name}.
+     * @param name       The name of the callable.
+     * @param paramTypes The parameter types used for the conversion of the arguments into a Python tuple.
+     * @return The call handle.
+     */
+    static native long newCallHandle(long pointer, String name, Class<?>[] paramTypes);
+
+    /**
+     * Releases a call handle created by {@link #newCallHandle(long, String, Class[])}.
+     *
+     * @param handle The call handle.
+     */
+    static native void releaseCallHandle(long handle);
+
+    /**
+     * Calls the Python callable of a call handle and ignores its return value.
+     *
+     * @param handle The call handle.
+     * @param args   The arguments, one per parameter type of the handle. May be {@code null} if there are none.
+     */
+    static native void callHandle(long handle, Object[] args);
+
+    /**
+     * Calls the Python callable of a call handle and returns its return value as {@code boolean}.
+     */
+    static native boolean callHandleAndReturnBoolean(long handle, Object[] args);
+
+    /**
+     * Calls the Python callable of a call handle and returns its return value as {@code int}.
+     */
+    static native int callHandleAndReturnInt(long handle, Object[] args);
+
+    /**
+     * Calls the Python callable of a call handle and returns its return value as {@code long}.
+     */
+    static native long callHandleAndReturnLong(long handle, Object[] args);
+
+    /**
+     * Calls the Python callable of a call handle and returns its return value as {@code double}.
+     */
+    static native double callHandleAndReturnDouble(long handle, Object[] args);
+
+    /**
+     * Calls the Python callable of a call handle and returns its return value converted into the given type.
+     */
+    static native <T> T callHandleAndReturnValue(long handle, Object[] args, Class<T> returnType);
+
+    /**
+     * Creates a Python thread state for the calling thread, which is kept until {@link #detachThread(long)} is called.
+     * Used by threads which repeatedly acquire the GIL (see {@link PyExecutor}), so that the thread state isn't
+     * created and deleted on every acquisition. The GIL is not held when this method returns.
+     *
+     * @return The Python thread state.
+     */
+    static native long attachThread();
+
+    /**
+     * Deletes the Python thread state created by {@link #attachThread()}. Must be called by the same thread,
+     * while not holding the GIL.
+     *
+     * @param threadState The Python thread state.
+     */
+    static native void detachThread(long threadState);
+
+    /**
+     * Acquires the GIL for the Python thread state created by {@link #attachThread()}.
+     * While the calling thread holds the GIL, other {@code PyLib} functions called by it don't need to acquire it.
+     *
+     * @param threadState The Python thread state.
+     */
+    static native void acquireGIL(long threadState);
+
+    /**
+     * Releases the GIL acquired by {@link #acquireGIL(long)}.
+     *
+     * @param threadState The Python thread state.
+     */
+    static native void releaseGIL(long threadState);
+
+    /**
+     * Creates a new Python sub-interpreter with its own GIL. Requires Python 3.12 or higher.
+     * The sub-interpreter's {@code sys.path} is a copy of the main interpreter's one.
+     * Extension modules not supporting multiple interpreters, including {@code jpy} itself, cannot be imported into it.
+     * <p>
+     * The returned thread state belongs to the calling thread, which must be the only one using it.
+     *
+     * @return The sub-interpreter's Python thread state.
+     */
+    static native long newSubInterpreter();
+
+    /**
+     * Destroys a sub-interpreter created by {@link #newSubInterpreter()}.
+     *
+     * @param threadState The sub-interpreter's Python thread state.
+     */
+    static native void endSubInterpreter(long threadState);
+
+    /**
+     * Executes Python statements in the {@code __main__} module of a sub-interpreter.
+     *
+     * @param threadState The sub-interpreter's Python thread state.
+     * @param code        The Python statements.
+     */
+    static native void execInSubInterpreter(long threadState, String code);
+
+    /**
+     * Calls a function of a module of a sub-interpreter. The module is imported if not done already.
+     * Only plain values are passed: {@code null}, {@code Boolean}, {@code Number}, {@code Character},
+     * {@code String} and {@code Object[]} arguments, and {@code None}, {@code bool}, {@code int} (as {@code Long}),
+     * {@code float} (as {@code Double}), {@code str}, {@code list} and {@code tuple} (as {@code Object[]}) results.
+     *
+     * @param threadState  The sub-interpreter's Python thread state.
+     * @param moduleName   The module name.
+     * @param functionName The function name.
+     * @param args         The arguments.
+     * @return The function's result.
+     */
+    static native Object callInSubInterpreter(long threadState, String moduleName, String functionName, Object[] args);
+
     private static void loadLib() {
         if (dllLoaded || dllProblem != null) {
             return;
@@ -267,6 +267,33 @@ public class PyObject {
         return PyLib.getObjectArrayValue(getPointer(), itemType);
     }
 
+    /**
+     * Converts this Python object into a Java object of the given type, including all Python containers nested in it.
+     * Unlike {@link #asDict()} or {@link #asList()}, which return views calling into Python on every access,
+     * the whole structure is converted at once while holding the GIL:
+     * <ul>
+     * <li>{@code dict} into {@code HashMap}, {@code list} into {@code ArrayList}, {@code tuple} into {@code Object[]},
+     * {@code set} and {@code frozenset} into {@code HashSet};</li>
+     * <li>{@code str}, {@code bool}, {@code int} and {@code float} into {@code String} and boxed values;</li>
+     * <li>wrapped Java objects into themselves, and all other Python objects into {@link PyObject}s.</li>
+     * </ul>
+     * If {@code target} is an array type, a {@code list} or {@code tuple} becomes an array of it. If it is
+     * neither {@code Object} nor an array type, a {@code tuple} becomes an {@code ArrayList}.
+     *
+     * @param target The expected type of the result, e.g. {@code Map.class} or {@code String[].class}.
+     * @param <T> The expected type of the result.
+     * @return This Python object as a Java object of the given type.
+     * @throws ClassCastException If the converted object is not an instance of {@code target}.
+     */
+    @SuppressWarnings("unchecked")
+    public <T> T toJava(Class<T> target) {
+        assertPythonRuns();
+        Objects.requireNonNull(target, "target must not be null");
+        Object value = PyLib.toJava(getPointer(), target);
+        // Primitive targets result in boxed values, which Class.cast() would reject
+        return target.isPrimitive() ? (T) value : target.cast(value);
+    }
+
     /**
      * Gets the Python value of a Python attribute.
      * <p>
@@ -410,6 +437,10 @@ public class PyObject {
     /**
      * Create a Java proxy instance of this Python object (or module) which contains compatible methods
      * (or functions) to the ones provided in the interfaces given by all the {@code type} parameters.
+     * <p>
+     * If possible, the proxy is an instance of a class generated for the given interfaces, which calls the
+     * Python object without reflection (see {@link PyProxyGenerator}). Otherwise, e.g. for non-public interfaces,
+     * a {@code java.lang.reflect.Proxy} is created.
      *
      * @param callableKind The kind of calls to be made.
      * @param types        The interface types.
@@ -417,6 +448,10 @@ public class PyObject {
      */
     public Object createProxy(PyLib.CallableKind callableKind, Class<?>... types) {
         assertPythonRuns();
+        Object proxy = PyProxyGenerator.newProxyInstance(this, callableKind, types);
+        if (proxy != null) {
+            return proxy;
+        }
         ClassLoader classLoader = types[0].getClassLoader();
         InvocationHandler invocationHandler = new PyProxyHandler(this, callableKind);
         return Proxy.newProxyInstance(classLoader, types, invocationHandler);
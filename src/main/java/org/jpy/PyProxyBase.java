@@ -0,0 +1,165 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy;
+
+import java.lang.reflect.Method;
+import java.util.concurrent.atomic.AtomicLongArray;
+
+import static org.jpy.PyLib.assertPythonRuns;
+
+/**
+ * The base class of the proxy classes generated by {@link PyProxyGenerator}.
+ * <p>
+ * Every generated interface method boxes its arguments and delegates to one of the typed {@code call} methods
+ * of this class, passing the index of the interface method. The Python callable of each interface method is
+ * called through a native call handle, which is created on first use and keeps the method name and the parameter
+ * types in their already converted, native form.
+ * <p>
+ * This class is only public because the generated classes are defined by their own class loader.
+ * It is not meant to be used by clients.
+ *
+ * @author Norman Fomferra
+ * @since 0.10
+ */
+public abstract class PyProxyBase {
+
+    private final PyObject pyObject;
+
+    private final PyLib.CallableKind callableKind;
+
+    private final Method[] methods;
+
+    private final AtomicLongArray callHandles;
+
+    /**
+     * @param pyObject     The Python object which implements the interface methods.
+     * @param callableKind The kind of calls to be made.
+     * @param methods      The interface methods. The generated classes refer to them by index.
+     */
+    protected PyProxyBase(PyObject pyObject, PyLib.CallableKind callableKind, Method[] methods) {
+        if (pyObject == null) {
+            throw new NullPointerException("pyObject");
+        }
+        this.pyObject = pyObject;
+        this.callableKind = callableKind;
+        this.methods = methods;
+        this.callHandles = new AtomicLongArray(methods.length);
+    }
+
+    protected final void callVoid(int methodIndex, Object[] args) {
+        assertPythonRuns();
+        PyLib.callHandle(getCallHandle(methodIndex), args);
+    }
+
+    protected final boolean callBoolean(int methodIndex, Object[] args) {
+        assertPythonRuns();
+        return PyLib.callHandleAndReturnBoolean(getCallHandle(methodIndex), args);
+    }
+
+    protected final int callInt(int methodIndex, Object[] args) {
+        assertPythonRuns();
+        return PyLib.callHandleAndReturnInt(getCallHandle(methodIndex), args);
+    }
+
+    protected final long callLong(int methodIndex, Object[] args) {
+        assertPythonRuns();
+        return PyLib.callHandleAndReturnLong(getCallHandle(methodIndex), args);
+    }
+
+    protected final double callDouble(int methodIndex, Object[] args) {
+        assertPythonRuns();
+        return PyLib.callHandleAndReturnDouble(getCallHandle(methodIndex), args);
+    }
+
+    protected final Object callObject(int methodIndex, Object[] args) {
+        assertPythonRuns();
+        return PyLib.callHandleAndReturnValue(getCallHandle(methodIndex), args, methods[methodIndex].getReturnType());
+    }
+
+    /**
+     * Calls the Python {@code __hash__} function, see {@link PyProxyHandler}.
+     */
+    @Override
+    public int hashCode() {
+        assertPythonRuns();
+        long pythonHash = PyLib.callAndReturnValue(this.pyObject.getPointer(), true, "__hash__", 0, null,
+                new Class<?>[0], Long.class);
+        return (int) pythonHash;
+    }
+
+    /**
+     * Calls the Python {@code __eq__} method if the other object is a proxy of the same class and if
+     * {@code __eq__} is implemented by the Python object, see {@link PyProxyHandler}.
+     */
+    @Override
+    public boolean equals(Object other) {
+        assertPythonRuns();
+        if (other == null || other.getClass() != getClass()) {
+            return false;
+        }
+        PyObject otherPyObject = ((PyProxyBase) other).pyObject;
+        if (this.pyObject == otherPyObject) {
+            return true;
+        }
+        if (!this.pyObject.hasAttribute("__eq__") || !this.pyObject.getAttribute("__eq__").hasAttribute("__func__")) {
+            return false;
+        }
+        Boolean result = PyLib.callAndReturnValue(this.pyObject.getPointer(), callableKind == PyLib.CallableKind.METHOD,
+                "__eq__", 1, new Object[]{otherPyObject}, new Class<?>[]{Object.class}, Boolean.class);
+        return result != null && result;
+    }
+
+    /**
+     * Calls the Python {@code __str__} method.
+     */
+    @Override
+    public String toString() {
+        assertPythonRuns();
+        return PyLib.callAndReturnValue(this.pyObject.getPointer(), callableKind == PyLib.CallableKind.METHOD,
+                "__str__", 0, null, new Class<?>[0], String.class);
+    }
+
+    /**
+     * Releases the native call handles.
+     *
+     * @throws Throwable If any error occurs.
+     */
+    @Override
+    protected void finalize() throws Throwable {
+        super.finalize();
+        for (int i = 0; i < callHandles.length(); i++) {
+            long callHandle = callHandles.get(i);
+            if (callHandle != 0) {
+                PyLib.releaseCallHandle(callHandle);
+            }
+        }
+    }
+
+    private long getCallHandle(int methodIndex) {
+        long callHandle = callHandles.get(methodIndex);
+        if (callHandle == 0) {
+            Method method = methods[methodIndex];
+            callHandle = PyLib.newCallHandle(pyObject.getPointer(), method.getName(), method.getParameterTypes());
+            if (!callHandles.compareAndSet(methodIndex, 0, callHandle)) {
+                // Another thread was faster
+                PyLib.releaseCallHandle(callHandle);
+                callHandle = callHandles.get(methodIndex);
+            }
+        }
+        return callHandle;
+    }
+}
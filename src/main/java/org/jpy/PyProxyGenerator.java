@@ -0,0 +1,636 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy;
+
+import java.io.ByteArrayOutputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.lang.reflect.Constructor;
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Generates the proxy classes used by {@link PyObject#createProxy(PyLib.CallableKind, Class[])}.
+ * <p>
+ * For every distinct set of interfaces a class extending {@link PyProxyBase} is generated, in which every
+ * interface method directly calls the typed {@code call} method of {@code PyProxyBase} matching its return type.
+ * Compared to a {@code java.lang.reflect.Proxy} with {@link PyProxyHandler}, this saves the reflective dispatch,
+ * the {@code Method} comparisons and the parameter type arrays on every call, and primitive return values
+ * are not boxed.
+ * <p>
+ * The class files are written directly, as the Java 8 runtime has neither a class file API nor hidden classes.
+ * The generated code has no branches, so no stack map frames are required.
+ * Interfaces which cannot be implemented by a class of another class loader (e.g. non-public interfaces, or
+ * methods with non-public parameter or return types) are not supported, in which case {@link #newProxyInstance} returns {@code null} and a
+ * {@code java.lang.reflect.Proxy} has to be used instead.
+ *
+ * @author Norman Fomferra
+ * @since 0.10
+ */
+class PyProxyGenerator {
+
+    private static final String BASE_CLASS_NAME = "org/jpy/PyProxyBase";
+    private static final String CONSTRUCTOR_DESCRIPTOR = "(Lorg/jpy/PyObject;Lorg/jpy/PyLib$CallableKind;[Ljava/lang/reflect/Method;)V";
+    private static final String CLASS_NAME_PREFIX = "org/jpy/proxy/PyProxy$";
+
+    private static final int ACC_SUPER = 0x0020;
+
+    private static final int ACONST_NULL = 0x01;
+    private static final int ICONST_0 = 0x03;
+    private static final int BIPUSH = 0x10;
+    private static final int SIPUSH = 0x11;
+    private static final int LDC_W = 0x13;
+    private static final int ILOAD = 0x15;
+    private static final int LLOAD = 0x16;
+    private static final int FLOAD = 0x17;
+    private static final int DLOAD = 0x18;
+    private static final int ALOAD = 0x19;
+    private static final int ALOAD_0 = 0x2a;
+    private static final int ALOAD_1 = 0x2b;
+    private static final int ALOAD_2 = 0x2c;
+    private static final int ALOAD_3 = 0x2d;
+    private static final int AASTORE = 0x53;
+    private static final int DUP = 0x59;
+    private static final int D2F = 0x90;
+    private static final int I2B = 0x91;
+    private static final int I2C = 0x92;
+    private static final int I2S = 0x93;
+    private static final int IRETURN = 0xac;
+    private static final int LRETURN = 0xad;
+    private static final int FRETURN = 0xae;
+    private static final int DRETURN = 0xaf;
+    private static final int ARETURN = 0xb0;
+    private static final int RETURN = 0xb1;
+    private static final int INVOKEVIRTUAL = 0xb6;
+    private static final int INVOKESPECIAL = 0xb7;
+    private static final int INVOKESTATIC = 0xb8;
+    private static final int ANEWARRAY = 0xbd;
+    private static final int CHECKCAST = 0xc0;
+
+    private static final ProxyClass UNSUPPORTED = new ProxyClass(null, null);
+    private static final AtomicInteger classCounter = new AtomicInteger();
+    private static final Set<String> reservedMethods = new HashSet<>();
+
+    static {
+        for (Method method : PyProxyBase.class.getDeclaredMethods()) {
+            reservedMethods.add(method.getName() + getParameterDescriptor(method));
+        }
+        for (Method method : Object.class.getDeclaredMethods()) {
+            reservedMethods.add(method.getName() + getParameterDescriptor(method));
+        }
+    }
+
+    // Generated classes for the interface sets starting with a given interface
+    private static final ClassValue<ConcurrentHashMap<List<Class<?>>, ProxyClass>> proxyClasses = new ClassValue<ConcurrentHashMap<List<Class<?>>, ProxyClass>>() {
+        @Override
+        protected ConcurrentHashMap<List<Class<?>>, ProxyClass> computeValue(Class<?> type) {
+            return new ConcurrentHashMap<>();
+        }
+    };
+
+    /**
+     * Creates a proxy instance of a generated class implementing the given interfaces.
+     *
+     * @param pyObject     The Python object which implements the interface methods.
+     * @param callableKind The kind of calls to be made.
+     * @param types        The interface types.
+     * @return The proxy instance, or {@code null} if no class can be generated for the given interfaces.
+     */
+    static Object newProxyInstance(PyObject pyObject, PyLib.CallableKind callableKind, Class<?>... types) {
+        ConcurrentHashMap<List<Class<?>>, ProxyClass> classMap = proxyClasses.get(types[0]);
+        List<Class<?>> key = Arrays.asList(types.clone());
+        ProxyClass proxyClass = classMap.get(key);
+        if (proxyClass == null) {
+            proxyClass = generateProxyClass(types);
+            ProxyClass otherProxyClass = classMap.putIfAbsent(key, proxyClass);
+            if (otherProxyClass != null) {
+                proxyClass = otherProxyClass;
+            }
+        }
+        if (proxyClass == UNSUPPORTED) {
+            return null;
+        }
+        try {
+            return proxyClass.constructor.newInstance(pyObject, callableKind, proxyClass.methods);
+        } catch (InvocationTargetException e) {
+            Throwable cause = e.getCause();
+            if (cause instanceof RuntimeException) {
+                throw (RuntimeException) cause;
+            }
+            throw new IllegalStateException(cause);
+        } catch (InstantiationException | IllegalAccessException e) {
+            throw new IllegalStateException(e);
+        }
+    }
+
+    private static ProxyClass generateProxyClass(Class<?>[] types) {
+        ClassLoader parent = types[0].getClassLoader();
+        Method[] methods = getInterfaceMethods(types, parent);
+        if (methods == null) {
+            return UNSUPPORTED;
+        }
+        String className = CLASS_NAME_PREFIX + classCounter.incrementAndGet();
+        byte[] classFile;
+        try {
+            classFile = writeClassFile(className, types, methods);
+        } catch (IOException e) {
+            throw new IllegalStateException(e);
+        }
+        ProxyClassLoader classLoader = new ProxyClassLoader(parent);
+        Class<?> generatedClass = classLoader.defineProxyClass(className.replace('/', '.'), classFile);
+        try {
+            Constructor<?> constructor = generatedClass.getConstructor(PyObject.class, PyLib.CallableKind.class, Method[].class);
+            return new ProxyClass(constructor, methods);
+        } catch (NoSuchMethodException e) {
+            throw new IllegalStateException(e);
+        }
+    }
+
+    /**
+     * @return The methods to be implemented, or {@code null} if they can't be implemented by a generated class.
+     */
+    private static Method[] getInterfaceMethods(Class<?>[] types, ClassLoader classLoader) {
+        Map<String, Method> methods = new LinkedHashMap<>();
+        for (Class<?> type : types) {
+            if (!type.isInterface() || !Modifier.isPublic(type.getModifiers()) || !isVisible(type, classLoader)) {
+                return null;
+            }
+            for (Method method : type.getMethods()) {
+                if (Modifier.isStatic(method.getModifiers())) {
+                    continue;
+                }
+                String key = method.getName() + getParameterDescriptor(method);
+                if (reservedMethods.contains(key)) {
+                    if (isObjectMethod(method)) {
+                        // Re-declared hashCode(), equals() and toString() are implemented by PyProxyBase
+                        continue;
+                    }
+                    return null;
+                }
+                Method otherMethod = methods.get(key);
+                if (otherMethod == null) {
+                    methods.put(key, method);
+                } else if (otherMethod.getReturnType() != method.getReturnType()) {
+                    // Covariant return types would require bridge methods
+                    return null;
+                }
+            }
+        }
+        for (Method method : methods.values()) {
+            if (getSlotCount(method.getParameterTypes()) >= 255) {
+                return null;
+            }
+            // The generated class must be able to access the signature types, e.g. for casting return values
+            if (!isAccessible(method.getReturnType(), classLoader)) {
+                return null;
+            }
+            for (Class<?> parameterType : method.getParameterTypes()) {
+                if (!isAccessible(parameterType, classLoader)) {
+                    return null;
+                }
+            }
+        }
+        return methods.values().toArray(new Method[0]);
+    }
+
+    private static boolean isObjectMethod(Method method) {
+        try {
+            Method objectMethod = Object.class.getMethod(method.getName(), method.getParameterTypes());
+            return objectMethod.getReturnType() == method.getReturnType();
+        } catch (NoSuchMethodException e) {
+            return false;
+        }
+    }
+
+    private static boolean isAccessible(Class<?> type, ClassLoader classLoader) {
+        while (type.isArray()) {
+            type = type.getComponentType();
+        }
+        return type.isPrimitive() || (Modifier.isPublic(type.getModifiers()) && isVisible(type, classLoader));
+    }
+
+    private static boolean isVisible(Class<?> type, ClassLoader classLoader) {
+        try {
+            return Class.forName(type.getName(), false, classLoader) == type;
+        } catch (ClassNotFoundException e) {
+            return false;
+        }
+    }
+
+    private static byte[] writeClassFile(String className, Class<?>[] types, Method[] methods) throws IOException {
+        ConstantPool pool = new ConstantPool();
+        int thisClass = pool.classRef(className);
+        int superClass = pool.classRef(BASE_CLASS_NAME);
+        int[] interfaces = new int[types.length];
+        for (int i = 0; i < types.length; i++) {
+            interfaces[i] = pool.classRef(getInternalName(types[i]));
+        }
+        int codeAttribute = pool.utf8("Code");
+
+        List<byte[]> methodInfos = new ArrayList<>();
+        methodInfos.add(writeConstructor(pool, codeAttribute));
+        for (int i = 0; i < methods.length; i++) {
+            methodInfos.add(writeMethod(pool, codeAttribute, className, i, methods[i]));
+        }
+
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        DataOutputStream out = new DataOutputStream(bytes);
+        out.writeInt(0xCAFEBABE);
+        out.writeShort(0);
+        out.writeShort(52);
+        pool.write(out);
+        out.writeShort(Modifier.PUBLIC | Modifier.FINAL | ACC_SUPER);
+        out.writeShort(thisClass);
+        out.writeShort(superClass);
+        out.writeShort(interfaces.length);
+        for (int anInterface : interfaces) {
+            out.writeShort(anInterface);
+        }
+        out.writeShort(0); // fields
+        out.writeShort(methodInfos.size());
+        for (byte[] methodInfo : methodInfos) {
+            out.write(methodInfo);
+        }
+        out.writeShort(0); // attributes
+        out.flush();
+        return bytes.toByteArray();
+    }
+
+    private static byte[] writeConstructor(ConstantPool pool, int codeAttribute) throws IOException {
+        Code code = new Code();
+        code.op(ALOAD_0);
+        code.op(ALOAD_1);
+        code.op(ALOAD_2);
+        code.op(ALOAD_3);
+        code.op(INVOKESPECIAL).u2(pool.methodRef(BASE_CLASS_NAME, "<init>", CONSTRUCTOR_DESCRIPTOR));
+        code.op(RETURN);
+        return writeMethodInfo(pool, codeAttribute, "<init>", CONSTRUCTOR_DESCRIPTOR, code, 4, 4);
+    }
+
+    /**
+     * Writes {@code return (R) call<R>(methodIndex, new Object[]{p1, p2, ...});}
+     */
+    private static byte[] writeMethod(ConstantPool pool, int codeAttribute, String className, int methodIndex, Method method) throws IOException {
+        Class<?>[] paramTypes = method.getParameterTypes();
+        Class<?> returnType = method.getReturnType();
+
+        Code code = new Code();
+        code.op(ALOAD_0);
+        code.pushInt(pool, methodIndex);
+        if (paramTypes.length == 0) {
+            code.op(ACONST_NULL);
+        } else {
+            code.pushInt(pool, paramTypes.length);
+            code.op(ANEWARRAY).u2(pool.classRef("java/lang/Object"));
+            int slot = 1;
+            for (int i = 0; i < paramTypes.length; i++) {
+                Class<?> paramType = paramTypes[i];
+                code.op(DUP);
+                code.pushInt(pool, i);
+                code.op(getLoadOpcode(paramType)).u1(slot);
+                if (paramType.isPrimitive()) {
+                    String boxName = getInternalName(getBoxType(paramType));
+                    code.op(INVOKESTATIC).u2(pool.methodRef(boxName, "valueOf", "(" + getDescriptor(paramType) + ")L" + boxName + ";"));
+                }
+                code.op(AASTORE);
+                slot += getSlotCount(paramType);
+            }
+        }
+
+        String callName;
+        String callReturnDescriptor;
+        if (returnType == Void.TYPE) {
+            callName = "callVoid";
+            callReturnDescriptor = "V";
+        } else if (returnType == Boolean.TYPE) {
+            callName = "callBoolean";
+            callReturnDescriptor = "Z";
+        } else if (returnType == Long.TYPE) {
+            callName = "callLong";
+            callReturnDescriptor = "J";
+        } else if (returnType == Float.TYPE || returnType == Double.TYPE) {
+            callName = "callDouble";
+            callReturnDescriptor = "D";
+        } else if (returnType.isPrimitive()) {
+            callName = "callInt";
+            callReturnDescriptor = "I";
+        } else {
+            callName = "callObject";
+            callReturnDescriptor = "Ljava/lang/Object;";
+        }
+        code.op(INVOKEVIRTUAL).u2(pool.methodRef(className, callName, "(I[Ljava/lang/Object;)" + callReturnDescriptor));
+
+        if (returnType == Void.TYPE) {
+            code.op(RETURN);
+        } else if (returnType == Byte.TYPE) {
+            code.op(I2B).op(IRETURN);
+        } else if (returnType == Character.TYPE) {
+            code.op(I2C).op(IRETURN);
+        } else if (returnType == Short.TYPE) {
+            code.op(I2S).op(IRETURN);
+        } else if (returnType == Boolean.TYPE || returnType == Integer.TYPE) {
+            code.op(IRETURN);
+        } else if (returnType == Long.TYPE) {
+            code.op(LRETURN);
+        } else if (returnType == Float.TYPE) {
+            code.op(D2F).op(FRETURN);
+        } else if (returnType == Double.TYPE) {
+            code.op(DRETURN);
+        } else {
+            if (returnType != Object.class) {
+                code.op(CHECKCAST).u2(pool.classRef(getInternalName(returnType)));
+            }
+            code.op(ARETURN);
+        }
+
+        // this + method index + array + array + array index + value (max. 2 slots)
+        int maxStack = 7;
+        int maxLocals = 1 + getSlotCount(paramTypes);
+        return writeMethodInfo(pool, codeAttribute, method.getName(), getMethodDescriptor(method), code, maxStack, maxLocals);
+    }
+
+    private static byte[] writeMethodInfo(ConstantPool pool, int codeAttribute, String name, String descriptor, Code code, int maxStack, int maxLocals) throws IOException {
+        ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        DataOutputStream out = new DataOutputStream(bytes);
+        byte[] codeBytes = code.toByteArray();
+        out.writeShort(Modifier.PUBLIC);
+        out.writeShort(pool.utf8(name));
+        out.writeShort(pool.utf8(descriptor));
+        out.writeShort(1); // attributes
+        out.writeShort(codeAttribute);
+        out.writeInt(12 + codeBytes.length);
+        out.writeShort(maxStack);
+        out.writeShort(maxLocals);
+        out.writeInt(codeBytes.length);
+        out.write(codeBytes);
+        out.writeShort(0); // exception table
+        out.writeShort(0); // attributes
+        out.flush();
+        return bytes.toByteArray();
+    }
+
+    private static int getLoadOpcode(Class<?> type) {
+        if (type == Long.TYPE) {
+            return LLOAD;
+        } else if (type == Float.TYPE) {
+            return FLOAD;
+        } else if (type == Double.TYPE) {
+            return DLOAD;
+        } else if (type.isPrimitive()) {
+            return ILOAD;
+        } else {
+            return ALOAD;
+        }
+    }
+
+    private static Class<?> getBoxType(Class<?> type) {
+        if (type == Boolean.TYPE) {
+            return Boolean.class;
+        } else if (type == Character.TYPE) {
+            return Character.class;
+        } else if (type == Byte.TYPE) {
+            return Byte.class;
+        } else if (type == Short.TYPE) {
+            return Short.class;
+        } else if (type == Integer.TYPE) {
+            return Integer.class;
+        } else if (type == Long.TYPE) {
+            return Long.class;
+        } else if (type == Float.TYPE) {
+            return Float.class;
+        } else {
+            return Double.class;
+        }
+    }
+
+    private static int getSlotCount(Class<?> type) {
+        return type == Long.TYPE || type == Double.TYPE ? 2 : 1;
+    }
+
+    private static int getSlotCount(Class<?>[] types) {
+        int slotCount = 0;
+        for (Class<?> type : types) {
+            slotCount += getSlotCount(type);
+        }
+        return slotCount;
+    }
+
+    private static String getInternalName(Class<?> type) {
+        // Array class names are already in descriptor form, e.g. "[Ljava.lang.String;"
+        return type.getName().replace('.', '/');
+    }
+
+    private static String getParameterDescriptor(Method method) {
+        StringBuilder sb = new StringBuilder("(");
+        for (Class<?> paramType : method.getParameterTypes()) {
+            sb.append(getDescriptor(paramType));
+        }
+        return sb.append(')').toString();
+    }
+
+    private static String getMethodDescriptor(Method method) {
+        return getParameterDescriptor(method) + getDescriptor(method.getReturnType());
+    }
+
+    private static String getDescriptor(Class<?> type) {
+        if (type.isArray()) {
+            return getInternalName(type);
+        } else if (!type.isPrimitive()) {
+            return "L" + getInternalName(type) + ";";
+        } else if (type == Void.TYPE) {
+            return "V";
+        } else if (type == Boolean.TYPE) {
+            return "Z";
+        } else if (type == Character.TYPE) {
+            return "C";
+        } else if (type == Byte.TYPE) {
+            return "B";
+        } else if (type == Short.TYPE) {
+            return "S";
+        } else if (type == Integer.TYPE) {
+            return "I";
+        } else if (type == Long.TYPE) {
+            return "J";
+        } else if (type == Float.TYPE) {
+            return "F";
+        } else {
+            return "D";
+        }
+    }
+
+    private static final class ProxyClass {
+        final Constructor<?> constructor;
+        final Method[] methods;
+
+        ProxyClass(Constructor<?> constructor, Method[] methods) {
+            this.constructor = constructor;
+            this.methods = methods;
+        }
+    }
+
+    /**
+     * Defines a single generated class. Its parent is the class loader of the (first) interface,
+     * the jpy classes referred to by the generated code are always taken from jpy's own class loader.
+     */
+    private static final class ProxyClassLoader extends ClassLoader {
+
+        ProxyClassLoader(ClassLoader parent) {
+            super(parent);
+        }
+
+        Class<?> defineProxyClass(String name, byte[] classFile) {
+            return defineClass(name, classFile, 0, classFile.length, PyProxyGenerator.class.getProtectionDomain());
+        }
+
+        @Override
+        protected Class<?> loadClass(String name, boolean resolve) throws ClassNotFoundException {
+            if (name.equals(PyProxyBase.class.getName())) {
+                return PyProxyBase.class;
+            } else if (name.equals(PyObject.class.getName())) {
+                return PyObject.class;
+            } else if (name.equals(PyLib.CallableKind.class.getName())) {
+                return PyLib.CallableKind.class;
+            }
+            return super.loadClass(name, resolve);
+        }
+    }
+
+    private static final class ConstantPool {
+        private final Map<String, Integer> indexes = new HashMap<>();
+        private final ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+        private final DataOutputStream out = new DataOutputStream(bytes);
+        private int count = 1;
+
+        int utf8(String value) throws IOException {
+            Integer index = indexes.get("U" + value);
+            if (index == null) {
+                out.writeByte(1);
+                out.writeUTF(value);
+                index = add("U" + value);
+            }
+            return index;
+        }
+
+        int integer(int value) throws IOException {
+            Integer index = indexes.get("I" + value);
+            if (index == null) {
+                out.writeByte(3);
+                out.writeInt(value);
+                index = add("I" + value);
+            }
+            return index;
+        }
+
+        int classRef(String internalName) throws IOException {
+            Integer index = indexes.get("C" + internalName);
+            if (index == null) {
+                int nameIndex = utf8(internalName);
+                out.writeByte(7);
+                out.writeShort(nameIndex);
+                index = add("C" + internalName);
+            }
+            return index;
+        }
+
+        int methodRef(String owner, String name, String descriptor) throws IOException {
+            String key = "M" + owner + "." + name + descriptor;
+            Integer index = indexes.get(key);
+            if (index == null) {
+                int classIndex = classRef(owner);
+                int nameAndTypeIndex = nameAndType(name, descriptor);
+                out.writeByte(10);
+                out.writeShort(classIndex);
+                out.writeShort(nameAndTypeIndex);
+                index = add(key);
+            }
+            return index;
+        }
+
+        private int nameAndType(String name, String descriptor) throws IOException {
+            String key = "N" + name + ":" + descriptor;
+            Integer index = indexes.get(key);
+            if (index == null) {
+                int nameIndex = utf8(name);
+                int descriptorIndex = utf8(descriptor);
+                out.writeByte(12);
+                out.writeShort(nameIndex);
+                out.writeShort(descriptorIndex);
+                index = add(key);
+            }
+            return index;
+        }
+
+        private int add(String key) {
+            int index = count++;
+            indexes.put(key, index);
+            return index;
+        }
+
+        void write(DataOutputStream classOut) throws IOException {
+            out.flush();
+            classOut.writeShort(count);
+            bytes.writeTo(classOut);
+        }
+    }
+
+    private static final class Code {
+        private final ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+
+        Code op(int opcode) {
+            bytes.write(opcode);
+            return this;
+        }
+
+        Code u1(int value) {
+            bytes.write(value);
+            return this;
+        }
+
+        Code u2(int value) {
+            bytes.write(value >>> 8);
+            bytes.write(value);
+            return this;
+        }
+
+        void pushInt(ConstantPool pool, int value) throws IOException {
+            if (value <= 5) {
+                op(ICONST_0 + value);
+            } else if (value <= Byte.MAX_VALUE) {
+                op(BIPUSH).u1(value);
+            } else if (value <= Short.MAX_VALUE) {
+                op(SIPUSH).u2(value);
+            } else {
+                op(LDC_W).u2(pool.integer(value));
+            }
+        }
+
+        byte[] toByteArray() {
+            return bytes.toByteArray();
+        }
+    }
+}
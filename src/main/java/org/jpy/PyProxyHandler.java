@@ -20,6 +20,7 @@ import java.lang.reflect.InvocationHandler;
 import java.lang.reflect.Proxy;
 import java.lang.reflect.Method;
 import java.util.Arrays;
+import java.util.concurrent.ConcurrentHashMap;
 
 import static org.jpy.PyLib.assertPythonRuns;
 
@@ -51,6 +52,9 @@ class PyProxyHandler implements InvocationHandler {
     private final PyObject pyObject;
     
     private final PyLib.CallableKind callableKind;
+
+    // The call handles and return types of the methods called so far
+    private final ConcurrentHashMap<Method, ProxyMethod> proxyMethods = new ConcurrentHashMap<>();
     
     public PyProxyHandler(PyObject pyObject, PyLib.CallableKind callableKind) {
         if (pyObject == null) {
@@ -68,11 +72,13 @@ class PyProxyHandler implements InvocationHandler {
             System.out.printf("org.jpy.PyProxyHandler: invoke: %s(%s) on pyObject=%s in thread %s\n", method.getName(),
                     Arrays.toString(args), Long.toHexString(this.pyObject.getPointer()), Thread.currentThread());
         }
-        String methodName = method.getName();
-        Class<?> returnType = method.getReturnType();
-        if (method.equals(hashCodeMethod)) {
-            return callPythonHash();
-        } else if (method.equals(equalsMethod)) {
+        ProxyMethod proxyMethod = proxyMethods.get(method);
+        if (proxyMethod == null) {
+            proxyMethod = createProxyMethod(method);
+        }
+        if (proxyMethod.kind == ProxyMethod.HASH_CODE) {
+            return callPythonHash(proxyMethod);
+        } else if (proxyMethod.kind == ProxyMethod.EQUALS) {
             if (isProxyEqualsEligible(proxyObject, args[0])) {
                 PyObject otherPyObject = proxyGetOtherPyObject(proxyObject, args[0]);
                 if (this.pyObject == otherPyObject) {
@@ -96,13 +102,51 @@ class PyProxyHandler implements InvocationHandler {
             // It's proxy eligible, but not same object, and __eq__ was
             // implemented
             // so defer to the Python __eq__
+        }
+        
+        return PyLib.callHandleAndReturnValue(proxyMethod.callHandle, args, proxyMethod.returnType);
+    }
+
+    /**
+     * Releases the native call handles.
+     *
+     * @throws Throwable If any error occurs.
+     */
+    @Override
+    protected void finalize() throws Throwable {
+        super.finalize();
+        for (ProxyMethod proxyMethod : proxyMethods.values()) {
+            PyLib.releaseCallHandle(proxyMethod.callHandle);
+        }
+    }
+
+    /**
+     * Creates the call handle of a method on its first call. The Python callable is resolved by the handle,
+     * and it is resolved again only if it has been rebound in Python.
+     */
+    private ProxyMethod createProxyMethod(Method method) {
+        String methodName = method.getName();
+        Class<?> returnType = method.getReturnType();
+        int kind = ProxyMethod.OTHER;
+        if (method.equals(hashCodeMethod)) {
+            methodName = "__hash__";
+            returnType = Long.class;
+            kind = ProxyMethod.HASH_CODE;
+        } else if (method.equals(equalsMethod)) {
             methodName = "__eq__";
+            kind = ProxyMethod.EQUALS;
         } else if (method.equals(toStringMethod)) {
             methodName = "__str__";
         }
-        
-        return PyLib.callAndReturnValue(this.pyObject.getPointer(), callableKind == PyLib.CallableKind.METHOD,
-                methodName, args != null ? args.length : 0, args, method.getParameterTypes(), returnType);
+        long callHandle = PyLib.newCallHandle(this.pyObject.getPointer(), methodName, method.getParameterTypes());
+        ProxyMethod proxyMethod = new ProxyMethod(kind, returnType, callHandle);
+        ProxyMethod otherProxyMethod = proxyMethods.putIfAbsent(method, proxyMethod);
+        if (otherProxyMethod != null) {
+            // Another thread was faster
+            PyLib.releaseCallHandle(callHandle);
+            return otherProxyMethod;
+        }
+        return proxyMethod;
     }
     
     /**
@@ -128,6 +172,10 @@ class PyProxyHandler implements InvocationHandler {
      */
     private PyObject proxyGetOtherPyObject(Object proxyObject, Object otherObject) {
         PyObject result = null;
+        // Generated proxies (see PyProxyGenerator) are no java.lang.reflect.Proxy instances
+        if (!Proxy.isProxyClass(otherObject.getClass())) {
+            return null;
+        }
         InvocationHandler otherProxyHandler = Proxy.getInvocationHandler(otherObject);
         if (otherProxyHandler.getClass() == this.getClass()) {
             PyProxyHandler otherPyProxyHandler = (PyProxyHandler) otherProxyHandler;
@@ -144,9 +192,24 @@ class PyProxyHandler implements InvocationHandler {
      * 
      * @return
      */
-    private int callPythonHash() {
-        long pythonHash = PyLib.callAndReturnValue(this.pyObject.getPointer(), true, "__hash__", 0, null,
-                new Class<?>[0], Long.class);
+    private int callPythonHash(ProxyMethod proxyMethod) {
+        long pythonHash = (Long) PyLib.callHandleAndReturnValue(proxyMethod.callHandle, null, proxyMethod.returnType);
         return (int) pythonHash;
     }
+
+    private static final class ProxyMethod {
+        static final int OTHER = 0;
+        static final int HASH_CODE = 1;
+        static final int EQUALS = 2;
+
+        final int kind;
+        final Class<?> returnType;
+        final long callHandle;
+
+        ProxyMethod(int kind, Class<?> returnType, long callHandle) {
+            this.kind = kind;
+            this.returnType = returnType;
+            this.callHandle = callHandle;
+        }
+    }
 }
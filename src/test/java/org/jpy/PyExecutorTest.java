@@ -0,0 +1,125 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+public class PyExecutorTest {
+
+    private PyModule builtins;
+
+    @Before
+    public void setUp() throws Exception {
+        PyLib.startPython();
+        assertEquals(true, PyLib.isPythonRunning());
+        builtins = PyModule.importModule(PyLib.getPythonVersion().startsWith("2") ? "__builtin__" : "builtins");
+    }
+
+    @After
+    public void tearDown() throws Exception {
+        PyLib.stopPython();
+    }
+
+    @Test
+    public void testSubmit() throws Exception {
+        try (PyExecutor executor = new PyExecutor()) {
+            PyObject len = builtins.getAttribute("len");
+            CompletableFuture<Integer> future = executor.submit(Integer.class, len, "abcd");
+            assertEquals(4, future.get(10, TimeUnit.SECONDS).intValue());
+
+            PyObject result = executor.submit(builtins.getAttribute("str"), 42).get(10, TimeUnit.SECONDS);
+            assertEquals("42", result.getStringValue());
+
+            String version = executor.submit(PyLib::getPythonVersion).get(10, TimeUnit.SECONDS);
+            assertEquals(PyLib.getPythonVersion(), version);
+        }
+    }
+
+    @Test
+    public void testSubmitFailingCall() throws Exception {
+        try (PyExecutor executor = new PyExecutor()) {
+            CompletableFuture<Integer> future = executor.submit(Integer.class, builtins.getAttribute("int"), "x");
+            try {
+                future.get(10, TimeUnit.SECONDS);
+                fail();
+            } catch (ExecutionException e) {
+                assertTrue(e.getCause() instanceof RuntimeException);
+                assertTrue(e.getCause().getMessage().contains("ValueError"));
+            }
+            // The worker must survive failing calls
+            assertEquals(2, executor.submit(Integer.class, builtins.getAttribute("len"), "ab").get(10, TimeUnit.SECONDS).intValue());
+        }
+    }
+
+    @Test
+    public void testSubmitFromManyThreads() throws Exception {
+        final int threadCount = 8;
+        final int callCount = 500;
+        final PyObject abs = builtins.getAttribute("abs");
+        ExecutorService threads = Executors.newFixedThreadPool(threadCount);
+        try (PyExecutor executor = new PyExecutor(16)) {
+            List<Future<Long>> sums = new ArrayList<>();
+            for (int t = 0; t < threadCount; t++) {
+                sums.add(threads.submit(() -> {
+                    List<CompletableFuture<Integer>> futures = new ArrayList<>();
+                    for (int i = 0; i < callCount; i++) {
+                        futures.add(executor.submit(Integer.class, abs, -i));
+                    }
+                    long sum = 0;
+                    for (CompletableFuture<Integer> future : futures) {
+                        sum += future.get(30, TimeUnit.SECONDS);
+                    }
+                    return sum;
+                }));
+            }
+            for (Future<Long> sum : sums) {
+                assertEquals(callCount * (callCount - 1) / 2, sum.get().longValue());
+            }
+        } finally {
+            threads.shutdown();
+        }
+    }
+
+    @Test
+    public void testClose() throws Exception {
+        PyExecutor executor = new PyExecutor();
+        CompletableFuture<Integer> future = executor.submit(Integer.class, builtins.getAttribute("len"), "abc");
+        executor.close();
+        assertTrue(future.isDone());
+        assertEquals(3, future.get().intValue());
+        try {
+            executor.submit(Integer.class, builtins.getAttribute("len"), "abc");
+            fail();
+        } catch (RejectedExecutionException e) {
+            // expected
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy;
+
+import org.junit.After;
+import org.junit.Assume;
+import org.junit.Before;
+import org.junit.Test;
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+public class PyInterpreterPoolTest {
+
+    @Before
+    public void setUp() throws Exception {
+        String importPath = new File("src/test/python/fixtures").getCanonicalPath();
+        PyLib.startPython(importPath);
+        assertEquals(true, PyLib.isPythonRunning());
+        String[] version = PyLib.getPythonVersion().split("[. ]");
+        int major = Integer.parseInt(version[0]);
+        int minor = Integer.parseInt(version[1]);
+        Assume.assumeTrue("sub-interpreters with their own GIL require Python 3.12", major > 3 || major == 3 && minor >= 12);
+    }
+
+    @After
+    public void tearDown() throws Exception {
+        PyLib.stopPython();
+    }
+
+    @Test
+    public void testCall() throws Exception {
+        try (PyInterpreterPool pool = new PyInterpreterPool(2)) {
+            assertEquals(2, pool.getSize());
+            assertEquals(Long.valueOf(7), pool.call("scoring", "score", 2, 3).get(10, TimeUnit.SECONDS));
+            assertEquals(7.5, pool.call(Double.class, "scoring", "score", 2.5, 2.6).get(10, TimeUnit.SECONDS), 1e-10);
+            assertEquals(Integer.valueOf(7), pool.call(Integer.class, "scoring", "score", 2, 3L).get(10, TimeUnit.SECONDS));
+
+            Object[] result = pool.call(Object[].class, "scoring", "describe", "abc", new Object[]{1, 2.5, null, 3L})
+                    .get(10, TimeUnit.SECONDS);
+            assertEquals(4, result.length);
+            assertEquals("ABC", result[0]);
+            assertEquals(4L, result[1]);
+            assertEquals(6.5, (Double) result[2], 1e-10);
+            assertArrayEquals(new Object[]{false, false, true, false}, (Object[]) result[3]);
+        }
+    }
+
+    @Test
+    public void testInitCode() throws Exception {
+        try (PyInterpreterPool pool = new PyInterpreterPool(2, "import scoring\ndef twice(s):\n    return s * 2\n")) {
+            assertEquals("abab", pool.call(String.class, "__main__", "twice", "ab").get(10, TimeUnit.SECONDS));
+        }
+        try {
+            new PyInterpreterPool(2, "raise ValueError('bad init')");
+            fail();
+        } catch (RuntimeException e) {
+            assertTrue(e.getMessage().contains("bad init"));
+        }
+    }
+
+    @Test
+    public void testFailingCall() throws Exception {
+        try (PyInterpreterPool pool = new PyInterpreterPool(1)) {
+            try {
+                pool.call("scoring", "fail", "bad score").get(10, TimeUnit.SECONDS);
+                fail();
+            } catch (ExecutionException e) {
+                assertTrue(e.getCause() instanceof RuntimeException);
+                assertTrue(e.getCause().getMessage().contains("ValueError"));
+                assertTrue(e.getCause().getMessage().contains("bad score"));
+            }
+            try {
+                pool.call("scoring", "score", new Object()).get(10, TimeUnit.SECONDS);
+                fail();
+            } catch (ExecutionException e) {
+                assertTrue(e.getCause().getMessage().contains("TypeError"));
+            }
+            // The worker must survive failing calls
+            assertEquals(Long.valueOf(1), pool.call("scoring", "score", 0, 0).get(10, TimeUnit.SECONDS));
+        }
+    }
+
+    @Test
+    public void testInterpretersAreIsolated() throws Exception {
+        final int size = 4;
+        final int callCount = 1000;
+        try (PyInterpreterPool pool = new PyInterpreterPool(size)) {
+            List<CompletableFuture<Long>> futures = new ArrayList<>();
+            for (int i = 0; i < callCount; i++) {
+                futures.add(pool.call(Long.class, "scoring", "score", i, 2));
+            }
+            for (int i = 0; i < callCount; i++) {
+                assertEquals(2L * i + 1, futures.get(i).get(30, TimeUnit.SECONDS).longValue());
+            }
+        }
+        // Each sub-interpreter has imported "scoring" itself, the main interpreter has never called it
+        PyModule scoring = PyModule.importModule("scoring");
+        assertEquals(0, scoring.call("call_count").getIntValue());
+    }
+
+    @Test
+    public void testClose() throws Exception {
+        PyInterpreterPool pool = new PyInterpreterPool(2);
+        CompletableFuture<Long> future = pool.call(Long.class, "scoring", "score", 3, 3);
+        pool.close();
+        assertEquals(10L, future.get(10, TimeUnit.SECONDS).longValue());
+        try {
+            pool.call("scoring", "score", 3, 3);
+            fail();
+        } catch (RejectedExecutionException e) {
+            // expected
+        }
+    }
+}
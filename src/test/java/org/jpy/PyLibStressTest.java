@@ -0,0 +1,83 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy;
+
+import org.junit.*;
+
+import java.util.HashMap;
+import java.util.Map;
+
+import static org.junit.Assert.*;
+
+/**
+ * Converts very large collections between Java and Python in order to detect JNI local reference leaks.
+ * The tests are skipped unless the system property {@code jpy.stressTests} is set to {@code true}, e.g.
+ * <pre>
+ *     mvn test -Dtest=PyLibStressTest -Djpy.stressTests=true -DargLine="-Xmx4G -Xcheck:jni"
+ * </pre>
+ */
+public class PyLibStressTest {
+
+    // 10 million
+    private static final int N = 10000000;
+
+    @Before
+    public void setUp() throws Exception {
+        Assume.assumeTrue(Boolean.getBoolean("jpy.stressTests"));
+        PyLib.startPython();
+        assertEquals(true, PyLib.isPythonRunning());
+    }
+
+    @After
+    public void tearDown() throws Exception {
+        if (PyLib.isPythonRunning()) {
+            PyLib.stopPython();
+        }
+    }
+
+    @Test
+    public void testGetObjectArrayValue() throws Exception {
+        PyObject pyList = PyObject.executeCode("[str(i) for i in range(" + N + ")]", PyInputMode.EXPRESSION);
+
+        long t0 = System.nanoTime();
+        String[] values = pyList.getObjectArrayValue(String.class);
+        long t1 = System.nanoTime();
+        System.out.printf("PyObject.getObjectArrayValue() took %.3f s for %d items%n", (t1 - t0) / 1e9, N);
+
+        assertEquals(N, values.length);
+        assertEquals("0", values[0]);
+        assertEquals(String.valueOf(N - 1), values[N - 1]);
+    }
+
+    @Test
+    public void testExecuteCodeWithMap() throws Exception {
+        Map<String, Object> globals = new HashMap<>();
+        for (int i = 0; i < N; i++) {
+            globals.put("v" + i, i);
+        }
+
+        long t0 = System.nanoTime();
+        PyObject pyCount = PyObject.executeCode("len(globals())", PyInputMode.EXPRESSION, globals, null);
+        long t1 = System.nanoTime();
+        System.out.printf("PyObject.executeCode() with Map globals took %.3f s for %d entries%n", (t1 - t0) / 1e9, N);
+
+        assertTrue(pyCount.getIntValue() >= N);
+        // The entries are copied back into the map after execution
+        assertTrue(globals.size() >= N);
+        assertEquals(N - 1, globals.get("v" + (N - 1)));
+    }
+}
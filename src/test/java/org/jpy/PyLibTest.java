@@ -20,6 +20,7 @@ import org.junit.*;
 
 import static org.junit.Assert.*;
 
+import java.io.File;
 import java.util.Map;
 
 public class PyLibTest {
@@ -54,6 +55,62 @@ public class PyLibTest {
         assertNotNull(pythonVersion);
     }
 
+    @Test
+    public void testDiagStats() throws Exception {
+        long[] stats = PyLib.Diag.getStats();
+        assertNotNull(stats);
+        assertEquals(PyLib.Diag.STAT_COUNT, stats.length);
+
+        PyModule.importModule("os");
+        long[] stats2 = PyLib.Diag.getStats();
+        assertTrue(stats2[PyLib.Diag.STAT_GIL_ACQUISITIONS] > stats[PyLib.Diag.STAT_GIL_ACQUISITIONS]);
+    }
+
+    @Test
+    public void testDiagProfiling() throws Exception {
+        assertFalse(PyLib.Diag.isProfiling());
+        PyLib.Diag.setProfiling(true);
+        try {
+            assertTrue(PyLib.Diag.isProfiling());
+            PyModule builtins = PyModule.importModule(PyLib.getPythonVersion().startsWith("2") ? "__builtin__" : "builtins");
+            for (int i = 0; i < 10; i++) {
+                builtins.call("len", "abc");
+            }
+        } finally {
+            PyLib.Diag.setProfiling(false);
+        }
+
+        String report = PyLib.Diag.getProfileReport(10);
+        assertNotNull(report);
+        assertTrue(report, report.contains(".len"));
+
+        PyLib.Diag.resetProfile();
+        report = PyLib.Diag.getProfileReport(10);
+        assertFalse(report, report.contains(".len"));
+    }
+
+    @Test
+    public void testDiagTracing() throws Exception {
+        assertFalse(PyLib.Diag.isTracing());
+        PyLib.Diag.clearTrace();
+        PyLib.Diag.setTracing(true);
+        try {
+            assertTrue(PyLib.Diag.isTracing());
+            PyModule builtins = PyModule.importModule(PyLib.getPythonVersion().startsWith("2") ? "__builtin__" : "builtins");
+            builtins.call("len", "abc");
+        } finally {
+            PyLib.Diag.setTracing(false);
+        }
+
+        File file = File.createTempFile("jpy-trace", ".bin");
+        try {
+            assertTrue(PyLib.Diag.dumpTrace(file.getPath()) >= 1);
+            assertTrue(file.length() > 0);
+        } finally {
+            file.delete();
+        }
+    }
+
     @Test
     public void testExecScript() throws Exception {
         int exitCode = PyLib.execScript(String.format("print('%s says: \"Hello Python!\"')", PyLibTest.class.getName()));
@@ -20,11 +20,14 @@
 package org.jpy;
 
 import org.junit.*;
+import org.jpy.fixtures.Echo;
 import org.jpy.fixtures.Processor;
 
 import java.io.File;
 import java.io.IOException;
+import java.lang.reflect.Proxy;
 import java.util.Arrays;
+import java.util.Collections;
 import java.util.HashMap;
 import java.util.Map;
 import java.util.List;
@@ -161,6 +164,21 @@ public class PyObjectTest {
         assertEquals(13, localMap.get("z"));
     }
     
+    @Test
+    public void testLocals_CopyBackError() throws Exception {
+        HashMap<String, Object> localMap = new HashMap<>();
+        localMap.put("x", 7);
+        try {
+            // Keys must be strings to be copied back into the map
+            PyObject.executeCode("locals()[1] = x", PyInputMode.STATEMENT, null, localMap);
+            fail("RuntimeException expected");
+        } catch (RuntimeException e) {
+            assertNotNull(e.getMessage());
+        }
+        assertEquals(1, localMap.size());
+        assertEquals(7, localMap.get("x"));
+    }
+
     @Test
     public void testExecuteScript_ErrorExpr() throws Exception {
         try {
@@ -236,6 +254,26 @@ public class PyObjectTest {
         assertFalse(origHasX);
     }
     
+    @Test
+    public void testToJava() throws Exception {
+        PyObject pyObject = PyObject.executeCode("{'a': [1, 2.5, 'x', None], 'b': (True, {3}), 'c': {'d': []}}", PyInputMode.EXPRESSION);
+        Map<?, ?> map = pyObject.toJava(Map.class);
+        assertEquals(HashMap.class, map.getClass());
+        assertEquals(3, map.size());
+        assertEquals(Arrays.asList(1, 2.5, "x", null), map.get("a"));
+        Object[] b = (Object[]) map.get("b");
+        assertEquals(2, b.length);
+        assertEquals(Boolean.TRUE, b[0]);
+        assertEquals(Collections.singleton(3), b[1]);
+        assertEquals(Collections.singletonMap("d", Collections.emptyList()), map.get("c"));
+
+        PyObject pyStrings = PyObject.executeCode("('a', 'b')", PyInputMode.EXPRESSION);
+        assertArrayEquals(new String[]{"a", "b"}, pyStrings.toJava(String[].class));
+        assertEquals(Arrays.asList("a", "b"), pyStrings.toJava(List.class));
+        assertEquals(Integer.valueOf(7), PyObject.executeCode("7", PyInputMode.EXPRESSION).toJava(Integer.class));
+        assertEquals(PyObject.class, PyObject.executeCode("object()", PyInputMode.EXPRESSION).toJava(Object.class).getClass());
+    }
+
     @Test
     public void testCreateProxyAndCallSingleThreaded() throws Exception {
         // addTestDirToPythonSysPath();
@@ -256,6 +294,128 @@ public class PyObjectTest {
         // PyLib.Diag.setFlags(PyLib.Diag.F_OFF);
     }
     
+    @Test
+    public void testCreateGeneratedProxy() throws Exception {
+        addTestDirToPythonSysPath();
+        PyModule echoModule = PyModule.importModule("echo");
+        PyObject echoObj = echoModule.call("Echo");
+        Echo echo = echoObj.createProxy(Echo.class);
+        assertFalse(Proxy.isProxyClass(echo.getClass()));
+        assertTrue(echo instanceof PyProxyBase);
+
+        assertEquals(true, echo.echoBoolean(true));
+        assertEquals((byte) -12, echo.echoByte((byte) -12));
+        assertEquals('X', echo.echoChar('X'));
+        assertEquals((short) 1234, echo.echoShort((short) 1234));
+        assertEquals(-123456, echo.echoInt(-123456));
+        assertEquals(12345678901L, echo.echoLong(12345678901L));
+        assertEquals(1.5F, echo.echoFloat(1.5F), 0.0F);
+        assertEquals(2.25, echo.echoDouble(2.25), 0.0);
+        assertEquals("Hello", echo.echoString("Hello"));
+        assertArrayEquals(new int[]{1, 2, 3}, echo.echoIntArray(new int[]{1, 2, 3}));
+        assertEquals(10L, echo.sum(1, 2L, 3.0, (short) 4));
+        assertNull(echo.getValue());
+        echo.setValue("A");
+        assertEquals("A", echo.getValue());
+
+        // The generated class is shared by all proxies of the same interfaces
+        assertSame(echo.getClass(), echoModule.call("Echo").createProxy(Echo.class).getClass());
+
+        // Non-public interfaces are implemented by a java.lang.reflect.Proxy
+        ISimple simple = newTestObj(PyModule.importModule("hasheqstr"), "Simple", 1234);
+        assertTrue(Proxy.isProxyClass(simple.getClass()));
+
+        // So are public interfaces using non-public types, which a generated class couldn't access
+        HiddenFactory hiddenFactory = echoObj.createProxy(HiddenFactory.class);
+        assertTrue(Proxy.isProxyClass(hiddenFactory.getClass()));
+    }
+
+    @Test
+    public void testGeneratedProxyNoneReturnValue() throws Exception {
+        addTestDirToPythonSysPath();
+        PyModule echoModule = PyModule.importModule("echo");
+        PyObject echoObj = echoModule.call("Echo");
+        Echo echo = echoObj.createProxy(Echo.class);
+        echoModule.call("return_none_from_instance_methods", echoObj);
+
+        // None cannot be returned as a primitive value
+        try {
+            echo.echoInt(1);
+            fail("RuntimeException expected");
+        } catch (RuntimeException e) {
+            assertTrue(e.getMessage(), e.getMessage().contains("to a Java 'int'"));
+        }
+        try {
+            echo.echoBoolean(true);
+            fail("RuntimeException expected");
+        } catch (RuntimeException e) {
+            assertTrue(e.getMessage(), e.getMessage().contains("to a Java 'boolean'"));
+        }
+        try {
+            echo.echoLong(1L);
+            fail("RuntimeException expected");
+        } catch (RuntimeException e) {
+            assertTrue(e.getMessage(), e.getMessage().contains("to a Java 'long'"));
+        }
+        try {
+            echo.echoDouble(1.0);
+            fail("RuntimeException expected");
+        } catch (RuntimeException e) {
+            assertTrue(e.getMessage(), e.getMessage().contains("to a Java 'double'"));
+        }
+    }
+
+    static class Hidden {
+    }
+
+    public interface HiddenFactory {
+        Hidden newHidden();
+    }
+
+    @Test
+    public void testProxyMethodRebinding() throws Exception {
+        addTestDirToPythonSysPath();
+        PyModule echoModule = PyModule.importModule("echo");
+        PyObject echoObj = echoModule.call("Echo");
+        Echo generatedProxy = echoObj.createProxy(Echo.class);
+        Echo reflectiveProxy = (Echo) Proxy.newProxyInstance(Echo.class.getClassLoader(), new Class<?>[]{Echo.class},
+                new PyProxyHandler(echoObj, PyLib.CallableKind.METHOD));
+        try {
+            for (Echo echo : new Echo[]{generatedProxy, reflectiveProxy}) {
+                assertEquals(1, echo.echoInt(1));
+                assertEquals(1, echo.echoInt(1));
+                echoModule.call("rebind_class_method", 10);
+                assertEquals(11, echo.echoInt(1));
+                echoModule.call("rebind_instance_method", echoObj, 20);
+                assertEquals(21, echo.echoInt(1));
+                assertEquals(21, echo.echoInt(1));
+                echoModule.call("unbind_instance_method", echoObj);
+                assertEquals(11, echo.echoInt(1));
+                echoModule.call("restore_class_method");
+                assertEquals(1, echo.echoInt(1));
+            }
+        } finally {
+            echoModule.call("restore_class_method");
+        }
+    }
+
+    @Test
+    public void testProxyPropertyNotCached() throws Exception {
+        addTestDirToPythonSysPath();
+        PyModule echoModule = PyModule.importModule("echo");
+        PyObject echoObj = echoModule.call("PropertyEcho");
+        Echo generatedProxy = echoObj.createProxy(Echo.class);
+        Echo reflectiveProxy = (Echo) Proxy.newProxyInstance(Echo.class.getClassLoader(), new Class<?>[]{Echo.class},
+                new PyProxyHandler(echoObj, PyLib.CallableKind.METHOD));
+        // The property is evaluated on every call
+        assertEquals(2, generatedProxy.echoInt(1));
+        assertEquals(3, generatedProxy.echoInt(1));
+        assertEquals(4, reflectiveProxy.echoInt(1));
+        assertEquals(5, reflectiveProxy.echoInt(1));
+        // Plain methods of the same object are still cached
+        assertEquals(-1L, generatedProxy.echoLong(-1L));
+    }
+
     static void testCallProxySingleThreaded(PyObject procObject) {
         // Cast the Python object to a Java object of type 'Processor'
         Processor processor = procObject.createProxy(Processor.class);
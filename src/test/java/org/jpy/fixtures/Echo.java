@@ -0,0 +1,49 @@
+/*
+ * Copyright 2015 Brockmann Consult GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.jpy.fixtures;
+
+/**
+ * Implemented by the Python class 'Echo' in 'src/test/python/fixtures/echo.py'.
+ * Used to test the parameter and return types of Java proxies for Python objects.
+ */
+public interface Echo {
+    boolean echoBoolean(boolean value);
+
+    byte echoByte(byte value);
+
+    char echoChar(char value);
+
+    short echoShort(short value);
+
+    int echoInt(int value);
+
+    long echoLong(long value);
+
+    float echoFloat(float value);
+
+    double echoDouble(double value);
+
+    String echoString(String value);
+
+    int[] echoIntArray(int[] value);
+
+    long sum(int a, long b, double c, short d);
+
+    void setValue(Object value);
+
+    Object getValue();
+}
@@ -0,0 +1,59 @@
+class Echo:
+    def __init__(self):
+        self._value = None
+
+    def _echo(self, value):
+        return value
+
+    echoBoolean = _echo
+    echoByte = _echo
+    echoChar = _echo
+    echoShort = _echo
+    echoInt = _echo
+    echoLong = _echo
+    echoFloat = _echo
+    echoDouble = _echo
+    echoString = _echo
+    echoIntArray = _echo
+
+    def sum(self, a, b, c, d):
+        return int(a + b + c + d)
+
+    def setValue(self, value):
+        self._value = value
+
+    def getValue(self):
+        return self._value
+
+
+class PropertyEcho(Echo):
+    def __init__(self):
+        Echo.__init__(self)
+        self.count = 0
+
+    @property
+    def echoInt(self):
+        # Returns a new callable on every access
+        self.count += 1
+        count = self.count
+        return lambda value: value + count
+
+
+def rebind_class_method(value):
+    Echo.echoInt = lambda self, v: v + value
+
+
+def rebind_instance_method(echo, value):
+    echo.echoInt = lambda v: v + value
+
+
+def return_none_from_instance_methods(echo):
+    echo.echoBoolean = echo.echoInt = echo.echoLong = echo.echoDouble = lambda v: None
+
+
+def unbind_instance_method(echo):
+    del echo.echoInt
+
+
+def restore_class_method():
+    Echo.echoInt = Echo._echo
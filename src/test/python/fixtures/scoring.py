@@ -0,0 +1,21 @@
+# Pure functions called by PyInterpreterPoolTest in Python sub-interpreters
+
+_calls = 0
+
+
+def score(x, y):
+    global _calls
+    _calls += 1
+    return x * y + 1
+
+
+def describe(name, values):
+    return name.upper(), len(values), float(sum(v for v in values if v is not None)), [v is None for v in values]
+
+
+def call_count():
+    return _calls
+
+
+def fail(message):
+    raise ValueError(message)
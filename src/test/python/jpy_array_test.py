@@ -1,4 +1,5 @@
 import unittest
+import array
 import sys
 
 import jpyutil
@@ -7,6 +8,11 @@ import jpyutil
 jpyutil.init_jvm(jvm_maxmem='512M', jvm_classpath=['target/test-classes'])
 import jpy
 
+try:
+    import numpy as np
+except:
+    np = None
+
 
 class TestJavaArrays(unittest.TestCase):
     def do_test_basic_array_protocol_with_length(self, type, initial, expected):
@@ -201,6 +207,128 @@ class TestJavaArrays(unittest.TestCase):
         self.do_test_buffer_protocol_float('double', 8, [0.12345678, 0.0, -100.123456, 54.3], 8)
 
 
+    def test_array_from_buffer(self):
+        a = jpy.array('double', array.array('d', [1.5, -2.5]))
+        self.assertEqual(list(a), [1.5, -2.5])
+        a = jpy.array('byte', bytearray(b'\x01\xff'))
+        self.assertEqual(list(a), [1, -1])
+        a = jpy.array('short', array.array('h', range(-5, 5))[::3])
+        self.assertEqual(list(a), [-5, -2, 1, 4])
+
+    def test_array_from_converted_buffer(self):
+        a = jpy.array('long', array.array('i', [1, -2, 2147483647]))
+        self.assertEqual(list(a), [1, -2, 2147483647])
+        a = jpy.array('double', array.array('q', [1, -2]))
+        self.assertEqual(list(a), [1.0, -2.0])
+        a = jpy.array('float', array.array('d', [0.5, -1.25]))
+        self.assertEqual(list(a), [0.5, -1.25])
+        a = jpy.array('int', array.array('H', [1, 65535]))
+        self.assertEqual(list(a), [1, 65535])
+        a = jpy.array('char', array.array('i', [65, 66]))
+        self.assertEqual(list(a), [65, 66])
+        a = jpy.array('double', array.array('i', range(100))[::-2])
+        self.assertEqual(list(a), [float(i) for i in range(99, 0, -2)])
+
+    def test_array_from_converted_buffer_out_of_range(self):
+        a = jpy.array('int', array.array('q', [-2147483648, 2147483647]))
+        self.assertEqual(list(a), [-2147483648, 2147483647])
+        a = jpy.array('long', array.array('Q', [9223372036854775807]))
+        self.assertEqual(list(a), [9223372036854775807])
+
+        with self.assertRaises(OverflowError) as e:
+            jpy.array('int', array.array('q', [1, 2 ** 40]))
+        self.assertEqual(str(e.exception), "buffer item 1 is out of the range of Java 'int'")
+        with self.assertRaises(OverflowError):
+            jpy.array('long', array.array('Q', [2 ** 63]))
+        with self.assertRaises(OverflowError):
+            jpy.array('byte', array.array('h', [128]))
+        with self.assertRaises(OverflowError):
+            jpy.array('char', array.array('i', [-1]))
+
+        # Items of other sequences are truncated like Java casts
+        self.assertEqual(list(jpy.array('byte', [127, 128, 300])), [127, -128, 44])
+        self.assertEqual(list(jpy.array('byte', (128,))), [-128])
+
+    def test_buffer_arg_is_acquired_once(self):
+        # Arrays.hashCode() is overloaded for all primitive array types, so the buffer is matched against
+        # each of them before it is converted
+        Arrays = jpy.get_type('java.util.Arrays')
+        stats = jpy.diag.stats()
+        self.assertEqual(Arrays.hashCode(array.array('i', [1, 2, 3])), 30817)
+        stats2 = jpy.diag.stats()
+        self.assertEqual(stats2['buffer_acquisitions'], stats['buffer_acquisitions'] + 1)
+
+        a = array.array('d', [0.5, 1.5])
+        self.assertEqual(Arrays.hashCode(a), Arrays.hashCode(jpy.array('double', [0.5, 1.5])))
+        self.assertEqual(Arrays.hashCode(a), Arrays.hashCode(a))
+
+    def test_from_scalar_buffer(self):
+        # 0-dimensional buffers such as NumPy scalars are not arrays
+        scalar = memoryview(array.array('i', [5])).cast('B').cast('i', shape=[])
+        self.assertEqual(scalar.ndim, 0)
+        with self.assertRaises(ValueError):
+            jpy.from_numpy(scalar)
+
+    def test_from_buffer(self):
+        a = jpy.from_numpy(array.array('i', [1, -2, 3]))
+        self.assertEqual(type(a), jpy.get_type('[I'))
+        self.assertEqual(list(a), [1, -2, 3])
+
+        a = jpy.from_numpy(b'AB\xff', 'byte')
+        self.assertEqual(type(a), jpy.get_type('[B'))
+        self.assertEqual(list(a), [65, 66, -1])
+
+        # converted
+        a = jpy.from_numpy(array.array('q', [1, 2]), 'int')
+        self.assertEqual(type(a), jpy.get_type('[I'))
+        self.assertEqual(list(a), [1, 2])
+
+        with self.assertRaises(ValueError):
+            jpy.from_numpy([1, 2, 3])
+        with self.assertRaises(ValueError):
+            jpy.from_numpy(array.array('i', [1]), 'java.lang.String')
+
+
+@unittest.skipIf(np is None, 'numpy is not installed')
+class TestNumPyArrays(unittest.TestCase):
+    def test_round_trip(self):
+        for dtype, type_name in [('bool', 'boolean'), ('int8', 'byte'), ('int16', 'short'), ('int32', 'int'),
+                                 ('int64', 'long'), ('float32', 'float'), ('float64', 'double')]:
+            expected = np.array([1, 0, 1, 1], dtype=dtype)
+            a = jpy.from_numpy(expected)
+            self.assertEqual(type(a), jpy.get_type('[' + {'boolean': 'Z', 'byte': 'B', 'short': 'S', 'int': 'I',
+                                                          'long': 'J', 'float': 'F', 'double': 'D'}[type_name]))
+            actual = jpy.to_numpy(a)
+            self.assertEqual(actual.dtype, np.dtype(dtype))
+            self.assertTrue(np.array_equal(actual, expected))
+
+    def test_to_numpy_copies(self):
+        a = jpy.array('double', [1.5, 2.5, 3.5])
+        n = jpy.to_numpy(a)
+        n[0] = 0.0
+        self.assertEqual(a[0], 1.5)
+
+    def test_to_numpy_view(self):
+        a = jpy.array('int', [1, 2, 3])
+        n = jpy.to_numpy(a, copy=False)
+        self.assertEqual(list(n), [1, 2, 3])
+        n[0] = 7
+        del n
+        self.assertEqual(a[0], 7)
+
+    def test_from_numpy_with_type(self):
+        a = jpy.from_numpy(np.array([1, -2], dtype='int64'), 'int')
+        self.assertEqual(list(a), [1, -2])
+        a = jpy.from_numpy(np.arange(10, dtype='int32')[::2])
+        self.assertEqual(list(a), [0, 2, 4, 6, 8])
+
+    def test_to_numpy_errors(self):
+        with self.assertRaises(ValueError):
+            jpy.to_numpy(jpy.array('java.lang.String', 2))
+        with self.assertRaises(ValueError):
+            jpy.to_numpy([1, 2])
+
+
 if __name__ == '__main__':
     print('\nRunning ' + __file__)
     unittest.main()
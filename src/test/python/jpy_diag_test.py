@@ -1,4 +1,6 @@
 import unittest
+import os
+import tempfile
 
 import jpyutil
 
@@ -35,6 +37,104 @@ class TestJavaArrays(unittest.TestCase):
         jpy.diag.flags += jpy.diag.F_EXEC
         jpy.diag.flags += jpy.diag.F_MEM
         self.assertEqual(jpy.diag.flags, 12)
+        jpy.diag.flags = 0
+
+
+    def test_diag_stats(self):
+        stats = jpy.diag.stats()
+        self.assertIn('java_calls', stats)
+        self.assertIn('overload_resolutions', stats)
+        self.assertIn('types_resolved', stats)
+        self.assertIn('global_refs_created', stats)
+        self.assertIn('java_exceptions', stats)
+
+        String = jpy.get_type('java.lang.String')
+        s = String('Hello')
+        self.assertEqual(s.length(), 5)
+
+        stats2 = jpy.diag.stats()
+        self.assertGreaterEqual(stats2['java_calls'], stats['java_calls'] + 2)
+        self.assertGreaterEqual(stats2['overload_resolutions'], stats['overload_resolutions'] + 2)
+        self.assertGreaterEqual(stats2['global_refs_created'], stats['global_refs_created'] + 1)
+
+        method = String.length.methods[0]
+        count = method.call_count
+        s.length()
+        self.assertEqual(method.call_count, count + 1)
+
+
+    def test_diag_profiling(self):
+        self.assertEqual(jpy.diag.profiling, False)
+        String = jpy.get_type('java.lang.String')
+        s = String('Hello')
+
+        jpy.diag.reset_profile()
+        jpy.diag.profiling = True
+        try:
+            for i in range(10):
+                s.indexOf('l')
+        finally:
+            jpy.diag.profiling = False
+        s.indexOf('l')
+
+        report = jpy.diag.profile_report()
+        items = [item for item in report if item['name'] == 'java.lang.String#indexOf(java.lang.String)']
+        self.assertEqual(len(items), 1)
+        item = items[0]
+        self.assertEqual(item['kind'], 'java')
+        self.assertEqual(item['count'], 10)
+        for phase in ('args', 'call', 'result'):
+            self.assertLessEqual(item[phase]['p50_ns'], item[phase]['p99_ns'])
+            self.assertLessEqual(item[phase]['p99_ns'], item[phase]['max_ns'])
+        self.assertEqual(item['total_ns'], item['args']['total_ns'] + item['call']['total_ns'] + item['result']['total_ns'])
+
+        self.assertLessEqual(len(jpy.diag.profile_report(1)), 1)
+
+        jpy.diag.reset_profile()
+        self.assertEqual(jpy.diag.profile_report(), [])
+
+        with self.assertRaises(ValueError):
+            jpy.diag.profiling = 1
+
+
+    def test_diag_tracing(self):
+        import jpytrace
+
+        self.assertEqual(jpy.diag.tracing, False)
+        String = jpy.get_type('java.lang.String')
+        s = String('Hello')
+
+        jpy.diag.trace_clear()
+        jpy.diag.tracing = True
+        try:
+            s.indexOf('l')
+        finally:
+            jpy.diag.tracing = False
+        s.indexOf('l')
+
+        fd, path = tempfile.mkstemp(suffix='.bin')
+        os.close(fd)
+        try:
+            self.assertGreaterEqual(jpy.diag.trace_dump(path), 2)
+            trace = jpytrace.read_trace(path)
+        finally:
+            os.remove(path)
+
+        calls = [e for e in trace.events if e.event_id == jpytrace.EVENT_JAVA_CALL]
+        self.assertEqual(len(calls), 1)
+        self.assertEqual(jpytrace.get_subject_name(trace, calls[0]), 'java.lang.String#indexOf(java.lang.String)')
+        self.assertEqual(calls[0].arg_count, 1)
+        self.assertGreaterEqual(calls[0].duration, 0)
+
+        resolutions = [e for e in trace.events if e.event_id == jpytrace.EVENT_OVERLOAD_RESOLUTION]
+        self.assertEqual(len(resolutions), 1)
+        self.assertEqual(jpytrace.get_subject_name(trace, resolutions[0]), 'java.lang.String#indexOf')
+
+        chrome_trace = jpytrace.to_chrome_trace(trace)
+        self.assertEqual(len(chrome_trace['traceEvents']), len(trace.events))
+
+        with self.assertRaises(ValueError):
+            jpy.diag.tracing = 1
 
 
 if __name__ == '__main__':
@@ -263,6 +263,42 @@ class TestMutableAndReturnParameters(unittest.TestCase):
         self.assertEqual(a[2], 0)
 
 
+    def test_pooledIntArray(self):
+        fixture = self.Fixture()
+        method = self.Fixture.modifyIntArray.methods[0]
+        self.assertFalse(method.is_param_pooled(0))
+        method.set_param_pooled(0, True)
+        try:
+            self.assertTrue(method.is_param_pooled(0))
+            # Mutable buffers are copied into the pooled array and back
+            for i in range(3):
+                a = array.array('i', [0, 0, 0])
+                fixture.modifyIntArray(a, i, i + 1, i + 2)
+                self.assertEqual(list(a), [i, i + 1, i + 2])
+
+            # Once pooled, the array is reused instead of creating and pinning a new one per call
+            stats = jpy.diag.stats()
+            for i in range(10):
+                a = array.array('i', [0, 0, 0])
+                fixture.modifyIntArray(a, i, i + 1, i + 2)
+                self.assertEqual(list(a), [i, i + 1, i + 2])
+            stats2 = jpy.diag.stats()
+            self.assertEqual(stats2['global_refs_created'], stats['global_refs_created'])
+        finally:
+            method.set_param_pooled(0, False)
+
+        IntBuffer = jpy.get_type('java.nio.IntBuffer')
+        wrap = [m for m in IntBuffer.wrap.methods if m.param_count == 1][0]
+        wrap.set_param_pooled(0, True)
+        try:
+            # Read-only buffers are copied into the pooled array
+            for values in ([1, 2], [3, 4], [5, 6, 7]):
+                b = IntBuffer.wrap(array.array('i', values))
+                self.assertEqual([b.get(i) for i in range(len(values))], values)
+        finally:
+            wrap.set_param_pooled(0, False)
+
+
 if __name__ == '__main__':
     print('\nRunning ' + __file__)
     unittest.main()
@@ -1,3 +1,5 @@
+import sys
+import sysconfig
 import threading
 import unittest
 import jpyutil
@@ -44,6 +46,116 @@ class TestMultipleThreads(unittest.TestCase):
         self.assertEqual(456, t4.intValue)
 
 
+
+class TestManyThreads(unittest.TestCase):
+    """
+    Many threads registering types and calling Java concurrently. On free-threaded Python builds
+    the threads really run in parallel, which exercises jpy's locking of its shared state.
+    """
+
+    THREAD_COUNT = 16
+    CALL_COUNT = 2000
+
+    # Types most likely not used by other tests, so that the threads register them concurrently
+    TYPE_NAMES = ['java.util.concurrent.ConcurrentSkipListMap',
+                  'java.util.concurrent.ConcurrentSkipListSet',
+                  'java.util.concurrent.CopyOnWriteArrayList',
+                  'java.util.concurrent.atomic.AtomicLong',
+                  'java.util.ArrayDeque',
+                  'java.util.TreeMap',
+                  'java.util.BitSet',
+                  'java.lang.StringBuilder']
+
+    def test_gil_not_reenabled(self):
+        if sysconfig.get_config_var('Py_GIL_DISABLED') and hasattr(sys, '_is_gil_enabled'):
+            self.assertFalse(sys._is_gil_enabled())
+
+    def test_concurrent_type_registration_and_calls(self):
+        barrier = threading.Barrier(self.THREAD_COUNT)
+        results = [None] * self.THREAD_COUNT
+        errors = []
+
+        def run(index):
+            try:
+                barrier.wait()
+                types = [jpy.get_type(name) for name in self.TYPE_NAMES]
+                for name, jtype in zip(self.TYPE_NAMES, types):
+                    if jpy.get_type(name) is not jtype:
+                        raise AssertionError('type %s registered twice' % name)
+
+                AtomicLong = jpy.get_type('java.util.concurrent.atomic.AtomicLong')
+                StringBuilder = jpy.get_type('java.lang.StringBuilder')
+                counter = AtomicLong(0)
+                builder = StringBuilder()
+                for i in range(self.CALL_COUNT):
+                    counter.addAndGet(i)
+                    builder.append(i % 10)
+                results[index] = (counter.get(), builder.length())
+            except BaseException as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(self.THREAD_COUNT)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual([], errors)
+        expected = (self.CALL_COUNT * (self.CALL_COUNT - 1) // 2, self.CALL_COUNT)
+        self.assertEqual([expected] * self.THREAD_COUNT, results)
+
+    def test_concurrent_type_resolution(self):
+        # Each thread resolves the type without holding jpy's lock, only the first one publishes its methods
+        name = 'java.util.concurrent.LinkedBlockingDeque'
+        barrier = threading.Barrier(self.THREAD_COUNT)
+        results = [None] * self.THREAD_COUNT
+        errors = []
+
+        def run(index):
+            try:
+                barrier.wait()
+                jtype = jpy.get_type(name, resolve=True)
+                deque = jtype()
+                deque.offerFirst(index)
+                results[index] = (jtype.__dict__['offerFirst'], deque.peekFirst())
+            except BaseException as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(self.THREAD_COUNT)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual([], errors)
+        method = jpy.get_type(name).__dict__['offerFirst']
+        self.assertEqual([(method, i) for i in range(self.THREAD_COUNT)], results)
+        for result in results:
+            self.assertIs(method, result[0])
+
+    def test_concurrent_calls_on_shared_object(self):
+        Collections = jpy.get_type('java.util.Collections')
+        shared = Collections.synchronizedList(jpy.get_type('java.util.ArrayList')())
+        errors = []
+
+        def run(index):
+            try:
+                for i in range(self.CALL_COUNT):
+                    shared.add(index)
+                    shared.size()
+            except BaseException as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(self.THREAD_COUNT)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual([], errors)
+        self.assertEqual(self.THREAD_COUNT * self.CALL_COUNT, shared.size())
+
+
 if __name__ == '__main__':
     print('\nRunning ' + __file__)
     unittest.main()
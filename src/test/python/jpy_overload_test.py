@@ -105,6 +105,53 @@ class TestMethodOverloads(unittest.TestCase):
         self.assertEqual(fixture.join2(1, 2, "c", "d"), 'Integer(1),Integer(2),String(c),String(d)')
         self.assertEqual(fixture.join2(1.1, 2, "c", "d"), 'Double(1.1),Integer(2),String(c),String(d)')
 
+
+class TestOverloadDispatch(unittest.TestCase):
+    def setUp(self):
+        self.Fixture = jpy.get_type('org.jpy.fixtures.MethodOverloadTestFixture')
+        self.assertIsNotNone(self.Fixture)
+
+    def test_uniqueCandidateIsNotScoredAgainstOthers(self):
+        fixture = self.Fixture()
+        stats = jpy.diag.stats()
+        self.assertEqual(fixture.join('efg', 'abc'), 'String(efg),String(abc)')
+        self.assertEqual(fixture.join(None, 32), 'null,Integer(32)')
+        self.assertEqual(fixture.join('x'), 'String(x)')
+        stats2 = jpy.diag.stats()
+        self.assertEqual(stats2['overload_cache_misses'], stats['overload_cache_misses'])
+
+    def test_subclassesOfBuiltinTypes(self):
+        class MyStr(str):
+            pass
+
+        class MyInt(int):
+            pass
+
+        class MyFloat(float):
+            pass
+
+        fixture = self.Fixture()
+        self.assertEqual(fixture.join(MyStr('efg'), MyInt(32)), 'String(efg),Integer(32)')
+        self.assertEqual(fixture.join(MyFloat(1.2), MyStr('abc')), 'Double(1.2),String(abc)')
+        self.assertEqual(fixture.join(True, 3.2), 'Integer(1),Double(3.2)')
+
+        with self.assertRaises(RuntimeError, msg='RuntimeError expected') as e:
+            fixture.join(MyStr('efg'), [1])
+        self.assertEqual(str(e.exception), 'no matching Java method overloads found')
+
+    def test_overriddenMethodsAreNotScoredAgain(self):
+        ArrayList = jpy.get_type('java.util.ArrayList')
+        array_list = ArrayList()
+        stats = jpy.diag.stats()
+        # ArrayList.add(Object) overrides AbstractList.add(Object) and AbstractCollection.add(Object)
+        self.assertTrue(array_list.add('a'))
+        self.assertTrue(array_list.add('b'))
+        stats2 = jpy.diag.stats()
+        self.assertEqual(stats2['overload_cache_misses'], stats['overload_cache_misses'])
+        # Declared by AbstractCollection, overriding Object.toString()
+        self.assertEqual(array_list.toString(), '[a, b]')
+
+
 class TestVarArgs(unittest.TestCase):
     def setUp(self):
         self.Fixture = jpy.get_type('org.jpy.fixtures.VarArgsTestFixture')
@@ -196,6 +243,21 @@ class TestOtherMethodResolutionCases(unittest.TestCase):
         # without the fix, we get str(s) = "java.lang.String@xxxxxx"
         self.assertEqual(str(s), '[A, B, C]')
 
+    def test_argumentsDeclaredAsSuperTypes(self):
+        ArrayList = jpy.get_type('java.util.ArrayList')
+        Collection = jpy.get_type('java.util.Collection')
+        Iterable = jpy.get_type('java.lang.Iterable')
+        source = ArrayList()
+        source.add('a')
+        collection = jpy.cast(source, Collection)
+        # Iterable can't be cast to Collection, but the object is an ArrayList
+        iterable = jpy.cast(source, Iterable)
+        target = ArrayList()
+        for i in range(2):
+            self.assertTrue(target.addAll(collection))
+            self.assertTrue(target.addAll(iterable))
+        self.assertEqual(target.size(), 4)
+
 class TestDefaultMethods(unittest.TestCase):
     def setUp(self):
         self.Fixture = jpy.get_type('org.jpy.fixtures.DefaultInterfaceImplTestFixture')
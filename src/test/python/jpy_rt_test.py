@@ -1,5 +1,7 @@
 import unittest
 import sys
+import math
+import operator
 
 import jpyutil
 
@@ -212,6 +214,106 @@ class TestHashMap(unittest.TestCase):
         self.assertEqual(hash_map.get(4), fa)
 
 
+class TestHashAndCompare(unittest.TestCase):
+    def setUp(self):
+        self.BigInteger = jpy.get_type('java.math.BigInteger')
+        self.ArrayList = jpy.get_type('java.util.ArrayList')
+
+    def test_cached_hash(self):
+        a = self.BigInteger('12345678901234567890')
+        b = self.BigInteger('12345678901234567890')
+        c = self.BigInteger('-1')
+        self.assertEqual(hash(a), a.hashCode())
+        self.assertEqual(hash(a), hash(b))
+        # -1 is reserved for errors
+        self.assertEqual(c.hashCode(), -1)
+        self.assertEqual(hash(c), -2)
+        self.assertEqual(len({a, b, c}), 2)
+        self.assertTrue(a == b)
+        self.assertFalse(a == c)
+        self.assertTrue(c < a)
+        self.assertTrue(a >= b)
+
+    def test_cache_hash(self):
+        list = self.ArrayList()
+        hash1 = hash(list)
+        list.add('A')
+        self.assertNotEqual(hash(list), hash1)
+
+        jpy.cache_hash('java.util.ArrayList')
+        try:
+            list = self.ArrayList()
+            hash1 = hash(list)
+            list.add('A')
+            self.assertEqual(hash(list), hash1)
+        finally:
+            jpy.cache_hash(self.ArrayList, enabled=False)
+
+        list = self.ArrayList()
+        hash1 = hash(list)
+        list.add('A')
+        self.assertNotEqual(hash(list), hash1)
+
+        with self.assertRaises(ValueError):
+            jpy.cache_hash(42)
+
+
+class TestNumberProtocol(unittest.TestCase):
+    def test_integral(self):
+        Integer = jpy.get_type('java.lang.Integer')
+        i = Integer(42)
+        self.assertEqual(type(i), Integer)
+        self.assertEqual(int(i), 42)
+        self.assertEqual(operator.index(i), 42)
+        self.assertEqual(float(i), 42.0)
+        # Like all wrapped objects, numbers are true even if their value is zero
+        self.assertTrue(bool(i))
+        self.assertTrue(bool(Integer(0)))
+        self.assertEqual(len(range(Integer(3))), 3)
+        self.assertEqual(math.sqrt(Integer(16)), 4.0)
+
+        AtomicLong = jpy.get_type('java.util.concurrent.atomic.AtomicLong')
+        self.assertEqual(operator.index(AtomicLong(-7)), -7)
+
+    def test_floating(self):
+        d = jpy.get_type('java.lang.Double')(2.5)
+        self.assertEqual(int(d), 2)
+        self.assertEqual(float(d), 2.5)
+        self.assertTrue(bool(d))
+        with self.assertRaises(TypeError):
+            operator.index(d)
+
+        b = jpy.get_type('java.math.BigDecimal')('-1.5')
+        self.assertEqual(int(b), -1)
+        self.assertEqual(float(b), -1.5)
+        # Exact beyond the precision of doubles
+        b = jpy.get_type('java.math.BigDecimal')('123456789012345678901234567890.99')
+        self.assertEqual(int(b), 123456789012345678901234567890)
+
+    def test_big_integer(self):
+        b = jpy.get_type('java.math.BigInteger')('-123456789012345678901234567890')
+        self.assertEqual(int(b), -123456789012345678901234567890)
+        self.assertEqual(operator.index(b), -123456789012345678901234567890)
+        self.assertTrue(bool(b))
+
+    def test_declared_as_number(self):
+        n = jpy.cast(jpy.get_type('java.lang.Double')(2.5), 'java.lang.Number')
+        self.assertEqual(type(n), jpy.get_type('java.lang.Number'))
+        self.assertEqual(int(n), 2)
+        self.assertEqual(float(n), 2.5)
+        with self.assertRaises(TypeError):
+            operator.index(n)
+
+        n = jpy.cast(jpy.get_type('java.lang.Long')(9), 'java.lang.Number')
+        self.assertEqual(operator.index(n), 9)
+
+    def test_boolean(self):
+        Boolean = jpy.get_type('java.lang.Boolean')
+        self.assertTrue(bool(Boolean(True)))
+        self.assertTrue(bool(Boolean(False)))
+        self.assertEqual(int(Boolean(True)), 1)
+
+
 if __name__ == '__main__':
     print('\nRunning ' + __file__)
     unittest.main()
@@ -0,0 +1,55 @@
+import unittest
+import time
+import jpyutil
+
+# -Xcheck:jni makes the JVM report local reference overflows and other JNI misuse.
+jpyutil.init_jvm(jvm_maxmem='4G', jvm_options=['-Xcheck:jni'])
+import jpy
+
+
+class TestStress(unittest.TestCase):
+
+    # 10 million
+    N = 10000000
+
+    def test_object_array_from_list(self):
+        N = self.N
+        items = list(range(N))
+
+        t0 = time.time()
+        a = jpy.array('java.lang.Integer', items)
+        t1 = time.time()
+        print('jpy.array(\'java.lang.Integer\', list) took', t1-t0, 's for', N, 'items, this is', 1000*(t1-t0)/N, 'ms per item')
+
+        self.assertEqual(len(a), N)
+        self.assertEqual(a[0], 0)
+        self.assertEqual(a[N - 1], N - 1)
+
+    def test_string_array_from_list(self):
+        N = self.N
+        items = [str(i) for i in range(N)]
+
+        t0 = time.time()
+        a = jpy.array('java.lang.String', items)
+        t1 = time.time()
+        print('jpy.array(\'java.lang.String\', list) took', t1-t0, 's for', N, 'items, this is', 1000*(t1-t0)/N, 'ms per item')
+
+        self.assertEqual(len(a), N)
+        self.assertEqual(a[N - 1], str(N - 1))
+
+    def test_object_array_param(self):
+        N = self.N
+        Arrays = jpy.get_type('java.util.Arrays')
+        items = list(range(N))
+
+        t0 = time.time()
+        l = Arrays.asList(jpy.array('java.lang.Object', items))
+        t1 = time.time()
+        print('Arrays.asList(Object[]) took', t1-t0, 's for', N, 'items, this is', 1000*(t1-t0)/N, 'ms per item')
+
+        self.assertEqual(l.size(), N)
+
+
+if __name__ == '__main__':
+    print('\nRunning ' + __file__)
+    unittest.main()
@@ -38,6 +38,27 @@ class TestTypeTranslation(unittest.TestCase):
         jpy.type_translations['org.jpy.fixtures.Thing'] = None
         self.assertEqual(fixture.makeThing(9).getValue(), 9)
 
+    def test_TranslationChanges(self):
+        # translations are cached per type and must follow every change of the dictionary
+        fixture = self.Fixture()
+        try:
+            jpy.type_translations['org.jpy.fixtures.Thing'] = make_wrapper
+            self.assertEqual(fixture.makeThing(3).getValue(), 6)
+
+            jpy.type_translations['org.jpy.fixtures.Thing'] = lambda type, thing: thing.getValue() + 1
+            self.assertEqual(fixture.makeThing(3), 4)
+
+            del jpy.type_translations['org.jpy.fixtures.Thing']
+            self.assertEqual(fixture.makeThing(3).getValue(), 3)
+
+            jpy.type_translations.update({'org.jpy.fixtures.Thing': make_wrapper})
+            self.assertEqual(fixture.makeThing(3).getValue(), 6)
+
+            jpy.type_translations.clear()
+            self.assertEqual(fixture.makeThing(3).getValue(), 3)
+        finally:
+            jpy.type_translations.pop('org.jpy.fixtures.Thing', None)
+
 
 if __name__ == '__main__':
     print('\nRunning ' + __file__)
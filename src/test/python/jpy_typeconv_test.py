@@ -25,6 +25,36 @@ class TestTypeConversions(unittest.TestCase):
         self.assertEqual(str(e.exception), 'cannot convert a Python \'complex\' to a Java \'java.lang.Object\'')
 
 
+    def test_ToBoxedObjectConversion(self):
+        IdentityHashMap = jpy.get_type('java.util.IdentityHashMap')
+        m = IdentityHashMap()
+        # Boxes are obtained from valueOf() and cached, so equal small values are identical
+        for value in (True, False, -128, 0, 1023, -1.5):
+            m.put(value, 'a')
+            m.put(value, 'b')
+        self.assertEqual(m.size(), 7)
+        self.assertEqual(m.get(1023), 'b')
+        self.assertEqual(m.get(True), 'b')
+
+        ArrayList = jpy.get_type('java.util.ArrayList')
+        values = [True, False, -129, -128, 500, 1023, 1024, 100000]
+        a = ArrayList()
+        for value in values:
+            a.add(value)
+        self.assertEqual([a.get(i) for i in range(a.size())], values)
+
+    def test_FromBoxedObjectConversion(self):
+        # Array.get() returns the elements of primitive arrays as boxes, whose values are read from their 'value' fields
+        Array = jpy.get_type('java.lang.reflect.Array')
+        self.assertEqual(Array.get(jpy.array('byte', [-128]), 0), -128)
+        self.assertEqual(Array.get(jpy.array('short', [-32768]), 0), -32768)
+        self.assertEqual(Array.get(jpy.array('int', [2147483647]), 0), 2147483647)
+        self.assertEqual(Array.get(jpy.array('long', [-9223372036854775808]), 0), -9223372036854775808)
+        self.assertEqual(Array.get(jpy.array('float', [0.5]), 0), 0.5)
+        self.assertEqual(Array.get(jpy.array('double', [-2.25]), 0), -2.25)
+        self.assertEqual(Array.get(jpy.array('char', [120]), 0), 120)
+        self.assertIs(Array.get(jpy.array('boolean', [True]), 0), True)
+
     def test_ToPrimitiveArrayConversion(self):
         fixture = self.Fixture()
 
@@ -55,6 +85,105 @@ class TestTypeConversions(unittest.TestCase):
         self.assertEqual(fixture.stringifyStringArrayArg(['A', 'B', 'C']), 'String[](String(A),String(B),String(C))')
 
 
+    def test_DeepConversion(self):
+        ArrayList = jpy.get_type('java.util.ArrayList')
+        HashMap = jpy.get_type('java.util.HashMap')
+        HashSet = jpy.get_type('java.util.HashSet')
+
+        rows = ArrayList()
+        for i in range(3):
+            tags = HashSet()
+            tags.add('t%d' % i)
+            row = HashMap()
+            row.put('id', i)
+            row.put('name', 'row%d' % i)
+            row.put('tags', tags)
+            row.put('values', jpy.array('double', [i, 0.5]))
+            row.put('missing', None)
+            rows.add(row)
+
+        self.assertEqual(jpy.convert(rows),
+                         [{'id': i, 'name': 'row%d' % i, 'tags': {'t%d' % i}, 'values': [i, 0.5], 'missing': None}
+                          for i in range(3)])
+
+        # Containers nested deeper than depth are kept as Java objects
+        converted = jpy.convert(rows, depth=1)
+        self.assertEqual(len(converted), 3)
+        self.assertEqual(type(converted[2]), HashMap)
+        self.assertEqual(converted[2].get('name'), 'row2')
+        self.assertEqual(type(jpy.convert(rows, 0)), ArrayList)
+
+        self.assertEqual(jpy.convert(jpy.array('java.lang.String', ['a', 'b'])), ['a', 'b'])
+        self.assertEqual(jpy.convert(jpy.array('boolean', [True, False])), [True, False])
+
+        values = [1, 2]
+        self.assertIs(jpy.convert(values), values)
+
+        cycle = ArrayList()
+        cycle.add(cycle)
+        with self.assertRaises(RuntimeError):
+            jpy.convert(cycle)
+        self.assertEqual(type(jpy.convert(cycle, depth=2)[0][0]), ArrayList)
+
+
+    def test_Columns(self):
+        ArrayList = jpy.get_type('java.util.ArrayList')
+        LinkedList = jpy.get_type('java.util.LinkedList')
+        Point = jpy.get_type('java.awt.Point')
+
+        # More elements than fetched in a single chunk
+        n = 10000
+        points = ArrayList()
+        for i in range(n):
+            points.add(Point(i, -i))
+
+        # Public fields are preferred over getters, getX() would return a double
+        columns = jpy.columns(points, ['x', 'y', 'location'])
+        self.assertEqual(sorted(columns.keys()), ['location', 'x', 'y'])
+        self.assertEqual(columns['x'].format, 'i')
+        self.assertEqual(list(columns['x']), list(range(n)))
+        self.assertEqual(list(columns['y']), [-i for i in range(n)])
+        self.assertEqual(len(columns['location']), n)
+        self.assertEqual(type(columns['location'][5]), Point)
+        self.assertEqual(columns['location'][5].x, 5)
+
+        # Getters named getName(), isName() and name()
+        strings = jpy.array('java.lang.String', ['a', '', 'abc'])
+        columns = jpy.columns(strings, ('length', 'empty', 'bytes'))
+        self.assertEqual(list(columns['length']), [1, 0, 3])
+        self.assertEqual(list(columns['empty']), [False, True, False])
+        self.assertEqual(list(columns['bytes'][2]), [97, 98, 99])
+
+        words = LinkedList()
+        words.add('ab')
+        words.add('c')
+        self.assertEqual(list(jpy.columns(words, ['length'], type='java.lang.CharSequence')['length']), [2, 1])
+
+        self.assertEqual(jpy.columns(ArrayList(), ['x']), {'x': []})
+        columns = jpy.columns(ArrayList(), ['x', 'location'], type=Point)
+        self.assertEqual(columns['x'].format, 'i')
+        self.assertEqual(len(columns['x']), 0)
+        self.assertEqual(columns['location'], [])
+        # Names are resolved against an explicitly given type even if there are no elements
+        with self.assertRaises(AttributeError):
+            jpy.columns(ArrayList(), ['nonexistent'], type=Point)
+
+        with self.assertRaises(AttributeError):
+            jpy.columns(points, ['x', 'z'])
+
+        points.add(None)
+        with self.assertRaises(ValueError) as e:
+            jpy.columns(points, ['x'])
+        self.assertEqual(str(e.exception), 'columns: element %d is null' % n)
+
+        points.set(n, 'a')
+        with self.assertRaises(TypeError):
+            jpy.columns(points, ['x'])
+
+        with self.assertRaises(ValueError):
+            jpy.columns([Point(1, 2)], ['x'])
+
+
 if __name__ == '__main__':
     print('\nRunning ' + __file__)
     unittest.main()